@@ -0,0 +1,144 @@
+// RBotFirmware host build
+// Thin Arduino/ESP32 shim - pins, time and the hardware timer are all driven by HostSim's virtual clock
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+#include <time.h>
+#include <algorithm>
+#include "WString.h"
+#include "HostSim.h"
+
+#ifndef IRAM_ATTR
+#define IRAM_ATTR
+#endif
+
+#define LOW 0
+#define HIGH 1
+
+#define INPUT 0x01
+#define OUTPUT 0x02
+#define PULLUP 0x04
+#define INPUT_PULLUP 0x05
+#define PULLDOWN 0x08
+#define INPUT_PULLDOWN 0x09
+
+// ESP32 named pins used by ConfigPinMap
+#define DAC1 25
+#define DAC2 26
+#define SCL 22
+#define SDA 21
+#define RX 3
+#define TX 1
+#define MISO 19
+#define MOSI 23
+#define SCK 18
+#define A0 36
+#define A1 37
+#define A2 38
+#define A3 39
+#define A4 32
+#define A5 33
+#define A6 34
+#define A7 35
+#define A8 4
+#define A9 0
+#define A10 2
+#define A11 15
+#define A12 13
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+inline void pinMode(int pin, int mode)
+{
+    HostSim::pinMode(pin, mode);
+}
+inline void digitalWrite(int pin, int val)
+{
+    HostSim::digitalWrite(pin, val);
+}
+inline int digitalRead(int pin)
+{
+    return HostSim::digitalRead(pin);
+}
+inline uint16_t analogRead(int pin)
+{
+    return HostSim::digitalRead(pin) ? 4095 : 0;
+}
+inline unsigned long millis()
+{
+    return (unsigned long)(HostSim::nowNs() / 1000000ull);
+}
+inline unsigned long micros()
+{
+    return (unsigned long)(HostSim::nowNs() / 1000ull);
+}
+// There is no NTP time on the host
+inline bool getLocalTime(struct tm *info, uint32_t ms = 5000)
+{
+    return false;
+}
+
+inline void delayMicroseconds(unsigned int us)
+{
+    HostSim::advanceNs(uint64_t(us) * 1000);
+}
+inline void delay(unsigned long ms)
+{
+    HostSim::advanceNs(uint64_t(ms) * 1000000);
+}
+
+// ESP32 hardware timer API
+typedef HostSim::HostTimer hw_timer_t;
+inline hw_timer_t *timerBegin(uint8_t num, uint16_t divider, bool countUp)
+{
+    return HostSim::timerBegin(num, divider, countUp);
+}
+inline void timerAttachInterrupt(hw_timer_t *timer, void (*fn)(void), bool edge)
+{
+    timer->_isrFn = fn;
+}
+inline void timerAlarmWrite(hw_timer_t *timer, uint64_t alarmValue, bool autoreload)
+{
+    HostSim::timerAlarmWrite(timer, alarmValue, autoreload);
+}
+inline void timerAlarmEnable(hw_timer_t *timer)
+{
+    timer->_alarmEnabled = true;
+}
+inline void timerAlarmDisable(hw_timer_t *timer)
+{
+    timer->_alarmEnabled = false;
+}
+inline bool timerAlarmEnabled(hw_timer_t *timer)
+{
+    return timer->_alarmEnabled;
+}
+inline uint64_t timerRead(hw_timer_t *timer)
+{
+    return HostSim::timerRead(timer);
+}
+inline void timerWrite(hw_timer_t *timer, uint64_t val)
+{
+    HostSim::timerWrite(timer, val);
+}
+
+inline bool isDigit(int c)
+{
+    return isdigit(c) != 0;
+}
+inline bool isAlpha(int c)
+{
+    return isalpha(c) != 0;
+}
+inline bool isSpace(int c)
+{
+    return isspace(c) != 0;
+}
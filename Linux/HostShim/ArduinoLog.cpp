@@ -0,0 +1,58 @@
+// RBotFirmware host build
+// ArduinoLog replacement
+
+#include "ArduinoLog.h"
+#include <string>
+#include <string.h>
+
+Logging Log;
+
+// Translate ArduinoLog format specifiers into printf ones
+// %F and %D are doubles, %l is a long, %t and %T are bools
+void Logging::print(int level, const char *fmt, va_list args)
+{
+    if (level > _level || !_pOut)
+        return;
+    std::string outFmt;
+    const char *pFmt = fmt;
+    while (*pFmt)
+    {
+        outFmt += *pFmt;
+        if (*pFmt++ != '%')
+            continue;
+        // Flags, width and precision
+        while (*pFmt && strchr("-+ #0123456789.", *pFmt))
+            outFmt += *pFmt++;
+        switch (*pFmt)
+        {
+        case 'F':
+        case 'D':
+            outFmt += 'f';
+            pFmt++;
+            break;
+        case 't':
+        case 'T':
+            outFmt += 'd';
+            pFmt++;
+            break;
+        case 'l':
+            if (pFmt[1] && strchr("diuxX", pFmt[1]))
+            {
+                outFmt += *pFmt++;
+                outFmt += *pFmt++;
+            }
+            else
+            {
+                outFmt += "ld";
+                pFmt++;
+            }
+            break;
+        case '\0':
+            break;
+        default:
+            outFmt += *pFmt++;
+            break;
+        }
+    }
+    vfprintf(_pOut, outFmt.c_str(), args);
+}
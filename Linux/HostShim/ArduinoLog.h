@@ -0,0 +1,82 @@
+// RBotFirmware host build
+// ArduinoLog replacement - formats using ArduinoLog conventions (%F for double etc) to stdout
+
+#pragma once
+
+#include <stdarg.h>
+#include <stdio.h>
+#include "Arduino.h"
+
+#define LOG_LEVEL_SILENT 0
+#define LOG_LEVEL_FATAL 1
+#define LOG_LEVEL_ERROR 2
+#define LOG_LEVEL_WARNING 3
+#define LOG_LEVEL_NOTICE 4
+#define LOG_LEVEL_TRACE 5
+#define LOG_LEVEL_VERBOSE 6
+
+class Logging
+{
+  private:
+    int _level;
+    FILE *_pOut;
+
+  public:
+    Logging() : _level(LOG_LEVEL_WARNING), _pOut(stderr) {}
+
+    void begin(int level, FILE *pOut = stderr)
+    {
+        _level = level;
+        _pOut = pOut;
+    }
+    void setLevel(int level) { _level = level; }
+    int getLevel() { return _level; }
+
+    void fatal(const char *fmt, ...)
+    {
+        va_list args;
+        va_start(args, fmt);
+        print(LOG_LEVEL_FATAL, fmt, args);
+        va_end(args);
+    }
+    void error(const char *fmt, ...)
+    {
+        va_list args;
+        va_start(args, fmt);
+        print(LOG_LEVEL_ERROR, fmt, args);
+        va_end(args);
+    }
+    void warning(const char *fmt, ...)
+    {
+        va_list args;
+        va_start(args, fmt);
+        print(LOG_LEVEL_WARNING, fmt, args);
+        va_end(args);
+    }
+    void notice(const char *fmt, ...)
+    {
+        va_list args;
+        va_start(args, fmt);
+        print(LOG_LEVEL_NOTICE, fmt, args);
+        va_end(args);
+    }
+    void trace(const char *fmt, ...)
+    {
+        va_list args;
+        va_start(args, fmt);
+        print(LOG_LEVEL_TRACE, fmt, args);
+        va_end(args);
+    }
+    void verbose(const char *fmt, ...)
+    {
+        va_list args;
+        va_start(args, fmt);
+        print(LOG_LEVEL_VERBOSE, fmt, args);
+        va_end(args);
+    }
+
+  private:
+    void print(int level, const char *fmt, va_list args);
+};
+
+extern Logging Log;
@@ -0,0 +1,8 @@
+// RBotFirmware host build
+// CommandScheduler stand-in - there are no scheduled commands
+
+#pragma once
+
+class CommandScheduler
+{
+};
@@ -0,0 +1,37 @@
+// RBotFirmware host build
+// ConfigNVS stand-in - the config is kept in memory (written config isn't persisted)
+
+#pragma once
+
+#include "ConfigBase.h"
+
+class ConfigNVS : public ConfigBase
+{
+private:
+    // List of callbacks on change of config
+    std::vector<ConfigChangeCallbackType> _configChangeCallbacks;
+
+public:
+    ConfigNVS(const char *configNamespace, int configMaxlen) :
+                ConfigBase(configMaxlen)
+    {
+    }
+
+    bool setup()
+    {
+        setConfigData("");
+        return true;
+    }
+
+    bool writeConfig()
+    {
+        for (ConfigChangeCallbackType& configChangeCallback : _configChangeCallbacks)
+            configChangeCallback();
+        return true;
+    }
+
+    void registerChangeCallback(ConfigChangeCallbackType configChangeCallback)
+    {
+        _configChangeCallbacks.push_back(configChangeCallback);
+    }
+};
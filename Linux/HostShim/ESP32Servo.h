@@ -0,0 +1,34 @@
+// RBotFirmware host build
+// Servo stub - records the last position written
+
+#pragma once
+
+class Servo
+{
+  private:
+    int _pin = -1;
+    int _val = 0;
+
+  public:
+    int attach(int pin)
+    {
+        _pin = pin;
+        return 1;
+    }
+    void detach()
+    {
+        _pin = -1;
+    }
+    void write(int val)
+    {
+        _val = val;
+    }
+    void writeMicroseconds(int us)
+    {
+        _val = us;
+    }
+    int read()
+    {
+        return _val;
+    }
+};
@@ -0,0 +1,116 @@
+// RBotFirmware host build
+// FileManager stand-in
+
+#include "FileManager.h"
+#include <sys/stat.h>
+
+String FileManager::getFileContents(const String& fileSystemStr, const String& filename, int maxLen)
+{
+    int fileLen = 0;
+    if (!getFileInfo(fileSystemStr, filename, fileLen))
+        return "";
+    if ((maxLen > 0) && (fileLen >= maxLen-1))
+        return "";
+    FILE* pFile = fopen(getFileFullPath(fileSystemStr, filename).c_str(), "rb");
+    if (!pFile)
+        return "";
+    char* pBuf = new char[fileLen + 1];
+    size_t bytesRead = fread(pBuf, 1, fileLen, pFile);
+    fclose(pFile);
+    pBuf[bytesRead] = 0;
+    String contents = pBuf;
+    delete [] pBuf;
+    return contents;
+}
+
+bool FileManager::getFileInfo(const String& fileSystemStr, const String& filename, int& fileLength)
+{
+    fileLength = 0;
+    struct stat st;
+    if (stat(getFileFullPath(fileSystemStr, filename).c_str(), &st) != 0)
+        return false;
+    if (!S_ISREG(st.st_mode))
+        return false;
+    fileLength = st.st_size;
+    return true;
+}
+
+String FileManager::getFileFullPath(const String& fileSystemStr, const String& filename)
+{
+    return filename;
+}
+
+bool FileManager::chunkedFileStart(const String& fileSystemStr, const String& filename, bool readByLine)
+{
+    if (!readByLine)
+        return false;
+    if (_pChunkedFile)
+        fclose(_pChunkedFile);
+    if (!getFileInfo(fileSystemStr, filename, _chunkedFileLen))
+        return false;
+    _pChunkedFile = fopen(getFileFullPath(fileSystemStr, filename).c_str(), "r");
+    _chunkedFilename = filename;
+    _chunkedFilePos = 0;
+    return _pChunkedFile != NULL;
+}
+
+uint8_t* FileManager::chunkFileNext(String& filename, int& fileLen, int& chunkPos, int& chunkLen, bool& finalChunk)
+{
+    filename = _chunkedFilename;
+    fileLen = _chunkedFileLen;
+    chunkPos = _chunkedFilePos;
+    chunkLen = 0;
+    finalChunk = true;
+    if (!_pChunkedFile)
+        return NULL;
+    char* pReadLine = readLineFromFile((char*)_chunkedFileBuffer, CHUNKED_BUF_MAXLEN-1, _pChunkedFile);
+    if (!pReadLine)
+    {
+        fclose(_pChunkedFile);
+        _pChunkedFile = NULL;
+        return NULL;
+    }
+    chunkLen = strlen(pReadLine);
+    _chunkedFilePos = ftell(_pChunkedFile);
+    finalChunk = false;
+    return _chunkedFileBuffer;
+}
+
+String FileManager::getFileExtension(String& fileName)
+{
+    String extn;
+    // Find last .
+    int dotPos = fileName.lastIndexOf('.');
+    if (dotPos < 0)
+        return extn;
+    // Return substring
+    return fileName.substring(dotPos+1);
+}
+
+char* FileManager::readLineFromFile(char* pBuf, int maxLen, FILE* pFile)
+{
+    // Iterate over chars
+    pBuf[0] = 0;
+    char* pCurPtr = pBuf;
+    int curLen = 0;
+    while (true)
+    {
+        if (curLen >= maxLen-1)
+            break;
+        int ch = fgetc(pFile);
+        if (ch == EOF)
+        {
+            if (curLen != 0)
+                break;
+            return NULL;
+        }
+        if (ch == '\n')
+            break;
+        if (ch == '\r')
+            continue;
+        *pCurPtr++ = ch;
+        *pCurPtr = 0;
+        curLen++;
+    }
+    return pBuf;
+}
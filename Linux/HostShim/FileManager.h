@@ -0,0 +1,54 @@
+// RBotFirmware host build
+// FileManager stand-in - files are on the local file system (relative to the current directory)
+// and the file system name (spiffs, sd) is ignored
+
+#pragma once
+
+#include <Arduino.h>
+#include <stdio.h>
+
+class FileManager
+{
+private:
+    // Chunked file access
+    static const int CHUNKED_BUF_MAXLEN = 1000;
+    uint8_t _chunkedFileBuffer[CHUNKED_BUF_MAXLEN];
+    FILE* _pChunkedFile;
+    String _chunkedFilename;
+    int _chunkedFileLen;
+    int _chunkedFilePos;
+
+public:
+    FileManager()
+    {
+        _pChunkedFile = NULL;
+        _chunkedFileLen = 0;
+        _chunkedFilePos = 0;
+    }
+    ~FileManager()
+    {
+        if (_pChunkedFile)
+            fclose(_pChunkedFile);
+    }
+
+    // Get file contents as a string
+    String getFileContents(const String& fileSystemStr, const String& filename, int maxLen=0);
+
+    // Test file exists and get info
+    bool getFileInfo(const String& fileSystemStr, const String& filename, int& fileLength);
+
+    // Get full path of a file for access with stdio
+    String getFileFullPath(const String& fileSystemStr, const String& filename);
+
+    // Start access to a file in chunks (only line by line is supported)
+    bool chunkedFileStart(const String& fileSystemStr, const String& filename, bool readByLine);
+
+    // Get next chunk of file
+    uint8_t* chunkFileNext(String& filename, int& fileLen, int& chunkPos, int& chunkLen, bool& finalChunk);
+
+    // Get file name extension
+    static String getFileExtension(String& filename);
+
+    // Read line from file
+    char* readLineFromFile(char* pBuf, int maxLen, FILE* pFile);
+};
@@ -0,0 +1,190 @@
+// RBotFirmware host build
+// Virtual clock, GPIO model and ESP32-style hardware timer model
+
+#include "HostSim.h"
+#include <string.h>
+#include <chrono>
+
+namespace HostSim
+{
+static uint64_t _nowNs = 0;
+static bool _inIsr = false;
+static uint64_t _isrCallCount = 0;
+static int _pinLevels[MAX_PINS];
+static int _pinModes[MAX_PINS];
+static PinWriteCallback _pinWriteCallback;
+static HostTimer _timers[MAX_TIMERS];
+static bool _followWallClock = false;
+static std::chrono::steady_clock::time_point _wallClockStart;
+
+static uint64_t tickNs(HostTimer *timer)
+{
+    uint64_t ns = (uint64_t(timer->_divider) * 1000000000ull) / APB_CLOCK_HZ;
+    return ns == 0 ? 1 : ns;
+}
+
+// Time at which the timer's alarm will next fire (or UINT64_MAX if it won't)
+static uint64_t alarmTimeNs(HostTimer *timer)
+{
+    if (!timer->_inUse || !timer->_alarmEnabled || !timer->_isrFn)
+        return UINT64_MAX;
+    uint64_t counterNow = timerRead(timer);
+    // An alarm set in the past fires on the next counter tick
+    if (timer->_alarmValue <= counterNow)
+        return _nowNs + tickNs(timer);
+    return timer->_counterBaseNs + (timer->_alarmValue - timer->_counterBase) * tickNs(timer);
+}
+
+uint64_t nowNs()
+{
+    if (_followWallClock)
+        return _nowNs + std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - _wallClockStart).count();
+    return _nowNs;
+}
+
+void setFollowWallClock(bool followWallClock)
+{
+    _nowNs = nowNs();
+    _followWallClock = followWallClock;
+    _wallClockStart = std::chrono::steady_clock::now();
+}
+
+bool inIsr()
+{
+    return _inIsr;
+}
+
+void advanceNs(uint64_t ns)
+{
+    uint64_t targetNs = _nowNs + ns;
+
+    // Time moving inside an ISR (e.g. delayMicroseconds) doesn't fire other interrupts
+    if (_inIsr)
+    {
+        _nowNs = targetNs;
+        return;
+    }
+
+    while (true)
+    {
+        // Find the earliest alarm
+        HostTimer *pNext = NULL;
+        uint64_t nextNs = UINT64_MAX;
+        for (int i = 0; i < MAX_TIMERS; i++)
+        {
+            uint64_t t = alarmTimeNs(&_timers[i]);
+            if (t < nextNs)
+            {
+                nextNs = t;
+                pNext = &_timers[i];
+            }
+        }
+        if (!pNext || nextNs > targetNs)
+            break;
+
+        // Fire it
+        _nowNs = nextNs;
+        if (pNext->_autoreload)
+        {
+            pNext->_counterBase = 0;
+            pNext->_counterBaseNs = _nowNs;
+        }
+        else
+        {
+            pNext->_alarmEnabled = false;
+        }
+        _inIsr = true;
+        _isrCallCount++;
+        pNext->_isrFn();
+        _inIsr = false;
+    }
+    _nowNs = targetNs;
+}
+
+void reset()
+{
+    _nowNs = 0;
+    _inIsr = false;
+    _isrCallCount = 0;
+    memset(_pinLevels, 0, sizeof(_pinLevels));
+    memset(_pinModes, 0, sizeof(_pinModes));
+    memset(_timers, 0, sizeof(_timers));
+    _pinWriteCallback = NULL;
+    _followWallClock = false;
+}
+
+void pinMode(int pin, int mode)
+{
+    if (pin < 0 || pin >= MAX_PINS)
+        return;
+    _pinModes[pin] = mode;
+}
+
+void digitalWrite(int pin, int val)
+{
+    if (pin < 0 || pin >= MAX_PINS)
+        return;
+    _pinLevels[pin] = val ? 1 : 0;
+    if (_pinWriteCallback)
+        _pinWriteCallback(_nowNs, pin, _pinLevels[pin]);
+}
+
+int digitalRead(int pin)
+{
+    if (pin < 0 || pin >= MAX_PINS)
+        return 0;
+    return _pinLevels[pin];
+}
+
+void setInputLevel(int pin, int val)
+{
+    if (pin < 0 || pin >= MAX_PINS)
+        return;
+    _pinLevels[pin] = val ? 1 : 0;
+}
+
+void setPinWriteCallback(PinWriteCallback cb)
+{
+    _pinWriteCallback = cb;
+}
+
+HostTimer *timerBegin(uint8_t num, uint16_t divider, bool countUp)
+{
+    if (num >= MAX_TIMERS)
+        return NULL;
+    HostTimer *timer = &_timers[num];
+    memset(timer, 0, sizeof(HostTimer));
+    timer->_inUse = true;
+    timer->_divider = divider == 0 ? 1 : divider;
+    timer->_counterBaseNs = _nowNs;
+    return timer;
+}
+
+void timerAlarmWrite(HostTimer *timer, uint64_t alarmValue, bool autoreload)
+{
+    timer->_alarmValue = alarmValue;
+    timer->_autoreload = autoreload;
+}
+
+uint64_t timerRead(HostTimer *timer)
+{
+    return timer->_counterBase + (_nowNs - timer->_counterBaseNs) / tickNs(timer);
+}
+
+void timerWrite(HostTimer *timer, uint64_t val)
+{
+    timer->_counterBase = val;
+    timer->_counterBaseNs = _nowNs;
+}
+
+uint64_t isrCallCount()
+{
+    return _isrCallCount;
+}
+
+uint32_t cycleCount()
+{
+    return uint32_t((_nowNs * CPU_CLOCK_MHZ) / 1000);
+}
+}; // namespace HostSim
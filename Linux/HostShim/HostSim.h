@@ -0,0 +1,59 @@
+// RBotFirmware host build
+// Virtual clock, GPIO model and ESP32-style hardware timer model
+// Time only moves when advanceNs() is called so runs are deterministic and faster than real-time
+
+#pragma once
+
+#include <stdint.h>
+#include <functional>
+
+// Hardware timer state (kept outside the namespace so ADL doesn't pull in HostSim::timer* overloads)
+struct HostSimTimer
+{
+    bool _inUse;
+    uint16_t _divider;
+    void (*_isrFn)(void);
+    uint64_t _alarmValue;
+    bool _autoreload;
+    bool _alarmEnabled;
+    // Counter is _counterBase at _counterBaseNs and counts up from there
+    uint64_t _counterBase;
+    uint64_t _counterBaseNs;
+};
+
+namespace HostSim
+{
+typedef HostSimTimer HostTimer;
+static constexpr int MAX_PINS = 64;
+static constexpr int MAX_TIMERS = 4;
+static constexpr uint32_t APB_CLOCK_HZ = 80000000;
+static constexpr uint32_t CPU_CLOCK_MHZ = 240;
+
+typedef std::function<void(uint64_t timeNs, int pin, int val)> PinWriteCallback;
+
+// Clock
+uint64_t nowNs();
+void advanceNs(uint64_t ns);
+void reset();
+bool inIsr();
+// The clock can also move with the wall clock (to time firmware code in benchmarks) - timers
+// only fire when advanceNs() is called so aren't used in this mode
+void setFollowWallClock(bool followWallClock);
+
+// GPIO
+void pinMode(int pin, int mode);
+void digitalWrite(int pin, int val);
+int digitalRead(int pin);
+void setInputLevel(int pin, int val);
+void setPinWriteCallback(PinWriteCallback cb);
+
+// Timers
+HostTimer *timerBegin(uint8_t num, uint16_t divider, bool countUp);
+void timerAlarmWrite(HostTimer *timer, uint64_t alarmValue, bool autoreload);
+uint64_t timerRead(HostTimer *timer);
+void timerWrite(HostTimer *timer, uint64_t val);
+uint64_t isrCallCount();
+
+// Cycle counter (as XTHAL_GET_CCOUNT)
+uint32_t cycleCount();
+}; // namespace HostSim
@@ -0,0 +1,19 @@
+// RBotFirmware host build
+// RestAPISystem stand-in - there is no WiFi, MQTT or OTA so system health is empty
+
+#pragma once
+
+#include <Arduino.h>
+
+class RestAPISystem
+{
+public:
+    static int reportHealth(int bitPosStart, unsigned long *pOutHash, String *pOutStr)
+    {
+        if (pOutHash)
+            *pOutHash = 0;
+        if (pOutStr)
+            *pOutStr = "\"wifiIP\":\"0.0.0.0\",\"wifiConn\":\"None\"";
+        return 8;
+    }
+};
@@ -0,0 +1,6 @@
+// RBotFirmware host build
+// Arduino Time library stand-in
+
+#pragma once
+
+#include <time.h>
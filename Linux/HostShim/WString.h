@@ -0,0 +1,233 @@
+// RBotFirmware host build
+// Minimal Arduino String replacement for Linux builds of the motion stack
+
+#pragma once
+
+#include <string>
+#include <string.h>
+#include <strings.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+#define DEC 10
+#define HEX 16
+
+#ifndef IRAM_ATTR
+#define IRAM_ATTR
+#endif
+
+class String
+{
+  private:
+    std::string _str;
+
+  public:
+    String() {}
+    String(const char *pStr) : _str(pStr ? pStr : "") {}
+    String(const std::string &str) : _str(str) {}
+    String(const String &other) : _str(other._str) {}
+    String(char c) : _str(1, c) {}
+    String(int val, unsigned char base = DEC) { fromLong(val, base); }
+    String(unsigned int val, unsigned char base = DEC) { fromULong(val, base); }
+    String(long val, unsigned char base = DEC) { fromLong(val, base); }
+    String(unsigned long val, unsigned char base = DEC) { fromULong(val, base); }
+    String(float val, unsigned char decimalPlaces = 2) { fromDouble(val, decimalPlaces); }
+    String(double val, unsigned char decimalPlaces = 2) { fromDouble(val, decimalPlaces); }
+
+    String &operator=(const String &other)
+    {
+        _str = other._str;
+        return *this;
+    }
+    String &operator=(const char *pStr)
+    {
+        _str = pStr ? pStr : "";
+        return *this;
+    }
+
+    const char *c_str() const { return _str.c_str(); }
+    unsigned int length() const { return (unsigned int)_str.length(); }
+    void reserve(unsigned int size) { _str.reserve(size); }
+    char charAt(unsigned int idx) const { return idx < _str.length() ? _str[idx] : 0; }
+    char operator[](unsigned int idx) const { return charAt(idx); }
+    void setCharAt(unsigned int idx, char c)
+    {
+        if (idx < _str.length())
+            _str[idx] = c;
+    }
+
+    bool concat(const String &other)
+    {
+        _str += other._str;
+        return true;
+    }
+    bool concat(const char *pStr)
+    {
+        if (pStr)
+            _str += pStr;
+        return true;
+    }
+    bool concat(char c)
+    {
+        _str += c;
+        return true;
+    }
+    bool concat(int val) { return concat(String(val)); }
+    bool concat(long val) { return concat(String(val)); }
+    bool concat(unsigned int val) { return concat(String(val)); }
+    bool concat(unsigned long val) { return concat(String(val)); }
+    bool concat(float val) { return concat(String(val)); }
+    bool concat(double val) { return concat(String(val)); }
+
+    template <typename T>
+    String &operator+=(const T &val)
+    {
+        concat(val);
+        return *this;
+    }
+
+    bool equals(const String &other) const { return _str == other._str; }
+    bool equals(const char *pStr) const { return _str == (pStr ? pStr : ""); }
+    bool equalsIgnoreCase(const String &other) const
+    {
+        return (_str.length() == other._str.length()) && (strcasecmp(_str.c_str(), other._str.c_str()) == 0);
+    }
+    bool operator==(const String &other) const { return equals(other); }
+    bool operator==(const char *pStr) const { return equals(pStr); }
+    bool operator!=(const String &other) const { return !equals(other); }
+    bool operator!=(const char *pStr) const { return !equals(pStr); }
+    bool operator<(const String &other) const { return _str < other._str; }
+
+    bool startsWith(const String &prefix) const { return _str.compare(0, prefix._str.length(), prefix._str) == 0; }
+    bool endsWith(const String &suffix) const
+    {
+        if (suffix._str.length() > _str.length())
+            return false;
+        return _str.compare(_str.length() - suffix._str.length(), suffix._str.length(), suffix._str) == 0;
+    }
+
+    int indexOf(char c, unsigned int fromIdx = 0) const
+    {
+        size_t pos = _str.find(c, fromIdx);
+        return pos == std::string::npos ? -1 : int(pos);
+    }
+    int indexOf(const String &str, unsigned int fromIdx = 0) const
+    {
+        size_t pos = _str.find(str._str, fromIdx);
+        return pos == std::string::npos ? -1 : int(pos);
+    }
+    int lastIndexOf(char c) const
+    {
+        size_t pos = _str.rfind(c);
+        return pos == std::string::npos ? -1 : int(pos);
+    }
+    String substring(unsigned int fromIdx) const
+    {
+        if (fromIdx >= _str.length())
+            return String();
+        return String(_str.substr(fromIdx));
+    }
+    String substring(unsigned int fromIdx, unsigned int toIdx) const
+    {
+        if (fromIdx > toIdx)
+        {
+            unsigned int tmp = fromIdx;
+            fromIdx = toIdx;
+            toIdx = tmp;
+        }
+        if (fromIdx >= _str.length())
+            return String();
+        if (toIdx > _str.length())
+            toIdx = (unsigned int)_str.length();
+        return String(_str.substr(fromIdx, toIdx - fromIdx));
+    }
+    void replace(const String &find, const String &repl)
+    {
+        if (find._str.empty())
+            return;
+        size_t pos = 0;
+        while ((pos = _str.find(find._str, pos)) != std::string::npos)
+        {
+            _str.replace(pos, find._str.length(), repl._str);
+            pos += repl._str.length();
+        }
+    }
+    // As Arduino - with no count everything from idx is removed
+    void remove(unsigned int idx)
+    {
+        if (idx < _str.length())
+            _str.erase(idx);
+    }
+    void remove(unsigned int idx, unsigned int count)
+    {
+        if (idx < _str.length())
+            _str.erase(idx, count);
+    }
+    void trim()
+    {
+        size_t start = _str.find_first_not_of(" \t\r\n");
+        if (start == std::string::npos)
+        {
+            _str.clear();
+            return;
+        }
+        size_t end = _str.find_last_not_of(" \t\r\n");
+        _str = _str.substr(start, end - start + 1);
+    }
+    void toUpperCase()
+    {
+        for (auto &c : _str)
+            c = (char)toupper(c);
+    }
+    void toLowerCase()
+    {
+        for (auto &c : _str)
+            c = (char)tolower(c);
+    }
+    long toInt() const { return strtol(_str.c_str(), NULL, 10); }
+    float toFloat() const { return float(strtod(_str.c_str(), NULL)); }
+    void toCharArray(char *pBuf, unsigned int bufSize) const
+    {
+        if (bufSize == 0)
+            return;
+        strncpy(pBuf, _str.c_str(), bufSize - 1);
+        pBuf[bufSize - 1] = 0;
+    }
+
+    friend String operator+(const String &lhs, const String &rhs) { return String(lhs._str + rhs._str); }
+    friend String operator+(const String &lhs, const char *rhs) { return String(lhs._str + (rhs ? rhs : "")); }
+    friend String operator+(const char *lhs, const String &rhs) { return String(std::string(lhs ? lhs : "") + rhs._str); }
+    friend String operator+(const String &lhs, char rhs) { return String(lhs._str + rhs); }
+    friend String operator+(const String &lhs, int rhs) { return lhs + String(rhs); }
+    friend String operator+(const String &lhs, long rhs) { return lhs + String(rhs); }
+    friend String operator+(const String &lhs, unsigned int rhs) { return lhs + String(rhs); }
+    friend String operator+(const String &lhs, unsigned long rhs) { return lhs + String(rhs); }
+    friend String operator+(const String &lhs, float rhs) { return lhs + String(rhs); }
+    friend String operator+(const String &lhs, double rhs) { return lhs + String(rhs); }
+
+  private:
+    void fromLong(long val, unsigned char base)
+    {
+        char buf[40];
+        if (base == HEX)
+            snprintf(buf, sizeof(buf), "%lx", val);
+        else
+            snprintf(buf, sizeof(buf), "%ld", val);
+        _str = buf;
+    }
+    void fromULong(unsigned long val, unsigned char base)
+    {
+        char buf[40];
+        if (base == HEX)
+            snprintf(buf, sizeof(buf), "%lx", val);
+        else
+            snprintf(buf, sizeof(buf), "%lu", val);
+        _str = buf;
+    }
+    void fromDouble(double val, unsigned char decimalPlaces)
+    {
+        char buf[64];
+        snprintf(buf, sizeof(buf), "%.*f", decimalPlaces, val);
+        _str = buf;
+    }
+};
@@ -0,0 +1,11 @@
+// RBotFirmware host build
+// ESP32 analogWrite stand-in - the value is written to the pin's level (non-zero is high)
+
+#pragma once
+
+#include <Arduino.h>
+
+inline void analogWrite(int pin, int value)
+{
+    HostSim::digitalWrite(pin, value);
+}
@@ -0,0 +1,8 @@
+// RBotFirmware host build
+// Cycle counter driven by the virtual clock
+
+#pragma once
+
+#include "HostSim.h"
+
+#define XTHAL_GET_CCOUNT() (HostSim::cycleCount())
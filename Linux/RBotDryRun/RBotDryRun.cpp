@@ -0,0 +1,125 @@
+// RBotFirmware
+// Rob Dobson 2016-2018
+
+// Dry run of a .gcode, .thr or .param file on Linux - the same planner and segment preparation
+// as the firmware (see RobotDryRun) with the result printed as JSON
+// Usage: RBotDryRun [-v] [-x <expected.json>] <file> [<robotType> | <robotConfig.json>]
+
+#include <ArduinoLog.h>
+#include "RdJson.h"
+#include "FileManager.h"
+#include "RobotConfigurations.h"
+#include "WorkManager/RobotDryRun.h"
+
+// Results which can be checked - the expected file has [min, max] for any of them e.g. "blocks":[5300,5310]
+static const char* CHECKED_RESULTS[] = { "timeS", "blocks", "slowdowns", "xMin", "xMax", "yMin", "yMax" };
+
+static void usage()
+{
+    fprintf(stderr, "Usage: RBotDryRun [-v] [-x <expected.json>] <file> [<robotType> | <robotConfig.json>]\n");
+    String robotTypes;
+    RobotConfigurations::getRobotTypes(robotTypes);
+    fprintf(stderr, "Robot types %s (default is the first)\n", robotTypes.c_str());
+}
+
+// Check the dry run results against the expected ranges - returns false if any is outside its range
+static bool checkExpected(const String& expectedStr, const String& resultStr)
+{
+    bool allOk = true;
+    for (const char* pName : CHECKED_RESULTS)
+    {
+        String rangePath = String(pName) + "[0]";
+        if (RdJson::getString(rangePath.c_str(), "", expectedStr.c_str()).length() == 0)
+            continue;
+        double minVal = RdJson::getDouble(rangePath.c_str(), 0, expectedStr.c_str());
+        double maxVal = RdJson::getDouble((String(pName) + "[1]").c_str(), 0, expectedStr.c_str());
+        double val = RdJson::getDouble((String("dryRun/") + pName).c_str(), NAN, resultStr.c_str());
+        bool valOk = (val >= minVal) && (val <= maxVal);
+        if (!valOk)
+            fprintf(stderr, "%s %.2f EXPECTED %.2f to %.2f\n", pName, val, minVal, maxVal);
+        allOk &= valOk;
+    }
+    return allOk;
+}
+
+int main(int argc, char** argv)
+{
+    // Args
+    int argIdx = 1;
+    Log.begin(LOG_LEVEL_WARNING);
+    if ((argIdx < argc) && (strcmp(argv[argIdx], "-v") == 0))
+    {
+        Log.begin(LOG_LEVEL_NOTICE);
+        argIdx++;
+    }
+    String expectedStr;
+    if ((argIdx + 1 < argc) && (strcmp(argv[argIdx], "-x") == 0))
+    {
+        FileManager expectedFileManager;
+        expectedStr = expectedFileManager.getFileContents("", argv[argIdx + 1]);
+        if (expectedStr.length() == 0)
+        {
+            fprintf(stderr, "Cannot read %s\n", argv[argIdx + 1]);
+            return 2;
+        }
+        argIdx += 2;
+    }
+    if (argIdx >= argc)
+    {
+        usage();
+        return 2;
+    }
+    String fileName = argv[argIdx++];
+    String robotArg = (argIdx < argc) ? argv[argIdx] : "";
+
+    // Robot config from a file (either a full config with robotConfig inside or just the robotConfig)
+    // or the default config for the robot type
+    FileManager fileManager;
+    String robotConfigStr;
+    String robotArgExt = FileManager::getFileExtension(robotArg);
+    if (robotArgExt.equalsIgnoreCase("json"))
+    {
+        String configStr = fileManager.getFileContents("", robotArg);
+        if (configStr.length() == 0)
+        {
+            fprintf(stderr, "Cannot read %s\n", robotArg.c_str());
+            return 2;
+        }
+        robotConfigStr = RdJson::getString("robotConfig", "", configStr.c_str());
+        if (robotConfigStr.length() == 0)
+            robotConfigStr = configStr;
+    }
+    else
+    {
+        if (robotArg.length() == 0)
+            RobotConfigurations::getNthRobotTypeName(0, robotArg);
+        robotConfigStr = RobotConfigurations::getConfig(robotArg.c_str());
+        if (robotConfigStr.equals("{}"))
+        {
+            fprintf(stderr, "Unknown robot type %s\n", robotArg.c_str());
+            usage();
+            return 2;
+        }
+    }
+
+    // Run to completion
+    RobotDryRun* pRobotDryRun = new RobotDryRun(fileManager);
+    RobotDryRunStatus status;
+    status.setFileName(fileName.c_str());
+    if (!pRobotDryRun->start(robotConfigStr.c_str(), fileName))
+    {
+        delete pRobotDryRun;
+        printf("%s\n", status.toJSON().c_str());
+        return 1;
+    }
+    pRobotDryRun->service(0);
+    status._isValid = true;
+    status._wasAbandoned = pRobotDryRun->wasAbandoned();
+    pRobotDryRun->getResult(status._result);
+    delete pRobotDryRun;
+    String resultStr = status.toJSON();
+    printf("%s\n", resultStr.c_str());
+    if ((expectedStr.length() > 0) && !checkExpected(expectedStr, resultStr))
+        return 1;
+    return 0;
+}
@@ -0,0 +1,631 @@
+// RBotFirmware
+// Rob Dobson 2016-2018
+
+// Motion simulator for Linux - the firmware's motion stack with the motion ISR driven from HostSim's
+// virtual clock. Step and direction pin writes are saved as traces in the Tests/TestOutputData format
+// (see Tests/TestAnalyzePlannerOutput) and each run is checked for completion and lost steps - the
+// pipeline stats at the end of each run are saved as CSV alongside the trace - with a baseline robot each
+// test case is also run on that and its time compared - with a golden folder each test case that has a trace
+// there is checked against its step counts and duration
+// Usage: RBotMotionSim [-v] [-o <outFolder>] [-r <runIdx>] [-b <baselineRobot>] [-g <goldenFolder>] <testCases.txt | file.gcode> [<robotType> | <robotConfig.json>]
+
+#include <ArduinoLog.h>
+#include <vector>
+#include <algorithm>
+#include "RdJson.h"
+#include "ConfigPinMap.h"
+#include "FileManager.h"
+#include "RobotConfigurations.h"
+#include "RobotMotion/RobotController.h"
+#include "RobotCommandArgs.h"
+#include "WorkManager/Evaluators/EvaluatorGCode.h"
+
+// Simulated time limit for each test case
+static const uint32_t MAX_TEST_CASE_MS = 600000;
+// Time allowed after the last block for the final step pulses
+static const uint32_t SETTLE_MS = 10;
+// Tolerances on the expected end position and total steps of a test case
+static const float END_POS_TOL_MM = 0.01f;
+static const float TOTAL_STEPS_TOL = 0.01f;
+// Tolerances on the step counts (either direction) and the time from first to last step of a golden trace
+static const uint32_t GOLDEN_STEPS_TOL = 1;
+static const float GOLDEN_DURATION_TOL = 0.06f;
+// Percentile of the step interval jitter checked
+static const float STEP_JITTER_PERCENTILE = 0.99f;
+
+// Test case - lines of GCode
+struct SimTestCase
+{
+    String _name;
+    std::vector<String> _lines;
+    // Expected results (optional) - end position in mm and total steps (either direction) on each axis
+    bool _endPosValid = false;
+    AxisFloats _endPosMM;
+    std::vector<uint32_t> _totalSteps;
+    // Max ratio of the simulated time to that of the baseline robot (0 if not checked)
+    float _maxTimeVsBaseline = 0;
+    // Max step interval jitter of the axes with fewer steps than the axis with most (0 if not checked)
+    float _maxMinorAxisJitter = 0;
+    // Max difference between the step intervals accelerating and decelerating on the axis with most steps
+    // (0 if not checked)
+    float _maxRampAsymmetry = 0;
+    // Blocks merged and corners blended by the path simplifier (-1 if not checked)
+    int _pathMerged = -1;
+    int _pathBlended = -1;
+    // Golden trace (empty if none) and the tolerance on its duration as a fraction
+    String _goldenFileName;
+    float _goldenDurationTol = GOLDEN_DURATION_TOL;
+};
+
+// Step and direction state of an axis from its pins
+struct SimAxisPins
+{
+    int _stepPin;
+    int _dirnPin;
+    int _stepLevel;
+    int _dirnLevel;
+    int32_t _netSteps;
+    int32_t _stepsPerRot;
+    uint32_t _totalSteps;
+    uint64_t _firstStepUs;
+    uint64_t _lastStepUs;
+    uint32_t _minStepIntervalUs;
+    // Intervals between steps in the same direction
+    std::vector<uint32_t> _stepIntervalsUs;
+    bool _dirnChanged;
+};
+
+static SimAxisPins _axisPins[RobotConsts::MAX_AXES];
+static FILE* _pTraceFile = NULL;
+
+static void usage()
+{
+    fprintf(stderr, "Usage: RBotMotionSim [-v] [-o <outFolder>] [-r <runIdx>] [-b <baselineRobot>] [-g <goldenFolder>] <testCases.txt | file.gcode> [<robotType> | <robotConfig.json>]\n");
+}
+
+// Expected results are POS X<mm> Y<mm> .., STEPS <axis0> <axis1> .., VSBASE <maxTimeRatio>, GOLDENTOL <durationTol>,
+// JITTER <maxMinorAxisJitter>, SYMMETRY <maxRampAsymmetry> and PATH <merged> <blended>
+static void parseTestCaseOut(const String& line, SimTestCase& testCase)
+{
+    if (line.startsWith("POS"))
+    {
+        testCase._endPosValid = true;
+        for (int axisIdx = 0; axisIdx < 3; axisIdx++)
+        {
+            int axisPos = line.indexOf("XYZ"[axisIdx]);
+            if (axisPos > 0)
+                testCase._endPosMM.setVal(axisIdx, strtof(line.c_str() + axisPos + 1, NULL));
+        }
+    }
+    else if (line.startsWith("STEPS"))
+    {
+        const char* pStr = line.c_str() + 5;
+        char* pEnd = NULL;
+        for (long steps = strtol(pStr, &pEnd, 10); pEnd != pStr; steps = strtol(pStr, &pEnd, 10))
+        {
+            testCase._totalSteps.push_back(uint32_t(steps));
+            pStr = pEnd;
+        }
+    }
+    else if (line.startsWith("VSBASE"))
+    {
+        testCase._maxTimeVsBaseline = strtof(line.c_str() + 6, NULL);
+    }
+    else if (line.startsWith("GOLDENTOL"))
+    {
+        testCase._goldenDurationTol = strtof(line.c_str() + 9, NULL);
+    }
+    else if (line.startsWith("JITTER"))
+    {
+        testCase._maxMinorAxisJitter = strtof(line.c_str() + 6, NULL);
+    }
+    else if (line.startsWith("SYMMETRY"))
+    {
+        testCase._maxRampAsymmetry = strtof(line.c_str() + 8, NULL);
+    }
+    else if (line.startsWith("PATH"))
+    {
+        char* pEnd = NULL;
+        testCase._pathMerged = int(strtol(line.c_str() + 4, &pEnd, 10));
+        testCase._pathBlended = int(strtol(pEnd, NULL, 10));
+    }
+}
+
+// Test cases file has TESTCASE <name>, IN, lines of GCode, OUT, expected results (other lines are ignored)
+// and ENDTESTCASE - any other file is a single test case of GCode
+static bool loadTestCases(FileManager& fileManager, const String& fileName, std::vector<SimTestCase>& testCases)
+{
+    FILE* pFile = fopen(fileManager.getFileFullPath("", fileName).c_str(), "r");
+    if (!pFile)
+        return false;
+    char lineBuf[1000];
+    bool isTestCaseFile = false;
+    bool inLines = false;
+    bool outLines = false;
+    SimTestCase fileTestCase;
+    int slashPos = fileName.lastIndexOf('/');
+    fileTestCase._name = fileName.substring(slashPos + 1);
+    fileTestCase._name.replace(".", "_");
+    while (fileManager.readLineFromFile(lineBuf, sizeof(lineBuf), pFile))
+    {
+        String line = lineBuf;
+        line.trim();
+        if (line.startsWith("TESTCASE"))
+        {
+            isTestCaseFile = true;
+            SimTestCase testCase;
+            testCase._name = line.substring(8);
+            testCase._name.trim();
+            testCases.push_back(testCase);
+            inLines = false;
+            outLines = false;
+            continue;
+        }
+        if (isTestCaseFile)
+        {
+            if (line.equals("IN") || line.equals("OUT") || line.equals("ENDTESTCASE"))
+            {
+                inLines = line.equals("IN");
+                outLines = line.equals("OUT");
+            }
+            else if (inLines && (line.length() > 0) && (testCases.size() > 0))
+                testCases.back()._lines.push_back(line);
+            else if (outLines && (testCases.size() > 0))
+                parseTestCaseOut(line, testCases.back());
+            continue;
+        }
+        if ((line.length() > 0) && !line.startsWith(";"))
+            fileTestCase._lines.push_back(line);
+    }
+    fclose(pFile);
+    if (!isTestCaseFile)
+        testCases.push_back(fileTestCase);
+    return true;
+}
+
+// Pins written by the motion stack - step pulses (rising edges) and direction changes are traced
+// Direction pin low is forward (see MotionSegmentPreparer)
+static void pinWritten(uint64_t timeNs, int pin, int val)
+{
+    uint64_t timeUs = timeNs / 1000;
+    for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
+    {
+        SimAxisPins& axisPins = _axisPins[axisIdx];
+        if (pin == axisPins._stepPin)
+        {
+            bool isRisingEdge = (val != 0) && (axisPins._stepLevel == 0);
+            axisPins._stepLevel = val;
+            if (!isRisingEdge)
+                return;
+            if (axisPins._totalSteps == 0)
+                axisPins._firstStepUs = timeUs;
+            if ((axisPins._totalSteps > 0) && (timeUs - axisPins._lastStepUs < axisPins._minStepIntervalUs))
+                axisPins._minStepIntervalUs = timeUs - axisPins._lastStepUs;
+            if ((axisPins._totalSteps > 0) && !axisPins._dirnChanged)
+                axisPins._stepIntervalsUs.push_back(uint32_t(timeUs - axisPins._lastStepUs));
+            axisPins._dirnChanged = false;
+            axisPins._lastStepUs = timeUs;
+            axisPins._totalSteps++;
+            axisPins._netSteps += axisPins._dirnLevel ? -1 : 1;
+            if (_pTraceFile)
+                fprintf(_pTraceFile, "W\t%llu\tst%d\t1\n", (unsigned long long)timeUs, axisIdx);
+            return;
+        }
+        if (pin == axisPins._dirnPin)
+        {
+            if (val == axisPins._dirnLevel)
+                return;
+            axisPins._dirnLevel = val;
+            axisPins._dirnChanged = true;
+            if (_pTraceFile)
+                fprintf(_pTraceFile, "W\t%llu\tdr%d\t%d\n", (unsigned long long)timeUs, axisIdx, val);
+            return;
+        }
+    }
+}
+
+static void setupAxisPins(const char* robotConfigStr)
+{
+    for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
+    {
+        SimAxisPins& axisPins = _axisPins[axisIdx];
+        String axisPath = "robotGeom/axis" + String(axisIdx);
+        String stepPinName = RdJson::getString((axisPath + "/stepPin").c_str(), "-1", robotConfigStr);
+        String dirnPinName = RdJson::getString((axisPath + "/dirnPin").c_str(), "-1", robotConfigStr);
+        axisPins._stepPin = ConfigPinMap::getPinFromName(stepPinName.c_str());
+        axisPins._dirnPin = ConfigPinMap::getPinFromName(dirnPinName.c_str());
+        axisPins._stepsPerRot = int32_t(RdJson::getDouble((axisPath + "/stepsPerRot").c_str(), 0, robotConfigStr));
+        axisPins._stepLevel = 0;
+        axisPins._dirnLevel = 0;
+        axisPins._netSteps = 0;
+        axisPins._totalSteps = 0;
+        axisPins._firstStepUs = 0;
+        axisPins._lastStepUs = 0;
+        axisPins._minStepIntervalUs = UINT32_MAX;
+        axisPins._stepIntervalsUs.clear();
+        axisPins._dirnChanged = false;
+    }
+}
+
+// Robots with rotary axes keep the position within one rotation (see correctStepOverflow)
+static bool stepsMatch(int32_t stepsDiff, int32_t stepsPerRot)
+{
+    return (stepsDiff == 0) || ((stepsPerRot > 0) && (stepsDiff % stepsPerRot == 0));
+}
+
+// Difference between two intervals as a fraction of the longer
+static float intervalDiff(uint32_t aUs, uint32_t bUs)
+{
+    uint32_t longerUs = std::max(aUs, bUs);
+    return longerUs > 0 ? float(longerUs - std::min(aUs, bUs)) / longerUs : 0;
+}
+
+// Jitter of an axis's steps - the change between consecutive step intervals as a fraction of the longer
+// at the given percentile (Bresenham steps on an axis with fewer steps than the axis with most fall on
+// that axis's steps so their intervals alternate between multiples of its interval)
+static float stepIntervalJitter(const SimAxisPins& axisPins, float percentile)
+{
+    std::vector<float> jitters;
+    for (unsigned int intervalIdx = 1; intervalIdx < axisPins._stepIntervalsUs.size(); intervalIdx++)
+        jitters.push_back(intervalDiff(axisPins._stepIntervalsUs[intervalIdx - 1], axisPins._stepIntervalsUs[intervalIdx]));
+    if (jitters.size() == 0)
+        return 0;
+    std::sort(jitters.begin(), jitters.end());
+    return jitters[std::min(jitters.size() - 1, size_t(jitters.size() * percentile))];
+}
+
+// Asymmetry of a move from rest to rest - the largest difference between a step interval and the interval
+// the same number of steps from the end (a symmetric profile decelerates as it accelerated and a slow
+// crawl into the last steps shows as a large difference)
+static float rampAsymmetry(const SimAxisPins& axisPins)
+{
+    const std::vector<uint32_t>& intervalsUs = axisPins._stepIntervalsUs;
+    float maxDiff = 0;
+    for (unsigned int intervalIdx = 0; intervalIdx < intervalsUs.size() / 2; intervalIdx++)
+        maxDiff = std::max(maxDiff, intervalDiff(intervalsUs[intervalIdx], intervalsUs[intervalsUs.size() - 1 - intervalIdx]));
+    return maxDiff;
+}
+
+// Step counts of each axis and the time from the first to the last step (of any axis) in a trace
+static bool readStepTrace(const String& fileName, std::vector<uint32_t>& totalSteps, uint64_t& durationUs)
+{
+    FILE* pFile = fopen(fileName.c_str(), "r");
+    if (!pFile)
+        return false;
+    uint64_t firstUs = UINT64_MAX;
+    uint64_t lastUs = 0;
+    char lineBuf[2000];
+    while (fgets(lineBuf, sizeof(lineBuf), pFile))
+    {
+        unsigned long long timeUs = 0;
+        int axisIdx = 0, level = 0;
+        if ((sscanf(lineBuf, "W %llu st%d %d", &timeUs, &axisIdx, &level) != 3) || (level == 0) ||
+                    (axisIdx < 0) || (axisIdx >= RobotConsts::MAX_AXES))
+            continue;
+        if (int(totalSteps.size()) <= axisIdx)
+            totalSteps.resize(axisIdx + 1, 0);
+        totalSteps[axisIdx]++;
+        firstUs = std::min(firstUs, uint64_t(timeUs));
+        lastUs = std::max(lastUs, uint64_t(timeUs));
+    }
+    fclose(pFile);
+    durationUs = lastUs > firstUs ? lastUs - firstUs : 0;
+    return true;
+}
+
+// Check the steps against a golden trace - the step counts must match and the time from first to last
+// step be within the test case's tolerance (the planners differ in detail)
+static bool checkGoldenTrace(const SimTestCase& testCase)
+{
+    std::vector<uint32_t> goldenSteps;
+    uint64_t goldenUs = 0;
+    if (!readStepTrace(testCase._goldenFileName, goldenSteps, goldenUs))
+    {
+        printf(" golden UNREADABLE");
+        return false;
+    }
+    bool goldenOk = true;
+    uint64_t firstUs = UINT64_MAX;
+    uint64_t lastUs = 0;
+    for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
+    {
+        SimAxisPins& axisPins = _axisPins[axisIdx];
+        uint32_t goldenAxisSteps = axisIdx < int(goldenSteps.size()) ? goldenSteps[axisIdx] : 0;
+        uint32_t stepsDiff = axisPins._totalSteps > goldenAxisSteps ? axisPins._totalSteps - goldenAxisSteps :
+                    goldenAxisSteps - axisPins._totalSteps;
+        if (stepsDiff > GOLDEN_STEPS_TOL)
+        {
+            printf(" golden axis%d total %u", axisIdx, goldenAxisSteps);
+            goldenOk = false;
+        }
+        if (axisPins._totalSteps == 0)
+            continue;
+        firstUs = std::min(firstUs, axisPins._firstStepUs);
+        lastUs = std::max(lastUs, axisPins._lastStepUs);
+    }
+    uint64_t durationUs = lastUs > firstUs ? lastUs - firstUs : 0;
+    float durationRatio = goldenUs > 0 ? float(durationUs) / goldenUs : 1;
+    bool durationOk = fabsf(durationRatio - 1) <= testCase._goldenDurationTol;
+    printf(" vsGolden %.3f%s%s", durationRatio, durationOk ? "" : " DURATION", goldenOk ? "" : " STEPS");
+    return goldenOk && durationOk;
+}
+
+// Run a test case against the virtual clock - returns false if it doesn't complete or steps are lost
+// The simulated time is returned in simMs and compared with baselineMs if that is non-zero
+// Stats aren't written if statsFileName is NULL
+static bool runTestCase(const String& robotConfigStr, SimTestCase& testCase, const char* statsFileName,
+                uint32_t& simMs, uint32_t baselineMs)
+{
+    // The motion ISR's timer is created with the robot controller so the clock is reset first
+    HostSim::reset();
+    // End-stop inputs are held inactive (active low)
+    for (int pin = 0; pin < HostSim::MAX_PINS; pin++)
+        HostSim::setInputLevel(pin, 1);
+    setupAxisPins(robotConfigStr.c_str());
+    HostSim::setPinWriteCallback(pinWritten);
+    RobotController* pRobotController = new RobotController();
+    pRobotController->init(robotConfigStr.c_str());
+
+    // Feed the GCode as the work manager does and advance the clock 1ms at a time
+    // Steps are checked against the planned position (status has the position from the steps the ISR counted)
+    AxisPosition startPos;
+    pRobotController->getPlannedPosition(startPos);
+    unsigned int lineIdx = 0;
+    uint32_t settleMs = 0;
+    bool wasHoming = false;
+    for (simMs = 0; simMs < MAX_TEST_CASE_MS; simMs++)
+    {
+        pRobotController->service();
+        // Homing redefines the position in steps so the step check starts again afterwards
+        RobotCommandArgs curStatus;
+        pRobotController->getCurStatus(curStatus);
+        if (curStatus.isHoming())
+            wasHoming = true;
+        else if (wasHoming && pRobotController->isIdle())
+        {
+            wasHoming = false;
+            pRobotController->getPlannedPosition(startPos);
+            for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
+                _axisPins[axisIdx]._netSteps = 0;
+        }
+        while ((lineIdx < testCase._lines.size()) && pRobotController->canAcceptCommand())
+        {
+            WorkItem workItem(testCase._lines[lineIdx++]);
+            EvaluatorGCode::interpretGcode(workItem, pRobotController, true);
+        }
+        HostSim::advanceNs(1000000);
+        StepOutputDriver::clearMockWrites();
+        if ((lineIdx >= testCase._lines.size()) && pRobotController->isIdle() && (++settleMs > SETTLE_MS))
+            break;
+    }
+
+    // Check that the steps output are those the robot expects to have made
+    AxisPosition endPos;
+    pRobotController->getPlannedPosition(endPos);
+    RobotCommandArgs endStatus;
+    pRobotController->getCurStatus(endStatus);
+    bool testOk = simMs < MAX_TEST_CASE_MS;
+    printf("%-40s %s simS %.3f isrCalls %llu", (testCase._name + (statsFileName ? "" : " (baseline)")).c_str(),
+                testOk ? "done" : "TIMEOUT", simMs / 1000.0, (unsigned long long)HostSim::isrCallCount());
+    for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
+    {
+        SimAxisPins& axisPins = _axisPins[axisIdx];
+        if (axisPins._stepPin < 0)
+            continue;
+        int32_t expectedSteps = endPos._stepsFromHome.getVal(axisIdx) - startPos._stepsFromHome.getVal(axisIdx);
+        bool axisOk = stepsMatch(axisPins._netSteps - expectedSteps, axisPins._stepsPerRot);
+        // Once idle the live position in status must have caught up with the planned position
+        int32_t liveSteps = endStatus.getPointSteps().getVal(axisIdx);
+        bool liveOk = stepsMatch(liveSteps - endPos._stepsFromHome.getVal(axisIdx), axisPins._stepsPerRot);
+        testOk &= axisOk && liveOk;
+        printf(" axis%d steps %d%s%s maxRate %u", axisIdx, axisPins._netSteps,
+                    axisOk ? "" : (" EXPECTED " + String(expectedSteps)).c_str(),
+                    liveOk ? "" : (" LIVE " + String(liveSteps)).c_str(),
+                    axisPins._totalSteps > 1 ? 1000000 / axisPins._minStepIntervalUs : 0);
+        // Total steps show the path taken (e.g. which way round an arc went)
+        if (axisIdx < int(testCase._totalSteps.size()))
+        {
+            uint32_t expTotal = testCase._totalSteps[axisIdx];
+            bool totalOk = fabsf(float(axisPins._totalSteps) - expTotal) <= expTotal * TOTAL_STEPS_TOL + 1;
+            testOk &= totalOk;
+            printf(" total %u%s", axisPins._totalSteps, totalOk ? "" : (" EXPECTED " + String(expTotal)).c_str());
+        }
+    }
+    if (testCase._endPosValid)
+    {
+        bool posOk = true;
+        for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
+            posOk &= fabsf(endPos._axisPositionMM.getVal(axisIdx) - testCase._endPosMM.getVal(axisIdx)) <= END_POS_TOL_MM;
+        testOk &= posOk;
+        printf(" endPos X%.3f Y%.3f%s", endPos._axisPositionMM.getVal(0), endPos._axisPositionMM.getVal(1),
+                    posOk ? "" : " UNEXPECTED");
+    }
+    if ((baselineMs > 0) && (testCase._maxTimeVsBaseline > 0))
+    {
+        bool timeOk = simMs <= baselineMs * testCase._maxTimeVsBaseline;
+        testOk &= timeOk;
+        printf(" vsBaseline %.3f%s", float(simMs) / baselineMs, timeOk ? "" : " SLOWER");
+    }
+    if (testCase._maxMinorAxisJitter > 0)
+    {
+        uint32_t maxAxisSteps = 0;
+        for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
+            maxAxisSteps = std::max(maxAxisSteps, _axisPins[axisIdx]._totalSteps);
+        for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
+        {
+            SimAxisPins& axisPins = _axisPins[axisIdx];
+            if ((axisPins._totalSteps == 0) || (axisPins._totalSteps >= maxAxisSteps))
+                continue;
+            float jitter = stepIntervalJitter(axisPins, STEP_JITTER_PERCENTILE);
+            bool jitterOk = jitter <= testCase._maxMinorAxisJitter;
+            testOk &= jitterOk;
+            printf(" axis%d jitter %.3f%s", axisIdx, jitter, jitterOk ? "" : " UNEVEN");
+        }
+    }
+    if (testCase._maxRampAsymmetry > 0)
+    {
+        int maxStepsAxisIdx = 0;
+        for (int axisIdx = 1; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
+            if (_axisPins[axisIdx]._totalSteps > _axisPins[maxStepsAxisIdx]._totalSteps)
+                maxStepsAxisIdx = axisIdx;
+        float asymmetry = rampAsymmetry(_axisPins[maxStepsAxisIdx]);
+        bool symmetryOk = asymmetry <= testCase._maxRampAsymmetry;
+        testOk &= symmetryOk;
+        printf(" axis%d asymmetry %.3f%s", maxStepsAxisIdx, asymmetry, symmetryOk ? "" : " UNEVEN");
+    }
+    if (testCase._pathMerged >= 0)
+    {
+        String statsStr;
+        pRobotController->getMotionStats(statsStr);
+        int merged = int(RdJson::getLong("path/merged", -1, statsStr.c_str()));
+        int blended = int(RdJson::getLong("path/blended", -1, statsStr.c_str()));
+        bool pathOk = (merged == testCase._pathMerged) && (blended == testCase._pathBlended);
+        testOk &= pathOk;
+        printf(" merged %d blended %d%s", merged, blended, pathOk ? "" :
+                    (" EXPECTED " + String(testCase._pathMerged) + " " + String(testCase._pathBlended)).c_str());
+    }
+    if (statsFileName && (testCase._goldenFileName.length() > 0))
+        testOk &= checkGoldenTrace(testCase);
+    printf("\n");
+
+    // Pipeline stats for the run
+    FILE* pStatsFile = statsFileName ? fopen(statsFileName, "w") : NULL;
+    if (pStatsFile)
+    {
+        fprintf(pStatsFile, "%s", pRobotController->getPipelineStatsCSV().c_str());
+        fclose(pStatsFile);
+    }
+    else if (statsFileName)
+    {
+        fprintf(stderr, "Cannot write %s\n", statsFileName);
+        testOk = false;
+    }
+    HostSim::setPinWriteCallback(NULL);
+    delete pRobotController;
+    return testOk;
+}
+
+// Robot config from a file or the default config for the robot type (the first if robotArg is empty)
+static bool getRobotConfig(FileManager& fileManager, String& robotArg, String& robotConfigStr)
+{
+    String robotArgExt = FileManager::getFileExtension(robotArg);
+    if (robotArgExt.equalsIgnoreCase("json"))
+    {
+        robotConfigStr = fileManager.getFileContents("", robotArg);
+        String innerConfigStr = RdJson::getString("robotConfig", "", robotConfigStr.c_str());
+        if (innerConfigStr.length() > 0)
+            robotConfigStr = innerConfigStr;
+    }
+    else
+    {
+        if (robotArg.length() == 0)
+            RobotConfigurations::getNthRobotTypeName(0, robotArg);
+        robotConfigStr = RobotConfigurations::getConfig(robotArg.c_str());
+    }
+    return (robotConfigStr.length() > 0) && !robotConfigStr.equals("{}");
+}
+
+int main(int argc, char** argv)
+{
+    // Args
+    Log.begin(LOG_LEVEL_WARNING);
+    String outFolder = ".";
+    int runIdx = 0;
+    String baselineArg;
+    String goldenFolder;
+    int argIdx = 1;
+    for (; argIdx < argc; argIdx++)
+    {
+        if (strcmp(argv[argIdx], "-v") == 0)
+            Log.begin(LOG_LEVEL_NOTICE);
+        else if ((strcmp(argv[argIdx], "-o") == 0) && (argIdx + 1 < argc))
+            outFolder = argv[++argIdx];
+        else if ((strcmp(argv[argIdx], "-r") == 0) && (argIdx + 1 < argc))
+            runIdx = atoi(argv[++argIdx]);
+        else if ((strcmp(argv[argIdx], "-b") == 0) && (argIdx + 1 < argc))
+            baselineArg = argv[++argIdx];
+        else if ((strcmp(argv[argIdx], "-g") == 0) && (argIdx + 1 < argc))
+            goldenFolder = argv[++argIdx];
+        else
+            break;
+    }
+    if (argIdx >= argc)
+    {
+        usage();
+        return 2;
+    }
+    String fileName = argv[argIdx++];
+    String robotArg = (argIdx < argc) ? argv[argIdx] : "";
+
+    // Robot configs
+    FileManager fileManager;
+    String robotConfigStr, baselineConfigStr;
+    if (!getRobotConfig(fileManager, robotArg, robotConfigStr))
+    {
+        fprintf(stderr, "No robot config for %s\n", robotArg.c_str());
+        usage();
+        return 2;
+    }
+    if ((baselineArg.length() > 0) && !getRobotConfig(fileManager, baselineArg, baselineConfigStr))
+    {
+        fprintf(stderr, "No robot config for %s\n", baselineArg.c_str());
+        usage();
+        return 2;
+    }
+
+    // Test cases
+    std::vector<SimTestCase> testCases;
+    if (!loadTestCases(fileManager, fileName, testCases))
+    {
+        fprintf(stderr, "Cannot read %s\n", fileName.c_str());
+        return 2;
+    }
+
+    // Trace files start with the robot config (on one line) and a blank line
+    String traceHeader = robotConfigStr;
+    traceHeader.replace("\n", " ");
+    traceHeader.replace("\r", " ");
+    int failCount = 0;
+    for (unsigned int testIdx = 0; testIdx < testCases.size(); testIdx++)
+    {
+        // Golden traces are from run 0 (test cases without one aren't checked)
+        if (goldenFolder.length() > 0)
+        {
+            char goldenFileName[300];
+            snprintf(goldenFileName, sizeof(goldenFileName), "%s/steps_%05d_%02d_%s.txt", goldenFolder.c_str(),
+                        0, testIdx, testCases[testIdx]._name.c_str());
+            FILE* pGoldenFile = fopen(goldenFileName, "r");
+            if (pGoldenFile)
+            {
+                fclose(pGoldenFile);
+                testCases[testIdx]._goldenFileName = goldenFileName;
+            }
+        }
+
+        // Baseline run (not traced)
+        uint32_t baselineMs = 0;
+        bool testOk = (baselineConfigStr.length() == 0) || runTestCase(baselineConfigStr, testCases[testIdx], NULL, baselineMs, 0);
+
+        char traceFileName[300];
+        snprintf(traceFileName, sizeof(traceFileName), "%s/steps_%05d_%02d_%s.txt", outFolder.c_str(),
+                    runIdx, testIdx, testCases[testIdx]._name.c_str());
+        _pTraceFile = fopen(traceFileName, "w");
+        if (!_pTraceFile)
+        {
+            fprintf(stderr, "Cannot write %s\n", traceFileName);
+            return 2;
+        }
+        fprintf(_pTraceFile, "%s\n\n", traceHeader.c_str());
+        char statsFileName[300];
+        snprintf(statsFileName, sizeof(statsFileName), "%s/stats_%05d_%02d_%s.csv", outFolder.c_str(),
+                    runIdx, testIdx, testCases[testIdx]._name.c_str());
+        uint32_t simMs = 0;
+        testOk &= runTestCase(robotConfigStr, testCases[testIdx], statsFileName, simMs, baselineMs);
+        if (!testOk)
+            failCount++;
+        fclose(_pTraceFile);
+        _pTraceFile = NULL;
+    }
+    printf("%d test cases %d failed\n", int(testCases.size()), failCount);
+    return failCount == 0 ? 0 : 1;
+}
@@ -156,6 +156,14 @@ void FileManager::reformat(const String& fileSystemStr, String& respStr)
     Log.warning("%sReformat SPIFFS result %s\n", MODULE_PREFIX, (ret == ESP_OK ? "OK" : "FAIL"));
 }
 
+String FileManager::getFileFullPath(const String& fileSystemStr, const String& filename)
+{
+    String nameOfFS;
+    if (!checkFileSystem(fileSystemStr, nameOfFS))
+        return "";
+    return getFilePath(nameOfFS, filename);
+}
+
 bool FileManager::getFileInfo(const String& fileSystemStr, const String& filename, int& fileLength)
 {
     String nameOfFS;
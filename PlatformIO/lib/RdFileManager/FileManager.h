@@ -75,6 +75,9 @@ public:
     // Test file exists and get info
     bool getFileInfo(const String& fileSystemStr, const String& filename, int& fileLength);
 
+    // Get full path of a file for access with stdio (empty if the file system is not available)
+    String getFileFullPath(const String& fileSystemStr, const String& filename);
+
     // Start access to a file in chunks
     bool chunkedFileStart(const String& fileSystemStr, const String& filename, bool readByLine);
 
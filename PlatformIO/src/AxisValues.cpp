@@ -2,52 +2,61 @@
 // Rob Dobson 2016-18
 
 #include "AxisValues.h"
+#include "FastTrig.h"
 
-double AxisUtils::cosineRule(double a, double b, double c)
+float AxisUtils::cosineRule(float a, float b, float c)
 {
     // Calculate angle C of a triangle using the cosine rule
     // Log.verbose("cosineRule a %F b %F c %F acos %F = %F\n",
-    //         a, b, c, (a*a + b*b - c*c) / (2 * a * b), acos((a*a + b*b - c*c) / (2 * a * b)));
-    double val = (a*a + b*b - c*c) / (2 * a * b);
+    //         a, b, c, (a*a + b*b - c*c) / (2 * a * b), acosf((a*a + b*b - c*c) / (2 * a * b)));
+    float val = (a*a + b*b - c*c) / (2 * a * b);
     if (val > 1) val = 1;
     if (val < -1) val = -1;
-    return acos(val);
+    return acosf(val);
 }
 
-double AxisUtils::wrapRadians( double angle )
+float AxisUtils::cosineRuleFast(float a, float b, float c)
 {
-    static const double twoPi = 2.0 * M_PI;
-    // Log.verbose("wrapRadians %F %F\n", angle, angle - twoPi * floor( angle / twoPi ));
-    return angle - twoPi * floor( angle / twoPi );
+    // As cosineRule with the acos approximation (see FastTrig)
+    float val = (a*a + b*b - c*c) / (2 * a * b);
+    if (val > 1) val = 1;
+    if (val < -1) val = -1;
+    return FastTrig::acos(val);
+}
+
+float AxisUtils::wrapRadians(float angle)
+{
+    // Log.verbose("wrapRadians %F %F\n", angle, angle - TWO_PI_F * floorf(angle / TWO_PI_F));
+    return angle - TWO_PI_F * floorf(angle / TWO_PI_F);
 }
 
-double AxisUtils::wrapDegrees( double angle )
+float AxisUtils::wrapDegrees(float angle)
 {
-    // Log.verbose("wrapDegrees %F %F\n", angle, angle - 360 * floor( angle / 360 ));
-    return angle - 360.0 * floor( angle / 360.0 );
+    // Log.verbose("wrapDegrees %F %F\n", angle, angle - 360 * floorf(angle / 360));
+    return angle - 360.0f * floorf(angle / 360.0f);
 }
 
-double AxisUtils::r2d(double angleRadians)
+float AxisUtils::r2d(float angleRadians)
 {
-    // Log.verbose("r2d %F %F\n", angleRadians, angleRadians * 180.0 / M_PI);
-    return angleRadians * 180.0 / M_PI;
+    // Log.verbose("r2d %F %F\n", angleRadians, angleRadians * 180.0f / PI_F);
+    return angleRadians * (180.0f / PI_F);
 }
 
-double AxisUtils::d2r(double angleDegrees)
+float AxisUtils::d2r(float angleDegrees)
 {
-    return angleDegrees * M_PI / 180.0;
+    return angleDegrees * (PI_F / 180.0f);
 }
 
-bool AxisUtils::isApprox(double v1, double v2, double withinRng)
+bool AxisUtils::isApprox(float v1, float v2, float withinRng)
 {
-    // Log.verbose("isApprox %F %F = %d\n", v1, v2, fabs(v1 - v2) < withinRng);
-    return fabs(v1 - v2) < withinRng;
+    // Log.verbose("isApprox %F %F = %d\n", v1, v2, fabsf(v1 - v2) < withinRng);
+    return fabsf(v1 - v2) < withinRng;
 }
 
-bool AxisUtils::isApproxWrap(double v1, double v2, double wrapSize, double withinRng)
+bool AxisUtils::isApproxWrap(float v1, float v2, float wrapSize, float withinRng)
 {
-    // Log.verbose("isApprox %F %F = %d\n", v1, v2, fabs(v1 - v2) < withinRng);
-    double t1 = v1 - wrapSize * floor(v1 / wrapSize);
-    double t2 = v2 - wrapSize * floor(v2 / wrapSize);
-    return (fabs(t1 - t2) < withinRng) || (fabs(t1 - wrapSize - t2) < withinRng) || (fabs(t1 + wrapSize - t2) < withinRng);
+    // Log.verbose("isApprox %F %F = %d\n", v1, v2, fabsf(v1 - v2) < withinRng);
+    float t1 = v1 - wrapSize * floorf(v1 / wrapSize);
+    float t2 = v2 - wrapSize * floorf(v2 / wrapSize);
+    return (fabsf(t1 - t2) < withinRng) || (fabsf(t1 - wrapSize - t2) < withinRng) || (fabsf(t1 + wrapSize - t2) < withinRng);
 }
@@ -9,16 +9,23 @@
 #include <ArduinoLog.h>
 #include "RobotConsts.h"
 
+// Kinematics helpers - single precision as double is emulated in software on the ESP32
+// Angles are good to a few float ulps (< 1e-6 rad for 0..2PI) except cosineRule where the
+// rounding of the cosine near +/-1 gives up to ~5e-4 rad (0.03 degrees) for a triangle that
+// is almost flat (see Tests/TestScaraKinematics)
 class AxisUtils
 {
 public:
-    static double cosineRule(double a, double b, double c);
-    static double wrapRadians(double angle);
-    static double wrapDegrees(double angle);
-    static double r2d(double angleRadians);
-    static double d2r(double angleDegrees);
-    static bool isApprox(double v1, double v2, double withinRng = 0.0001);
-    static bool isApproxWrap(double v1, double v2, double wrapSize=360.0, double withinRng = 0.0001);
+    static constexpr float PI_F = 3.14159265358979f;
+    static constexpr float TWO_PI_F = 6.28318530717959f;
+    static float cosineRule(float a, float b, float c);
+    static float cosineRuleFast(float a, float b, float c);
+    static float wrapRadians(float angle);
+    static float wrapDegrees(float angle);
+    static float r2d(float angleRadians);
+    static float d2r(float angleDegrees);
+    static bool isApprox(float v1, float v2, float withinRng = 0.0001f);
+    static bool isApproxWrap(float v1, float v2, float wrapSize = 360.0f, float withinRng = 0.0001f);
 };
 
 class AxisFloats
@@ -0,0 +1,65 @@
+// RBotFirmware
+// Rob Dobson 2016-18
+
+#pragma once
+
+#include <math.h>
+
+// Polynomial approximations of atan2 and acos for the kinematics - no divisions (other than the
+// one in atan2) and no calls into the maths library other than sqrtf
+// atan is an odd minimax polynomial on [0,1] (error < 1.7e-6 rad) and acos is Abramowitz and Stegun
+// 4.4.46 (error < 2.2e-8 rad) - with float rounding MAX_ERR_RADS covers both
+class FastTrig
+{
+public:
+    static constexpr float MAX_ERR_RADS = 2.5e-6f;
+
+    static inline float atan2(float y, float x)
+    {
+        static constexpr float HALF_PI_F = 1.57079632679490f;
+        static constexpr float PI_F = 3.14159265358979f;
+        float absY = fabsf(y);
+        float absX = fabsf(x);
+        float maxVal = absX > absY ? absX : absY;
+        if (maxVal == 0)
+            return 0;
+        float minVal = absX > absY ? absY : absX;
+        float angle = atanUnit(minVal / maxVal);
+        if (absY > absX)
+            angle = HALF_PI_F - angle;
+        if (x < 0)
+            angle = PI_F - angle;
+        return y < 0 ? -angle : angle;
+    }
+
+    // Valid for -1 <= x <= 1
+    static inline float acos(float x)
+    {
+        static constexpr float PI_F = 3.14159265358979f;
+        float absX = fabsf(x);
+        float poly = -0.0012624911f;
+        poly = poly * absX + 0.0066700901f;
+        poly = poly * absX - 0.0170881256f;
+        poly = poly * absX + 0.0308918810f;
+        poly = poly * absX - 0.0501743046f;
+        poly = poly * absX + 0.0889789874f;
+        poly = poly * absX - 0.2145988016f;
+        poly = poly * absX + 1.5707963050f;
+        float angle = sqrtf(1 - absX) * poly;
+        return x < 0 ? PI_F - angle : angle;
+    }
+
+private:
+    // atan for 0 <= z <= 1
+    static inline float atanUnit(float z)
+    {
+        float z2 = z * z;
+        float poly = -0.01172120f;
+        poly = poly * z2 + 0.05265332f;
+        poly = poly * z2 - 0.11643287f;
+        poly = poly * z2 + 0.19354346f;
+        poly = poly * z2 - 0.33262347f;
+        poly = poly * z2 + 0.99997726f;
+        return poly * z;
+    }
+};
@@ -62,14 +62,38 @@ void RestAPIRobot::apiExec(String &reqStr, String &respStr)
 {
     Log.notice("%sExec %s\n", MODULE_PREFIX, reqStr.c_str());
     WorkItem workItem(RestAPIEndpoints::removeFirstArgStr(reqStr.c_str()).c_str());
-    _workManager.addWorkItem(workItem, respStr);
+    _workManager.postWorkItem(workItem, respStr);
 }
 
 void RestAPIRobot::apiPlayFile(String &reqStr, String &respStr)
 {
     Log.notice("%splayFile %s\n", MODULE_PREFIX, reqStr.c_str());
     WorkItem workItem(RestAPIEndpoints::removeFirstArgStr(reqStr.c_str()).c_str());
-    _workManager.addWorkItem(workItem, respStr);
+    _workManager.postWorkItem(workItem, respStr);
+}
+
+void RestAPIRobot::apiMotionStats(String &reqStr, String &respStr)
+{
+    // Reset if requested (motionstats/reset) - the stats returned are those before the reset
+    String cmdStr = RestAPIEndpoints::getNthArgStr(reqStr.c_str(), 1);
+    _workManager.getMotionStats(respStr);
+    if (cmdStr.equalsIgnoreCase("reset"))
+        _workManager.resetMotionStats();
+}
+
+void RestAPIRobot::apiDryRun(String &reqStr, String &respStr)
+{
+    // Start a dry run of a file (dryrun/filename) or get the status of the latest (dryrun)
+    String fileName = RestAPIEndpoints::removeFirstArgStr(reqStr.c_str());
+    if (fileName.length() == 0)
+    {
+        _workManager.getDryRunStatus(respStr);
+        return;
+    }
+    fileName.replace("~", "/");
+    Log.notice("%sdryRun %s\n", MODULE_PREFIX, fileName.c_str());
+    WorkItem workItem("dryrun " + fileName);
+    _workManager.postWorkItem(workItem, respStr);
 }
 
 void RestAPIRobot::setup(RestAPIEndpoints &endpoints)
@@ -113,6 +137,16 @@ void RestAPIRobot::setup(RestAPIEndpoints &endpoints)
                             std::bind(&RestAPIRobot::apiQueryStatus, this, std::placeholders::_1, std::placeholders::_2),
                             "Query status");
                             
+    // Motion statistics
+    endpoints.addEndpoint("motionstats", RestAPIEndpointDef::ENDPOINT_CALLBACK, RestAPIEndpointDef::ENDPOINT_GET,
+                            std::bind(&RestAPIRobot::apiMotionStats, this, std::placeholders::_1, std::placeholders::_2),
+                            "Motion ISR timing stats, motionstats/reset to clear");
+
+    // Dry run
+    endpoints.addEndpoint("dryrun", RestAPIEndpointDef::ENDPOINT_CALLBACK, RestAPIEndpointDef::ENDPOINT_GET,
+                            std::bind(&RestAPIRobot::apiDryRun, this, std::placeholders::_1, std::placeholders::_2),
+                            "Dry run file filename (no motion) ... ~ for / in filename, dryrun alone gets the result");
+
     // Set LED Strip
     endpoints.addEndpoint("setled", RestAPIEndpointDef::ENDPOINT_CALLBACK, RestAPIEndpointDef::ENDPOINT_POST,
                             std::bind(&RestAPIRobot::apiSetLed, this, std::placeholders::_1, std::placeholders::_2),
@@ -32,5 +32,7 @@ class RestAPIRobot
     void apiPattern(String &reqStr, String &respStr);
     void apiSequence(String &reqStr, String &respStr);
     void apiPlayFile(String &reqStr, String &respStr);
+    void apiMotionStats(String &reqStr, String &respStr);
+    void apiDryRun(String &reqStr, String &respStr);
     void setup(RestAPIEndpoints &endpoints);
 };
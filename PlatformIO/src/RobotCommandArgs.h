@@ -28,6 +28,8 @@ private:
     bool _moreMovesComing : 1;
     bool _isHoming: 1;
     bool _hasHomed: 1;
+    bool _isArc : 1;
+    bool _arcRadiusValid : 1;
     // Command control
     int _queuedCommands;
     int _numberedCommandIndex;
@@ -39,6 +41,10 @@ private:
     float _feedrateValue;
     RobotMoveTypeArg _moveType;
     AxisMinMaxBools _endstops;
+    // Arc centre (offset from start in X and Y) or radius
+    float _arcCentreOffsetI;
+    float _arcCentreOffsetJ;
+    float _arcRadius;
 
 public:
     RobotCommandArgs()
@@ -58,6 +64,8 @@ public:
         _allowOutOfBounds = false;
         _pause = false;
         _moreMovesComing = false;
+        _isArc = false;
+        _arcRadiusValid = false;
         // Command control
         _queuedCommands = 0;
         _numberedCommandIndex = RobotConsts::NUMBERED_COMMAND_NONE;
@@ -69,6 +77,9 @@ public:
         _feedrateValue = 0.0;
         _moveType = RobotMoveTypeArg_None;
         _endstops.none();
+        _arcCentreOffsetI = 0;
+        _arcCentreOffsetJ = 0;
+        _arcRadius = 0;
     }
 
     RobotCommandArgs& operator=(const RobotCommandArgs& copyFrom)
@@ -91,6 +102,7 @@ public:
             (_allowOutOfBounds == other._allowOutOfBounds) &&
             (_pause == other._pause) &&
             (_moreMovesComing == other._moreMovesComing) &&
+            (_isArc == other._isArc) &&
             // Command control
             (_queuedCommands == other._queuedCommands) &&
             (_numberedCommandIndex == other._numberedCommandIndex) &&
@@ -135,6 +147,8 @@ private:
         _allowOutOfBounds = copyFrom._allowOutOfBounds;
         _pause = copyFrom._pause;
         _moreMovesComing = copyFrom._moreMovesComing;
+        _isArc = copyFrom._isArc;
+        _arcRadiusValid = copyFrom._arcRadiusValid;
         // Command control
         _queuedCommands = copyFrom._queuedCommands;
         _numberedCommandIndex = copyFrom._numberedCommandIndex;
@@ -146,6 +160,9 @@ private:
         _feedrateValue = copyFrom._feedrateValue;
         _moveType = copyFrom._moveType;
         _endstops = copyFrom._endstops;
+        _arcCentreOffsetI = copyFrom._arcCentreOffsetI;
+        _arcCentreOffsetJ = copyFrom._arcCentreOffsetJ;
+        _arcRadius = copyFrom._arcRadius;
     }
 
 public:
@@ -244,6 +261,45 @@ public:
     {
         _moveRapid = moveRapid;
     }
+    // Arcs are in the XY plane - the centre is given as an offset from the start point (I, J)
+    // or by the radius (R - negative for an arc of more than 180 degrees)
+    void setArc(bool clockwise)
+    {
+        _isArc = true;
+        _moveClockwise = clockwise;
+    }
+    bool isArc()
+    {
+        return _isArc;
+    }
+    bool isArcClockwise()
+    {
+        return _moveClockwise;
+    }
+    void setArcCentreOffset(int axisIdx, float value)
+    {
+        if (axisIdx == 0)
+            _arcCentreOffsetI = value;
+        else if (axisIdx == 1)
+            _arcCentreOffsetJ = value;
+    }
+    float getArcCentreOffset(int axisIdx)
+    {
+        return axisIdx == 0 ? _arcCentreOffsetI : (axisIdx == 1 ? _arcCentreOffsetJ : 0);
+    }
+    void setArcRadius(float radius)
+    {
+        _arcRadius = radius;
+        _arcRadiusValid = true;
+    }
+    bool isArcRadiusValid()
+    {
+        return _arcRadiusValid;
+    }
+    float getArcRadius()
+    {
+        return _arcRadius;
+    }
     void setMoreMovesComing(bool moreMovesComing)
     {
         _moreMovesComing = moreMovesComing;
@@ -344,6 +400,10 @@ public:
     {
         _isHoming = isHoming;
     }
+    bool isHoming()
+    {
+        return _isHoming;
+    }
     void setHasHomed(bool hasHomed)
     {
         _hasHomed = hasHomed;
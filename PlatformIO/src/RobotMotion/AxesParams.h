@@ -14,10 +14,13 @@ class AxesParams
     AxisParams _axisParams[RobotConsts::MAX_AXES];
     // Master axis
     int _masterAxisIdx;
+    // Kinematics use polynomial trig approximations
+    bool _fastKinematics;
 
   public:
     // Cache values for master axis as they are used frequently in the planner
     float _masterAxisMaxAccMMps2;
+    float _masterAxisMaxJerkMMps3;
     float _masterAxisStepDistanceMM;
     // Cache max and min step rates
     AxisFloats _maxStepRatesPerSec;
@@ -35,7 +38,9 @@ class AxesParams
     void clearAxes()
     {
         _masterAxisIdx = -1;
+        _fastKinematics = false;
         _masterAxisMaxAccMMps2 = AxisParams::acceleration_default;
+        _masterAxisMaxJerkMMps3 = AxisParams::jerk_default;
         _masterAxisStepDistanceMM = AxisParams::unitsPerRot_default / AxisParams::stepsPerRot_default;
         for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
             _axisParams[axisIdx].clear();
@@ -84,6 +89,16 @@ class AxesParams
         return _axisParams[axisIdx]._homeOffsetVal;
     }
 
+    bool isFastKinematics()
+    {
+        return _fastKinematics;
+    }
+
+    void setFastKinematics(bool fastKinematics)
+    {
+        _fastKinematics = fastKinematics;
+    }
+
     AxisParams *getAxisParamsArray()
     {
         return _axisParams;
@@ -139,6 +154,18 @@ class AxesParams
         return getMaxAccel(axisIdx) / getStepDistMM(axisIdx);
     }
 
+    float getMaxJerk(int axisIdx)
+    {
+        if (axisIdx < 0 || axisIdx >= RobotConsts::MAX_AXES)
+            return AxisParams::jerk_default;
+        return _axisParams[axisIdx]._maxJerkMMps3;
+    }
+
+    float getMaxJerkStepsPerSec3(int axisIdx)
+    {
+        return getMaxJerk(axisIdx) / getStepDistMM(axisIdx);
+    }
+
     float getMaxAccStepsPerTTicksPerMs(int axisIdx, uint32_t T_VALUE, float tickRatePerSec)
     {
         if (_cacheLastTickRatePerSec != tickRatePerSec)
@@ -230,6 +257,7 @@ class AxesParams
 
         // Cache values for master axis
         _masterAxisMaxAccMMps2 = getMaxAccel(_masterAxisIdx);
+        _masterAxisMaxJerkMMps3 = getMaxJerk(_masterAxisIdx);
         _masterAxisStepDistanceMM = getStepDistMM(_masterAxisIdx);
     }
 };
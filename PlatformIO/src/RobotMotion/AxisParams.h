@@ -10,6 +10,7 @@ class AxisParams
   public:
     static constexpr float maxSpeed_default = 100.0f;
     static constexpr float acceleration_default = 100.0f;
+    static constexpr float jerk_default = 0.0f;
     static constexpr float stepsPerRot_default = 1.0f;
     static constexpr float unitsPerRot_default = 1.0f;
     static constexpr float homeOffsetVal_default = 0.0f;
@@ -20,6 +21,8 @@ class AxisParams
     float _maxSpeedMMps;
     float _minSpeedMMps;
     float _maxAccelMMps2;
+    // Max jerk (rate of change of acceleration) - 0 if not limited
+    float _maxJerkMMps3;
     float _stepsPerRot;
     float _unitsPerRot;
     bool _minValValid;
@@ -44,6 +47,7 @@ class AxisParams
         _maxSpeedMMps = maxSpeed_default;
         _minSpeedMMps = minSpeedMMps_default;
         _maxAccelMMps2 = acceleration_default;
+        _maxJerkMMps3 = jerk_default;
         _stepsPerRot = stepsPerRot_default;
         _unitsPerRot = unitsPerRot_default;
         _minValValid = false;
@@ -87,6 +91,7 @@ class AxisParams
         // Stepper motor
         _maxSpeedMMps = float(RdJson::getDouble("maxSpeed", AxisParams::maxSpeed_default, axisJSON));
         _maxAccelMMps2 = float(RdJson::getDouble("maxAcc", AxisParams::acceleration_default, axisJSON));
+        _maxJerkMMps3 = float(RdJson::getDouble("maxJerk", AxisParams::jerk_default, axisJSON));
         _stepsPerRot = float(RdJson::getDouble("stepsPerRot", AxisParams::stepsPerRot_default, axisJSON));
         _unitsPerRot = float(RdJson::getDouble("unitsPerRot", AxisParams::unitsPerRot_default, axisJSON));
         _minVal = float(RdJson::getDouble("minVal", 0, _minValValid, axisJSON));
@@ -100,8 +105,8 @@ class AxisParams
 
     void debugLog(int axisIdx)
     {
-        Log.notice("Axis%d params maxSpeed %F, acceleration %F, stepsPerRot %F, unitsPerRot %F\n",
-                   axisIdx, _maxSpeedMMps, _maxAccelMMps2, _stepsPerRot, _unitsPerRot);
+        Log.notice("Axis%d params maxSpeed %F, acceleration %F, jerk %F, stepsPerRot %F, unitsPerRot %F\n",
+                   axisIdx, _maxSpeedMMps, _maxAccelMMps2, _maxJerkMMps3, _stepsPerRot, _unitsPerRot);
         Log.notice("Axis%d params minVal %F (%d), maxVal %F (%d), isDominant %d, isServo %d, homeOffVal %F, homeOffSteps %d\n",
                    axisIdx, _minVal, _minValValid, _maxVal, _maxValValid, _isDominantAxis, _isServoAxis, _homeOffsetVal, _homeOffSteps);
     }
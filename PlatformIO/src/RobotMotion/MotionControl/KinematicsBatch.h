@@ -0,0 +1,96 @@
+// RBotFirmware
+// Rob Dobson 2016-18
+
+#pragma once
+
+#include "../AxisPosition.h"
+#include "../AxesParams.h"
+
+// Points of a split-up move converted to actuator coordinates together
+// The robot's batch function does the part of the conversion that doesn't depend on the current
+// position (e.g. the trig) for all of the points in one call - the per-point function finishes each
+// point when its block is planned (choosing a solution and steps relative to the position reached)
+// Only X and Y are batched so results are looked up by X and Y
+// Points of theta-rho moves also have polar coords (angle clockwise from North and radius) which
+// robots can use rather than X and Y
+class KinematicsBatch
+{
+public:
+    static constexpr int MAX_PTS = 16;
+    static constexpr int MAX_VALS_PER_PT = 4;
+
+    // Points - arrays of each value (rather than of points) so that batch functions can be vectorised
+    int _numPts;
+    float _ptX[MAX_PTS];
+    float _ptY[MAX_PTS];
+    bool _hasPolar;
+    float _ptAngleRads[MAX_PTS];
+    float _ptRadiusMM[MAX_PTS];
+
+    // Results of the batch function (meaning is up to the robot)
+    float _vals[MAX_VALS_PER_PT][MAX_PTS];
+    bool _valid[MAX_PTS];
+
+private:
+    // Next point expected to be looked up
+    int _nextIdx;
+
+public:
+    KinematicsBatch()
+    {
+        clear();
+    }
+
+    void clear()
+    {
+        _numPts = 0;
+        _nextIdx = 0;
+        _hasPolar = false;
+    }
+
+    bool addPt(float x, float y)
+    {
+        if (_numPts >= MAX_PTS)
+            return false;
+        _ptX[_numPts] = x;
+        _ptY[_numPts] = y;
+        _numPts++;
+        return true;
+    }
+
+    bool addPt(float x, float y, float angleRads, float radiusMM)
+    {
+        if (_numPts >= MAX_PTS)
+            return false;
+        _ptAngleRads[_numPts] = angleRads;
+        _ptRadiusMM[_numPts] = radiusMM;
+        _hasPolar = true;
+        return addPt(x, y);
+    }
+
+    // Check if all points have been looked up (or passed over)
+    bool isUsed()
+    {
+        return _nextIdx >= _numPts;
+    }
+
+    // Find a point - returns -1 if not in the batch
+    // Points are looked up in order so the search starts after the last point found
+    int find(AxisFloats& pt)
+    {
+        for (int i = _nextIdx; i < _numPts; i++)
+        {
+            if ((_ptX[i] == pt._pt[0]) && (_ptY[i] == pt._pt[1]))
+            {
+                _nextIdx = i + 1;
+                return i;
+            }
+        }
+        return -1;
+    }
+};
+
+// Robot functions for batches of points
+typedef void (*ptsToActuatorBatchFnType)(KinematicsBatch& batch, AxesParams& axesParams);
+typedef bool (*ptToActuatorFromBatchFnType)(KinematicsBatch& batch, int ptIdx, AxisFloats& targetPt, AxisFloats& outActuator,
+                    AxisPosition& curPos, AxesParams& axesParams, bool allowOutOfBounds);
@@ -10,6 +10,10 @@
 // Instrumentation of motion actuator
 INSTRUMENT_MOTION_ACTUATOR_INSTANCE
 
+#ifdef USE_MOTION_ISR_STATS
+MotionISRStats MotionActuator::_isrStats;
+#endif
+
 #ifdef USE_ESP32_TIMER_ISR
 // Static interval timer
 hw_timer_t *MotionActuator::_isrMotionTimer;
@@ -18,214 +22,163 @@ hw_timer_t *MotionActuator::_isrMotionTimer;
 // Static refrerence to a single MotionActuator instance
 RobotConsts::RawMotionHwInfo_t MotionActuator::_rawMotionHwInfo;
 MotionPipeline* MotionActuator::_pMotionPipeline = NULL;
+MotionPipelineStats* MotionActuator::_pPipelineStats = NULL;
+StepOutputDriver MotionActuator::_stepOutputDriver;
+uint32_t MotionActuator::_stepAxesActive = 0;
+MotionSegmentBuffer MotionActuator::_segmentBuffer;
+MotionSegmentPreparer MotionActuator::_segmentPreparer;
 volatile bool MotionActuator::_isPaused = false;
 bool MotionActuator::_isEnabled = false;
 bool MotionActuator::_endStopReached = false;
+volatile uint16_t MotionActuator::_endStopAbortBlockSeq = MotionSegment::BLOCK_SEQ_NONE;
 int MotionActuator::_lastDoneNumberedCmdIdx = 0;
+uint32_t MotionActuator::_curSegmentTicksLeft = 0;
 uint32_t MotionActuator::_stepsTotalAbs[RobotConsts::MAX_AXES];
 uint32_t MotionActuator::_curStepCount[RobotConsts::MAX_AXES];
-uint32_t MotionActuator::_curStepRatePerTTicks = 0;
+int MotionActuator::_axisIdxWithMaxSteps = 0;
 uint32_t MotionActuator::_curAccumulatorStep = 0;
-uint32_t MotionActuator::_curAccumulatorNS = 0;
 uint32_t MotionActuator::_curAccumulatorRelative[RobotConsts::MAX_AXES];
-int MotionActuator::_endStopCheckNum;
-MotionActuator::EndStopChecks MotionActuator::_endStopChecks[RobotConsts::MAX_AXES];
+uint32_t MotionActuator::_oversampleLevel = 0;
+uint32_t MotionActuator::_accumulatorIncrement[RobotConsts::MAX_AXES];
+uint32_t MotionActuator::_accumulatorStepThreshold = 0;
+volatile int32_t MotionActuator::_stepsExecuted[RobotConsts::MAX_AXES];
+uint32_t MotionActuator::_curDirnNegative = 0;
+int32_t MotionActuator::_stepsExecutedAdjust[RobotConsts::MAX_AXES];
+std::atomic<bool> MotionActuator::_stepsExecutedAdjustPending(false);
+#ifdef USE_EVENT_SCHEDULED_STEPPING
+volatile bool MotionActuator::_eventTimerIdle = true;
+uint64_t MotionActuator::_eventTimeTicks = 0;
+uint64_t MotionActuator::_segmentStartTicks = 0;
+bool MotionActuator::_stepPulseActive = false;
+uint64_t MotionActuator::_stepPulseEndTicks = 0;
+bool MotionActuator::_curSegmentStarted = false;
+uint32_t MotionActuator::_curSegmentStepIdx = 0;
+uint64_t MotionActuator::_curSegmentNextStepFx = 0;
+uint32_t MotionActuator::_curSegmentIntervalFx = 0;
+#endif
 
 // Handle the end of a step for any axis
 bool IRAM_ATTR MotionActuator::handleStepEnd()
 {
-    bool anyPinReset = false;
-    for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
-    {
-        RobotConsts::RawMotionAxis_t *pAxisInfo = &_rawMotionHwInfo._axis[axisIdx];
-        if (pAxisInfo->_pinStepCurLevel == 1)
-        {
-            digitalWrite(pAxisInfo->_pinStep, 0);
-            anyPinReset = true;
-        }
-        pAxisInfo->_pinStepCurLevel = 0;
-    }
-    return anyPinReset;
+    if (!_stepAxesActive)
+        return false;
+    _stepOutputDriver.stepEnd();
+    _stepAxesActive = 0;
+    return true;
 }
 
-// Setup new block - cache all the info needed to process the block and reset
-// motion accumulators to facilitate the block's execution
-void IRAM_ATTR MotionActuator::setupNewBlock(MotionBlock *pBlock)
+// Setup new block - the block info is prepared in the first segment of the block
+// so all that is needed here is to set direction and reset the accumulators
+void IRAM_ATTR MotionActuator::setupNewBlock(MotionSegment *pSegment)
 {
-    // Setup step counts, direction and endstops for each axis
-    _endStopCheckNum = 0;
+    _axisIdxWithMaxSteps = pSegment->_axisIdxWithMaxSteps;
     for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
     {
         // Total steps
-        int32_t stepsTotal = pBlock->_stepsTotalMaybeNeg[axisIdx];
-        _stepsTotalAbs[axisIdx] = abs(stepsTotal);
+        _stepsTotalAbs[axisIdx] = pSegment->_stepsTotalAbs[axisIdx];
         _curStepCount[axisIdx] = 0;
         _curAccumulatorRelative[axisIdx] = 0;
-        // Set direction for the axis
-        RobotConsts::RawMotionAxis_t *pAxisInfo = &_rawMotionHwInfo._axis[axisIdx];
-        if (pAxisInfo->_pinDirection != -1)
-        {
-            digitalWrite(pAxisInfo->_pinDirection,
-                            (stepsTotal >= 0) == pAxisInfo->_pinDirectionReversed);
-        }
 
         // Instrumentation
-        INSTRUMENT_MOTION_ACTUATOR_STEP_DIRN
+        INSTRUMENT_MOTION_ACTUATOR_STEP_DIRN(axisIdx, pSegment->_dirnLevels)
+    }
 
-        // Check if any endstops to setup
-        if (!pBlock->_endStopsToCheck.any())
-            continue;
+    // Set direction for all axes
+    _stepOutputDriver.setDirections(pSegment->_dirnLevels);
+    _curDirnNegative = pSegment->_dirnNegative;
 
-        // Check if the axis is moving in a direction which might result in hitting an active end-stop
-        for (int minMaxIdx = 0; minMaxIdx < AxisMinMaxBools::ENDSTOPS_PER_AXIS; minMaxIdx++)
-        {
-            int pinToTest = -1;
-            bool valToTestFor = false;
-
-            // See if anything to check for
-            AxisMinMaxBools::AxisMinMaxEnum minMaxType = pBlock->_endStopsToCheck.get(axisIdx, minMaxIdx);
-            if (minMaxType == AxisMinMaxBools::END_STOP_NONE)
-                continue;
-
-            // Check for towards - this is different from MAX or MIN because the axis will still move even if
-            // an endstop is hit if the movement is away from that endstop
-            if (minMaxType == AxisMinMaxBools::END_STOP_TOWARDS)
-            {
-                // Stop at max if we're heading towards max OR
-                // stop at min if we're heading towards min
-                if (!(((minMaxIdx == AxisMinMaxBools::MAX_VAL_IDX) && (stepsTotal > 0)) ||
-                        ((minMaxIdx == AxisMinMaxBools::MIN_VAL_IDX) && (stepsTotal < 0))))
-                    continue;
-            }
-            
-            // Pin for stop
-            pinToTest = (minMaxIdx == AxisMinMaxBools::MIN_VAL_IDX) ? 
-                                _rawMotionHwInfo._axis[axisIdx]._pinEndStopMin : 
-                                _rawMotionHwInfo._axis[axisIdx]._pinEndStopMax;
-
-            // Endstop test
-            valToTestFor = (minMaxType != AxisMinMaxBools::END_STOP_NOT_HIT) ? 
-                                _rawMotionHwInfo._axis[axisIdx]._pinEndStopMaxactLvl :
-                                !_rawMotionHwInfo._axis[axisIdx]._pinEndStopMaxactLvl;
-            if (pinToTest != -1)
-            {
-                _endStopChecks[_endStopCheckNum].pin = pinToTest;
-                _endStopChecks[_endStopCheckNum].val = valToTestFor;
-                _endStopCheckNum++;
-            }
-        }
+    // Apply any adjustment to the steps executed (between blocks so no step is lost)
+    if (_stepsExecutedAdjustPending.load(std::memory_order_acquire))
+    {
+        for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
+            _stepsExecuted[axisIdx] += _stepsExecutedAdjust[axisIdx];
+        _stepsExecutedAdjustPending.store(false, std::memory_order_release);
     }
 
     // Accumulator reset
     _curAccumulatorStep = 0;
-    _curAccumulatorNS = 0;
-
-    // Step rate
-    _curStepRatePerTTicks = pBlock->_initialStepRatePerTTicks;
+    _accumulatorStepThreshold = _stepsTotalAbs[_axisIdxWithMaxSteps] << MotionSegment::MAX_OVERSAMPLE_LEVEL;
+    setOversampleLevel(pSegment->_oversampleLevel);
 }
 
-// Update millisecond accumulator to handle acceleration and deceleration
-void IRAM_ATTR MotionActuator::updateMSAccumulator(MotionBlock *pBlock)
+// Set the Bresenham increments for an oversampling level - the axis with most steps steps once
+// every 2^level Bresenham steps
+void IRAM_ATTR MotionActuator::setOversampleLevel(uint32_t oversampleLevel)
 {
-    // Bump the millisec accumulator
-    _curAccumulatorNS += MotionBlock::TICK_INTERVAL_NS;
-
-    // Check for millisec accumulator overflow
-    if (_curAccumulatorNS >= MotionBlock::NS_IN_A_MS)
-    {
-        // Subtract from accumulator leaving remainder to combat rounding errors
-        _curAccumulatorNS -= MotionBlock::NS_IN_A_MS;
-
-        // Check if decelerating
-        if (_curStepCount[pBlock->_axisIdxWithMaxSteps] > pBlock->_stepsBeforeDecel)
-        {
-            if (_curStepRatePerTTicks > std::max(MIN_STEP_RATE_PER_TTICKS + pBlock->_accStepsPerTTicksPerMS,
-                                                 pBlock->_finalStepRatePerTTicks + pBlock->_accStepsPerTTicksPerMS))
-                _curStepRatePerTTicks -= pBlock->_accStepsPerTTicksPerMS;
-        }
-        else if (_curStepRatePerTTicks < pBlock->_maxStepRatePerTTicks)
-        {
-            if (_curStepRatePerTTicks + pBlock->_accStepsPerTTicksPerMS < MotionBlock::TTICKS_VALUE)
-                _curStepRatePerTTicks += pBlock->_accStepsPerTTicksPerMS;
-        }
-    }
+    _oversampleLevel = oversampleLevel;
+    for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
+        _accumulatorIncrement[axisIdx] = _stepsTotalAbs[axisIdx] << (MotionSegment::MAX_OVERSAMPLE_LEVEL - oversampleLevel);
 }
 
 // Handle start of step on each axis
-bool IRAM_ATTR MotionActuator::handleStepMotion(MotionBlock *pBlock)
+bool IRAM_ATTR MotionActuator::handleStepMotion()
 {
-    // Complete Flag
-    bool anyAxisMoving = false;
-
-    // Axis with most steps
-    int axisIdxMaxSteps = pBlock->_axisIdxWithMaxSteps;
-
-    // Subtract from accumulator leaving remainder
-    _curAccumulatorStep -= MotionBlock::TTICKS_VALUE;
-
-    // Step the axis with the greatest step count if needed
-    if (_curStepCount[axisIdxMaxSteps] < _stepsTotalAbs[axisIdxMaxSteps])
-    {
-        // Step this axis
-        RobotConsts::RawMotionAxis_t *pAxisInfo = &_rawMotionHwInfo._axis[axisIdxMaxSteps];
-        if (pAxisInfo->_pinStep != -1)
-        {
-            digitalWrite(pAxisInfo->_pinStep, 1);
-        }
-        pAxisInfo->_pinStepCurLevel = 1;
-        _curStepCount[axisIdxMaxSteps]++;
-        if (_curStepCount[axisIdxMaxSteps] < _stepsTotalAbs[axisIdxMaxSteps])
-            anyAxisMoving = true;
+    // Axes to step (bit per axis)
+    uint32_t axesToStep = 0;
 
-        // Instrumentation
-        INSTRUMENT_MOTION_ACTUATOR_STEP_START(axisIdxMaxSteps)
-    }
-
-    // Check if other axes need stepping
+    // Bresenham on all axes - without oversampling the axis with most steps steps every time
     for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
     {
-        if ((axisIdx == axisIdxMaxSteps) || (_curStepCount[axisIdx] == _stepsTotalAbs[axisIdx]))
+        if (_curStepCount[axisIdx] == _stepsTotalAbs[axisIdx])
             continue;
 
         // Bump the relative accumulator
-        _curAccumulatorRelative[axisIdx] += _stepsTotalAbs[axisIdx];
-        if (_curAccumulatorRelative[axisIdx] >= _stepsTotalAbs[axisIdxMaxSteps])
+        _curAccumulatorRelative[axisIdx] += _accumulatorIncrement[axisIdx];
+        if (_curAccumulatorRelative[axisIdx] >= _accumulatorStepThreshold)
         {
             // Do the remainder calculation
-            _curAccumulatorRelative[axisIdx] -= _stepsTotalAbs[axisIdxMaxSteps];
+            _curAccumulatorRelative[axisIdx] -= _accumulatorStepThreshold;
 
             // Step the axis
-            RobotConsts::RawMotionAxis_t *pAxisInfo = &_rawMotionHwInfo._axis[axisIdx];
-            if (pAxisInfo->_pinStep != -1)
-            {
-                digitalWrite(pAxisInfo->_pinStep, 1);
-            }
-            // Log.trace("MotionActuator::procTick otherAxisStep: %d (ax %d)\n", pAxisInfo->_pinStep, axisIdx);
-            pAxisInfo->_pinStepCurLevel = 1;
+            axesToStep |= (1 << axisIdx);
             _curStepCount[axisIdx]++;
-            if (_curStepCount[axisIdx] < _stepsTotalAbs[axisIdx])
-                anyAxisMoving = true;
+            _stepsExecuted[axisIdx] += (_curDirnNegative & (1 << axisIdx)) ? -1 : 1;
 
             // Instrumentation
             INSTRUMENT_MOTION_ACTUATOR_STEP_START(axisIdx)
         }
     }
 
-    // Return indicator of block complete
-    return anyAxisMoving;
+    // Raise the step pins for all axes together
+    if (axesToStep)
+    {
+        _stepOutputDriver.stepStart(axesToStep);
+        _stepAxesActive = axesToStep;
+    }
+
+    // Other axes complete no later than the axis with most steps
+    return _curStepCount[_axisIdxWithMaxSteps] < _stepsTotalAbs[_axisIdxWithMaxSteps];
 }
 
-void IRAM_ATTR MotionActuator::endMotion(MotionBlock *pBlock)
+// End of block - remove the block (which stays in the pipeline while executing) and its current segment
+void IRAM_ATTR MotionActuator::endMotion(MotionSegment *pSegment)
 {
-    _pMotionPipeline->remove();
+    _pMotionPipeline->removeIfSeq(pSegment->_blockSeq);
     // Check if this is a numbered block - if so record its completion
-    if (pBlock->getNumberedCommandIndex() != RobotConsts::NUMBERED_COMMAND_NONE)
-        _lastDoneNumberedCmdIdx = pBlock->getNumberedCommandIndex();
+    if (pSegment->_numberedCommandIndex != RobotConsts::NUMBERED_COMMAND_NONE)
+        _lastDoneNumberedCmdIdx = pSegment->_numberedCommandIndex;
+    _segmentBuffer.remove();
+    _curSegmentTicksLeft = 0;
+#ifdef USE_EVENT_SCHEDULED_STEPPING
+    _curSegmentStarted = false;
+#endif
 }
 
 // Function that handles ISR calls based on a timer
 // When ISR is enabled this is called every MotionBlock::TICK_INTERVAL_NS nanoseconds
 void IRAM_ATTR MotionActuator::_isrStepperMotion(void)
+{
+#if defined(USE_MOTION_ISR_STATS) && defined(USE_ESP32_TIMER_ISR)
+    _isrStats.isrEntry();
+    _isrStats.setExpectedEntryAfterThis(ISR_TIMER_PERIOD_US * MotionISRStats::CPU_CYCLES_PER_US);
+    stepperMotionTick();
+    _isrStats.isrExit();
+#else
+    stepperMotionTick();
+#endif
+}
+
+void IRAM_ATTR MotionActuator::stepperMotionTick()
 {
     // Instrumentation code to time ISR execution (if enabled - see MotionInstrumentation.h)
     INSTRUMENT_MOTION_ACTUATOR_TIME_START
@@ -238,79 +191,280 @@ void IRAM_ATTR MotionActuator::_isrStepperMotion(void)
     if (_isPaused)
         return;
 
-    // Peek a MotionPipelineElem from the queue
-    MotionBlock *pBlock = _pMotionPipeline->peekGet();
-    if (!pBlock)
-        return;
-
-    // Check if the element can be executed
-    if (!pBlock->_canExecute)
-        return;
-
-    // See if the block was already executing and set isExecuting if not
-    bool newBlock = !pBlock->_isExecuting;
-    pBlock->_isExecuting = true;
-
-    // New block
-    if (newBlock)
+    // Peek a segment from the queue
+    MotionSegment *pSegment = _segmentBuffer.peekGet();
+    if (!pSegment)
     {
-        // Setup new block
-        setupNewBlock(pBlock);
-
-        // Return here to reduce the maximum time this function takes
-        // Assuming this function is called frequently (<50uS intervals say)
-        // then it will make little difference if we return now and pick up on the next tick
+        if (_pPipelineStats)
+            _pPipelineStats->isrNoSegment(_pMotionPipeline->canGet());
         return;
     }
+    if (_pPipelineStats)
+        _pPipelineStats->isrHasSegment();
 
-    // Check endstops        
-    bool endStopHit = false;
-    for (int i = 0; i < _endStopCheckNum; i++)
+    // Check if the segment is being started
+    if (_curSegmentTicksLeft == 0)
     {
-        bool pinVal = digitalRead(_endStopChecks[i].pin);
-        if (pinVal == _endStopChecks[i].val)
-            endStopHit = true;
+        // Discard what remains of a block that was stopped by an end-stop
+        if (pSegment->_blockSeq == _endStopAbortBlockSeq)
+        {
+            _segmentBuffer.remove();
+            return;
+        }
+        _curSegmentTicksLeft = pSegment->_ticks;
+        if (pSegment->_oversampleLevel != _oversampleLevel)
+            setOversampleLevel(pSegment->_oversampleLevel);
+
+        // New block
+        if (pSegment->_isFirstInBlock)
+        {
+            // Setup new block
+            _endStopAbortBlockSeq = MotionSegment::BLOCK_SEQ_NONE;
+            setupNewBlock(pSegment);
+
+            // Return here to reduce the maximum time this function takes and to ensure
+            // direction is set well before the first step
+            _curSegmentTicksLeft--;
+            return;
+        }
     }
 
-    // Handle end-stop hit
-    if (endStopHit)
+    // Check endstops
+    for (int i = 0; i < pSegment->_endStopCheckNum; i++)
     {
-        // Cancel motion (by removing the block) as end-stop reached
-        _endStopReached = true;
-        endMotion(pBlock);
+        bool pinVal = digitalRead(pSegment->_endStopChecks[i].pin);
+        if (pinVal == pSegment->_endStopChecks[i].val)
+        {
+            // Cancel motion (by removing the block) as end-stop reached
+            _endStopReached = true;
+            _endStopAbortBlockSeq = pSegment->_blockSeq;
+            endMotion(pSegment);
+            return;
+        }
     }
 
-    // Update the millisec accumulator - this handles the process of changing speed incrementally to
-    // implement acceleration and deceleration
-    updateMSAccumulator(pBlock);
-
     // Bump the step accumulator
-    _curAccumulatorStep += _curStepRatePerTTicks;
+    _curAccumulatorStep += pSegment->_stepRatePerTTicks;
 
     // Check for step accumulator overflow
     if (_curAccumulatorStep >= MotionBlock::TTICKS_VALUE)
     {
-        // Flag indicating this block is finished
-        bool anyAxisMoving = false;
+        // Subtract from accumulator leaving remainder
+        _curAccumulatorStep -= MotionBlock::TTICKS_VALUE;
 
         // Handle a step
-        anyAxisMoving = handleStepMotion(pBlock);
+        bool anyAxisMoving = handleStepMotion();
 
         // Any axes still moving?
         if (!anyAxisMoving)
         {
             // This block is done
-            endMotion(pBlock);
+            endMotion(pSegment);
+            return;
         }
     }
 
+    // Move to the next segment when this one is complete - the last segment in a block
+    // continues until all steps are done
+    if (!pSegment->_isLastInBlock)
+    {
+        _curSegmentTicksLeft--;
+        if (_curSegmentTicksLeft == 0)
+            _segmentBuffer.remove();
+    }
+
     // Time execution
     INSTRUMENT_MOTION_ACTUATOR_TIME_END
 }
 
+#ifdef USE_EVENT_SCHEDULED_STEPPING
+
+// Set the timer alarm for the next event
+void IRAM_ATTR MotionActuator::scheduleEvent(uint64_t eventTicks)
+{
+    uint64_t nowTicks = timerRead(_isrMotionTimer);
+    _eventTimeTicks = std::max(eventTicks, nowTicks + MIN_ALARM_LEAD_EVENT_TICKS);
+    timerAlarmWrite(_isrMotionTimer, _eventTimeTicks, false);
+    timerAlarmEnable(_isrMotionTimer);
+#ifdef USE_MOTION_ISR_STATS
+    _isrStats.setExpectedEntry((uint32_t)(_eventTimeTicks - nowTicks) *
+                (MotionISRStats::CPU_CYCLES_PER_US / MotionSegment::EVENT_TICKS_PER_US));
+#endif
+}
+
+// Restart the timer when it has stopped (called from the main loop)
+void MotionActuator::kickEventTimer()
+{
+    if (!_eventTimerIdle || _isPaused || !_segmentBuffer.peekGet())
+        return;
+    _eventTimerIdle = false;
+    uint64_t nowTicks = timerRead(_isrMotionTimer) + MIN_ALARM_LEAD_EVENT_TICKS;
+    // Shift the segment timing so that motion continues from where it stopped
+    _segmentStartTicks += nowTicks - _eventTimeTicks;
+    scheduleEvent(nowTicks);
+}
+
+// Function that handles ISR calls when each step edge is scheduled
+// The ISR is called at step start, step end and segment boundaries only
+void IRAM_ATTR MotionActuator::_isrStepperEvent(void)
+{
+#ifdef USE_MOTION_ISR_STATS
+    _isrStats.isrEntry();
+    stepperEvent();
+    _isrStats.isrExit();
+#else
+    stepperEvent();
+#endif
+}
+
+void IRAM_ATTR MotionActuator::stepperEvent()
+{
+    // Instrumentation code to time ISR execution (if enabled - see MotionInstrumentation.h)
+    INSTRUMENT_MOTION_ACTUATOR_TIME_START
+
+    // Scheduled time of this event
+    uint64_t eventTicks = _eventTimeTicks;
+
+    // End a step pulse if it is due
+    if (_stepPulseActive && (eventTicks >= _stepPulseEndTicks))
+    {
+        handleStepEnd();
+        _stepPulseActive = false;
+    }
+
+    while (!_isPaused)
+    {
+        // Peek a segment from the queue
+        MotionSegment *pSegment = _segmentBuffer.peekGet();
+        if (!pSegment)
+        {
+            if (_pPipelineStats)
+                _pPipelineStats->isrNoSegment(_pMotionPipeline->canGet());
+            break;
+        }
+        if (_pPipelineStats)
+            _pPipelineStats->isrHasSegment();
+
+        // Check if the segment is being started
+        if (!_curSegmentStarted)
+        {
+            // Discard what remains of a block that was stopped by an end-stop
+            if (pSegment->_blockSeq == _endStopAbortBlockSeq)
+            {
+                _segmentBuffer.remove();
+                continue;
+            }
+            _curSegmentStarted = true;
+            _curSegmentStepIdx = 0;
+            _curSegmentNextStepFx = uint64_t(pSegment->_firstStepEventTicks) << MotionSegment::EVENT_TICKS_FRAC_BITS;
+            _curSegmentIntervalFx = pSegment->_stepIntervalFx;
+            if (pSegment->_oversampleLevel != _oversampleLevel)
+                setOversampleLevel(pSegment->_oversampleLevel);
+
+            // A new block starts now - otherwise the segment follows on from the previous one
+            if (pSegment->_isFirstInBlock)
+            {
+                _endStopAbortBlockSeq = MotionSegment::BLOCK_SEQ_NONE;
+                _segmentStartTicks = eventTicks;
+                setupNewBlock(pSegment);
+            }
+        }
+
+        // Check if a step is due
+        if (_curSegmentStepIdx < pSegment->_stepsInSegment)
+        {
+            uint64_t stepTicks = _segmentStartTicks + (_curSegmentNextStepFx >> MotionSegment::EVENT_TICKS_FRAC_BITS);
+            if (stepTicks > eventTicks)
+            {
+                scheduleEvent(_stepPulseActive ? std::min(stepTicks, _stepPulseEndTicks) : stepTicks);
+                return;
+            }
+
+            // Wait for the previous step pulse to end
+            if (_stepPulseActive)
+            {
+                scheduleEvent(_stepPulseEndTicks);
+                return;
+            }
+
+            // Check endstops
+            for (int i = 0; i < pSegment->_endStopCheckNum; i++)
+            {
+                bool pinVal = digitalRead(pSegment->_endStopChecks[i].pin);
+                if (pinVal == pSegment->_endStopChecks[i].val)
+                {
+                    // Cancel motion (by removing the block) as end-stop reached
+                    _endStopReached = true;
+                    _endStopAbortBlockSeq = pSegment->_blockSeq;
+                    endMotion(pSegment);
+                    break;
+                }
+            }
+            if (!_curSegmentStarted)
+                continue;
+
+            // Step
+            bool anyAxisMoving = handleStepMotion();
+            _curSegmentStepIdx++;
+            _curSegmentNextStepFx += _curSegmentIntervalFx;
+            _curSegmentIntervalFx += pSegment->_stepIntervalDeltaFx;
+            _stepPulseActive = true;
+            _stepPulseEndTicks = eventTicks + STEP_PULSE_EVENT_TICKS;
+
+            // Check if the block is done - the next block starts when the step pulse is complete
+            if (!anyAxisMoving)
+            {
+                endMotion(pSegment);
+                scheduleEvent(_stepPulseEndTicks);
+                return;
+            }
+            continue;
+        }
+
+        // Last segment in a block with no steps
+        if (pSegment->_isLastInBlock)
+        {
+            endMotion(pSegment);
+            continue;
+        }
+
+        // Move to the next segment when this one's time is up
+        uint64_t segmentEndTicks = _segmentStartTicks + MotionSegment::EVENT_TICKS_PER_SEGMENT;
+        if (segmentEndTicks > eventTicks)
+        {
+            scheduleEvent(_stepPulseActive ? std::min(segmentEndTicks, _stepPulseEndTicks) : segmentEndTicks);
+            return;
+        }
+        _segmentBuffer.remove();
+        _curSegmentStarted = false;
+        _segmentStartTicks = segmentEndTicks;
+    }
+
+    // Nothing more to do until the step pulse ends or the timer is restarted from process()
+    if (_stepPulseActive)
+        scheduleEvent(_stepPulseEndTicks);
+    else
+        _eventTimerIdle = true;
+
+    // Time execution
+    INSTRUMENT_MOTION_ACTUATOR_TIME_END
+}
+
+#endif
+
 // Process method called by main program loop
 void MotionActuator::process()
 {
+    // Prepare segments for the ISR
+    if (_pMotionPipeline)
+        _segmentPreparer.prepare(*_pMotionPipeline, _segmentBuffer, _rawMotionHwInfo, _endStopAbortBlockSeq);
+
+#ifdef USE_EVENT_SCHEDULED_STEPPING
+    // Restart the timer if it stopped
+    if (_eventTimerIdle)
+        kickEventTimer();
+#endif
+
     // If not using ISR call _isrStepperMotion on every process call
 #ifndef USE_ESP32_TIMER_ISR
     _isrStepperMotion();
@@ -331,6 +485,27 @@ String MotionActuator::getDebugStr()
 #endif
 }
 
+void MotionActuator::getMotionStats(String& statsStr)
+{
+#ifdef USE_EVENT_SCHEDULED_STEPPING
+    statsStr = "\"mode\":\"event\"";
+#else
+    statsStr = "\"mode\":\"tick\"";
+#endif
+#ifdef USE_MOTION_ISR_STATS
+    statsStr += "," + _isrStats.toJSON(false);
+#endif
+    statsStr += ",\"notExec\":" + String(_segmentPreparer.getBlockNotExecutableCount());
+}
+
+void MotionActuator::resetMotionStats()
+{
+#ifdef USE_MOTION_ISR_STATS
+    _isrStats.reset();
+#endif
+    _segmentPreparer.resetBlockNotExecutableCount();
+}
+
 void MotionActuator::showDebug()
 {
 #ifdef INSTRUMENT_MOTION_ACTUATOR_ENABLE
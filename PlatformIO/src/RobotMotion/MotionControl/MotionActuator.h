@@ -7,10 +7,16 @@
 #define USE_ESP32_TIMER_ISR 1
 #endif
 
+#include <atomic>
 #include <ArduinoLog.h>
 #include "MotionIO.h"
 #include "MotionInstrumentation.h"
+#include "MotionISRStats.h"
+#include "MotionPipelineStats.h"
 #include "MotionBlock.h"
+#include "MotionSegment.h"
+#include "MotionSegmentPreparer.h"
+#include "StepOutputDriver.h"
 
 class MotionPipeline;
 
@@ -23,19 +29,31 @@ private:
     // Pipeline of blocks to be processed
     static MotionPipeline* _pMotionPipeline;
 
+    // Pipeline underrun telemetry
+    static MotionPipelineStats* _pPipelineStats;
+
     // Raw access to motors and endstops
     static RobotConsts::RawMotionHwInfo_t _rawMotionHwInfo;
 
-    // This is to ensure that the robot never goes to 0 tick rate - which would leave it
-    // immobile forever
-    static constexpr uint32_t MIN_STEP_RATE_PER_SEC = 1;
-    static constexpr uint32_t MIN_STEP_RATE_PER_TTICKS = uint32_t((MIN_STEP_RATE_PER_SEC * 1.0 * MotionBlock::TTICKS_VALUE) / MotionBlock::TICKS_PER_SEC);
+    // Step and direction outputs
+    static StepOutputDriver _stepOutputDriver;
+    // Axes with step pin currently active (bit per axis)
+    static uint32_t _stepAxesActive;
+
+    // Segments prepared from the pipeline in the main loop and executed by the ISR
+    static MotionSegmentBuffer _segmentBuffer;
+    static MotionSegmentPreparer _segmentPreparer;
 
 #ifdef INSTRUMENT_MOTION_ACTUATOR_ENABLE
     // Test code
     static MotionInstrumentation *_pMotionInstrumentation;
 #endif
 
+#ifdef USE_MOTION_ISR_STATS
+    // ISR duration and entry jitter
+    static MotionISRStats _isrStats;
+#endif
+
 #ifdef USE_ESP32_TIMER_ISR
     // ISR based interval timer
     static hw_timer_t *_isrMotionTimer;
@@ -43,40 +61,72 @@ private:
     static constexpr uint32_t ISR_TIMER_PERIOD_US = uint32_t(MotionBlock::TICK_INTERVAL_NS / 1000l);
 #endif
 
+#ifdef USE_EVENT_SCHEDULED_STEPPING
+    // Step pulse width
+    static constexpr uint32_t STEP_PULSE_WIDTH_US = 4;
+    static constexpr uint32_t STEP_PULSE_EVENT_TICKS = STEP_PULSE_WIDTH_US * MotionSegment::EVENT_TICKS_PER_US;
+    // Minimum time from now that an alarm can be set (an alarm in the past would never fire)
+    static constexpr uint32_t MIN_ALARM_LEAD_EVENT_TICKS = 2 * MotionSegment::EVENT_TICKS_PER_US;
+    // Timer is stopped when there is nothing to do and restarted from process()
+    static volatile bool _eventTimerIdle;
+    // Time of the current event and start of the current segment (event timer ticks)
+    static uint64_t _eventTimeTicks;
+    static uint64_t _segmentStartTicks;
+    // Step pulse in progress
+    static bool _stepPulseActive;
+    static uint64_t _stepPulseEndTicks;
+    // Executing segment
+    static bool _curSegmentStarted;
+    static uint32_t _curSegmentStepIdx;
+    static uint64_t _curSegmentNextStepFx;
+    static uint32_t _curSegmentIntervalFx;
+#endif
+
 private:
     // Execution info for the currently executing block
     static bool _isEnabled;
     // End-stop reached
     static bool _endStopReached;
+    // Sequence number of the last block stopped by an end-stop
+    static volatile uint16_t _endStopAbortBlockSeq;
     // Last completed numbered command
     static int _lastDoneNumberedCmdIdx;
+    // Executing segment - ticks remaining (0 if no segment started)
+    static uint32_t _curSegmentTicksLeft;
     // Steps
     static uint32_t _stepsTotalAbs[RobotConsts::MAX_AXES];
     static uint32_t _curStepCount[RobotConsts::MAX_AXES];
-    // Current step rate (in steps per K ticks)
-    static uint32_t _curStepRatePerTTicks;
-    // Accumulators for stepping and acceleration increments
+    static int _axisIdxWithMaxSteps;
+    // Accumulators for stepping
     static uint32_t _curAccumulatorStep;
-    static uint32_t _curAccumulatorNS;
     static uint32_t _curAccumulatorRelative[RobotConsts::MAX_AXES];
-
-    static int _endStopCheckNum;
-    struct EndStopChecks
-    {
-        int pin;
-        bool val;
-    };
-    static EndStopChecks _endStopChecks[RobotConsts::MAX_AXES];
+    // Bresenham increments for the current oversampling level and the value at which an axis steps
+    static uint32_t _oversampleLevel;
+    static uint32_t _accumulatorIncrement[RobotConsts::MAX_AXES];
+    static uint32_t _accumulatorStepThreshold;
+    // Steps executed on each axis (from home) - the live position of the machine
+    static volatile int32_t _stepsExecuted[RobotConsts::MAX_AXES];
+    // Axes of the current block stepping in the negative direction (bit per axis)
+    static uint32_t _curDirnNegative;
+    // Adjustment to the steps executed applied at the start of the next block
+    static int32_t _stepsExecutedAdjust[RobotConsts::MAX_AXES];
+    static std::atomic<bool> _stepsExecutedAdjustPending;
 
 public:
-    MotionActuator(MotionIO &motionIO, MotionPipeline* pMotionPipeline)
+    MotionActuator(MotionIO &motionIO, MotionPipeline* pMotionPipeline, MotionPipelineStats* pPipelineStats)
     {
         // Init
         _pMotionPipeline = pMotionPipeline;
+        _pPipelineStats = pPipelineStats;
         clear();
 
         // If we are using the ISR then create the Spark Interval Timer and start it
-#ifdef USE_ESP32_TIMER_ISR
+#if defined(USE_EVENT_SCHEDULED_STEPPING)
+        // Alarm is set as required for each step edge
+        _isrMotionTimer = timerBegin(0, MotionSegment::EVENT_TIMER_DIVIDER, true);
+        timerAttachInterrupt(_isrMotionTimer, _isrStepperEvent, true);
+        Log.notice("MotionActuator: Starting event scheduled ISR timer\n");
+#elif defined(USE_ESP32_TIMER_ISR)
         _isrMotionTimer = timerBegin(0, CLOCK_RATE_MHZ, true);
         timerAttachInterrupt(_isrMotionTimer, _isrStepperMotion, true);
         timerAlarmWrite(_isrMotionTimer, ISR_TIMER_PERIOD_US, true);
@@ -88,6 +138,38 @@ public:
     static void setRawMotionHwInfo(RobotConsts::RawMotionHwInfo_t &rawMotionHwInfo)
     {
         _rawMotionHwInfo = rawMotionHwInfo;
+        _stepOutputDriver.configure(_rawMotionHwInfo);
+    }
+
+    // Ramp generation - per-step ramps need each step edge to be scheduled
+    static void setRampType(MotionSegmentPreparer::RampType rampType)
+    {
+#ifndef USE_EVENT_SCHEDULED_STEPPING
+        if (rampType == MotionSegmentPreparer::RAMP_PER_STEP)
+        {
+            Log.warning("MotionActuator: perStep ramp needs event scheduled stepping - using perMS\n");
+            rampType = MotionSegmentPreparer::RAMP_PER_MS;
+        }
+#endif
+        _segmentPreparer.setRampType(rampType);
+    }
+
+    // Axis parameters used to compute the stepping profile of each block when it is started
+    static void setAxesParams(AxesParams &axesParams, bool useSCurve)
+    {
+        _segmentPreparer.setAxesParams(&axesParams, useSCurve);
+    }
+
+    // Blocks are only started when the ISR will reach them within this time
+    static void setBlockCommitMs(uint32_t blockCommitMs)
+    {
+        _segmentPreparer.setBlockCommitMs(blockCommitMs);
+    }
+
+    // Oversampling of the step generator at low step rates to smooth the stepping of minor axes
+    static void setStepOversampling(bool enabled)
+    {
+        _segmentPreparer.setOversampleEnabled(enabled);
     }
 
     static void setInstrumentationMode(const char *testModeStr)
@@ -106,6 +188,12 @@ public:
     {
         _isPaused = true;
         _endStopReached = false;
+        _segmentBuffer.clear();
+        _segmentPreparer.clear();
+        _curSegmentTicksLeft = 0;
+#ifdef USE_EVENT_SCHEDULED_STEPPING
+        _curSegmentStarted = false;
+#endif
         _lastDoneNumberedCmdIdx = RobotConsts::NUMBERED_COMMAND_NONE;
 #ifdef TEST_MOTION_ACTUATOR_ENABLE
         _pMotionInstrumentation = NULL;
@@ -135,16 +223,54 @@ public:
     {
         return _lastDoneNumberedCmdIdx;
     }
+
+    // Steps executed on each axis - while moving each axis may be read a step before or after the others
+    static void getStepsExecuted(AxisInt32s& stepsExecuted)
+    {
+        for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
+            stepsExecuted.setVal(axisIdx, _stepsExecuted[axisIdx]);
+    }
+
+    // Set the steps executed on an axis - only when the axis is not moving (e.g. at the home position)
+    static void setStepsExecuted(int axisIdx, int32_t steps)
+    {
+        _stepsExecuted[axisIdx] = steps;
+        _stepsExecutedAdjust[axisIdx] = 0;
+    }
+
+    // Adjust the steps executed (e.g. by whole rotations to keep within range) - applied by the ISR
+    // at the start of the next block so no steps are lost - returns false if one is already pending
+    static bool adjustStepsExecuted(AxisInt32s& adjust)
+    {
+        if (_stepsExecutedAdjustPending.load(std::memory_order_acquire))
+            return false;
+        for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
+            _stepsExecutedAdjust[axisIdx] = adjust.getVal(axisIdx);
+        _stepsExecutedAdjustPending.store(true, std::memory_order_release);
+        return true;
+    }
+
     static void process();
 
     static String getDebugStr();
     static void showDebug();
 
+    // ISR timing statistics as JSON (without enclosing braces) and reset
+    static void getMotionStats(String& statsStr);
+    static void resetMotionStats();
+
 private:
     static void _isrStepperMotion(void);
+    static void stepperMotionTick();
     static bool handleStepEnd();
-    static void setupNewBlock(MotionBlock *pBlock);
-    static void updateMSAccumulator(MotionBlock *pBlock);
-    static bool handleStepMotion(MotionBlock *pBlock);
-    static void endMotion(MotionBlock *pBlock);
+    static void setupNewBlock(MotionSegment *pSegment);
+    static void setOversampleLevel(uint32_t oversampleLevel);
+    static bool handleStepMotion();
+    static void endMotion(MotionSegment *pSegment);
+#ifdef USE_EVENT_SCHEDULED_STEPPING
+    static void _isrStepperEvent(void);
+    static void stepperEvent();
+    static void scheduleEvent(uint64_t eventTicks);
+    static void kickEventTimer();
+#endif
 };
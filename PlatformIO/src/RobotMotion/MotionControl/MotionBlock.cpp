@@ -7,8 +7,6 @@
 
 static const char* MODULE_PREFIX = "MotionBlock: ";
 
-#define DEBUG_STEP_TTICKS_TO_MMPS(val, axesParams, axisIdx) (((val * 1.0) * MotionBlock::TICKS_PER_SEC) / MotionBlock::TTICKS_VALUE) * axesParams.getStepDistMM(axisIdx)
-
 void MotionBlock::setNumberedCommandIndex(int cmdIdx)
 {
     _numberedCommandIndex = cmdIdx;
@@ -45,14 +43,43 @@ void MotionBlock::setStepsToTarget(int axisIdx, int32_t steps)
     }
 }
 
-uint32_t MotionBlock::getExitStepRatePerTTicks()
+float MotionBlock::maxAchievableSpeed(float acceleration, float target_velocity, float distance)
 {
-    return _finalStepRatePerTTicks;
+    return sqrtf(target_velocity * target_velocity + 2.0F * acceleration * distance);
 }
 
-float MotionBlock::maxAchievableSpeed(float acceleration, float target_velocity, float distance)
+// Distance needed to change speed with limited jerk (7-segment S-curve acceleration phase)
+// The phase is symmetric so the average velocity is the mean of the start and end velocities
+float MotionBlock::speedChangeDistance(float acceleration, float jerk, float startVelocity, float endVelocity)
 {
-    return sqrtf(target_velocity * target_velocity + 2.0F * acceleration * distance);
+    float deltaVelocity = fabsf(endVelocity - startVelocity);
+    float timeChanging = 0;
+    if (jerk <= 0)
+        timeChanging = deltaVelocity / acceleration;
+    else if (deltaVelocity * jerk >= acceleration * acceleration)
+        timeChanging = deltaVelocity / acceleration + acceleration / jerk;
+    else
+        timeChanging = 2 * sqrtf(deltaVelocity / jerk);
+    return (startVelocity + endVelocity) / 2 * timeChanging;
+}
+
+// Max speed reachable in a distance with limited jerk - found by bisection as there is no closed form
+float MotionBlock::maxAchievableSpeedSCurve(float acceleration, float jerk, float target_velocity, float distance)
+{
+    // Constant acceleration is an upper bound
+    float highVelocity = maxAchievableSpeed(acceleration, target_velocity, distance);
+    if (jerk <= 0)
+        return highVelocity;
+    float lowVelocity = target_velocity;
+    for (int i = 0; i < SCURVE_SOLVE_ITERATIONS; i++)
+    {
+        float midVelocity = (lowVelocity + highVelocity) / 2;
+        if (speedChangeDistance(acceleration, jerk, target_velocity, midVelocity) > distance)
+            highVelocity = midVelocity;
+        else
+            lowVelocity = midVelocity;
+    }
+    return lowVelocity;
 }
 
 void MotionBlock::forceInBounds(float &val, float lowBound, float highBound)
@@ -72,7 +99,8 @@ void MotionBlock::setEndStopsToCheck(AxisMinMaxBools &endStopCheck)
 // The block's entry and exit speed are now known
 // The block can accelerate and decelerate as required as long as these criteria are met
 // We now compute the stepping parameters to make motion happen
-bool MotionBlock::prepareForStepping(AxesParams &axesParams)
+bool MotionBlock::prepareForStepping(MotionBlockProfile &profile, MotionBlockPlan &plan, float exitSpeedMMps,
+                                     AxesParams &axesParams, bool useSCurve)
 {
     // If block is currently being executed don't change it
     if (_isExecuting)
@@ -82,9 +110,18 @@ bool MotionBlock::prepareForStepping(AxesParams &axesParams)
     uint32_t absMaxStepsForAnyAxis = abs(_stepsTotalMaybeNeg[_axisIdxWithMaxSteps]);
 
     // Get the initial step rate, final step rate and max acceleration for the axis with max steps
-    float initialStepRatePerSec = _entrySpeedMMps / axesParams.getStepDistMM(_axisIdxWithMaxSteps);
-    float finalStepRatePerSec = _exitSpeedMMps / axesParams.getStepDistMM(_axisIdxWithMaxSteps);
-    float axisAccStepsPerSec2 = axesParams.getMaxAccStepsPerSec2(_axisIdxWithMaxSteps);
+    float initialStepRatePerSec = plan._entrySpeedMMps / axesParams.getStepDistMM(_axisIdxWithMaxSteps);
+    float finalStepRatePerSec = exitSpeedMMps / axesParams.getStepDistMM(_axisIdxWithMaxSteps);
+    float axisAccStepsPerSec2 = plan._accMMps2 / axesParams.getStepDistMM(_axisIdxWithMaxSteps);
+
+    // Jerk limited profile
+    float axisJerkStepsPerSec3 = useSCurve ? plan._jerkMMps3 / axesParams.getStepDistMM(_axisIdxWithMaxSteps) : 0;
+    if (axisJerkStepsPerSec3 > 0)
+    {
+        prepareSCurve(profile, plan, axesParams, initialStepRatePerSec, finalStepRatePerSec, axisAccStepsPerSec2, axisJerkStepsPerSec3);
+        return true;
+    }
+    profile._jerkStepsPerTTicksPerMS2 = 0;
 
     // Calculate the distance decelerating and ensure within bounds
     // Using the facts for the block ... (assuming max accleration followed by max deceleration):
@@ -108,7 +145,7 @@ bool MotionBlock::prepareForStepping(AxesParams &axesParams)
     uint32_t stepsDecelerating = 0;
 
     // Find max possible rate for this axis
-    float axisMaxStepRatePerSec = _feedrateMMps / axesParams.getStepDistMM(_axisIdxWithMaxSteps);
+    float axisMaxStepRatePerSec = plan._feedrateMMps / axesParams.getStepDistMM(_axisIdxWithMaxSteps);
 
     // See if max speed will be reached
     uint32_t stepsToMaxSpeed =
@@ -135,30 +172,73 @@ bool MotionBlock::prepareForStepping(AxesParams &axesParams)
     }
 
     // Fill in the step values for this axis
-    _initialStepRatePerTTicks = uint32_t((initialStepRatePerSec * TTICKS_VALUE) / TICKS_PER_SEC);
-    _maxStepRatePerTTicks = uint32_t((axisMaxStepRatePerSec * TTICKS_VALUE) / TICKS_PER_SEC);
-    _finalStepRatePerTTicks = uint32_t((finalStepRatePerSec * TTICKS_VALUE) / TICKS_PER_SEC);
-    _accStepsPerTTicksPerMS = uint32_t(axesParams.getMaxAccStepsPerTTicksPerMs(_axisIdxWithMaxSteps, TTICKS_VALUE, TICKS_PER_SEC));
-    _stepsBeforeDecel = absMaxStepsForAnyAxis - stepsDecelerating;
+    profile._initialStepRatePerTTicks = uint32_t((initialStepRatePerSec * TTICKS_VALUE) / TICKS_PER_SEC);
+    profile._maxStepRatePerTTicks = uint32_t((axisMaxStepRatePerSec * TTICKS_VALUE) / TICKS_PER_SEC);
+    profile._finalStepRatePerTTicks = uint32_t((finalStepRatePerSec * TTICKS_VALUE) / TICKS_PER_SEC);
+    profile._accStepsPerTTicksPerMS = uint32_t((axisAccStepsPerSec2 * TTICKS_VALUE) / TICKS_PER_SEC / 1000);
+    profile._stepsBeforeDecel = absMaxStepsForAnyAxis - stepsDecelerating;
 
     return true;
 }
 
+// Steps to accelerate from the initial rate to the peak rate and decelerate to the final rate
+static float sCurveStepsNeeded(float acc, float jerk, float initialRate, float peakRate, float finalRate)
+{
+    return MotionBlock::speedChangeDistance(acc, jerk, initialRate, peakRate) +
+           MotionBlock::speedChangeDistance(acc, jerk, peakRate, finalRate);
+}
+
+// Jerk limited (S-curve) profile - the peak rate is the highest which allows the block to reach it
+// from the initial rate and get back down to the final rate within the block's steps
+void MotionBlock::prepareSCurve(MotionBlockProfile &profile, MotionBlockPlan &plan, AxesParams &axesParams,
+                                float initialStepRatePerSec, float finalStepRatePerSec,
+                                float axisAccStepsPerSec2, float axisJerkStepsPerSec3)
+{
+    float absMaxStepsForAnyAxis = float(abs(_stepsTotalMaybeNeg[_axisIdxWithMaxSteps]));
+    float axisMaxStepRatePerSec = plan._feedrateMMps / axesParams.getStepDistMM(_axisIdxWithMaxSteps);
+    float lowStepRatePerSec = fmaxf(initialStepRatePerSec, finalStepRatePerSec);
+    float peakStepRatePerSec = fmaxf(axisMaxStepRatePerSec, lowStepRatePerSec);
+    if (sCurveStepsNeeded(axisAccStepsPerSec2, axisJerkStepsPerSec3, initialStepRatePerSec, peakStepRatePerSec,
+                          finalStepRatePerSec) > absMaxStepsForAnyAxis)
+    {
+        // Max rate can't be reached so find the highest rate that can
+        float highStepRatePerSec = peakStepRatePerSec;
+        peakStepRatePerSec = lowStepRatePerSec;
+        for (int i = 0; i < SCURVE_SOLVE_ITERATIONS; i++)
+        {
+            float midStepRatePerSec = (peakStepRatePerSec + highStepRatePerSec) / 2;
+            if (sCurveStepsNeeded(axisAccStepsPerSec2, axisJerkStepsPerSec3, initialStepRatePerSec, midStepRatePerSec,
+                                  finalStepRatePerSec) > absMaxStepsForAnyAxis)
+                highStepRatePerSec = midStepRatePerSec;
+            else
+                peakStepRatePerSec = midStepRatePerSec;
+        }
+    }
+
+    // Deceleration starts when the remaining steps are those needed to slow to the final rate
+    uint32_t stepsDecelerating = uint32_t(ceilf(speedChangeDistance(axisAccStepsPerSec2, axisJerkStepsPerSec3,
+                                                                    peakStepRatePerSec, finalStepRatePerSec)));
+    stepsDecelerating = std::min(stepsDecelerating, uint32_t(absMaxStepsForAnyAxis));
+
+    // Fill in the step values for this axis
+    profile._initialStepRatePerTTicks = uint32_t((initialStepRatePerSec * TTICKS_VALUE) / TICKS_PER_SEC);
+    profile._maxStepRatePerTTicks = uint32_t((peakStepRatePerSec * TTICKS_VALUE) / TICKS_PER_SEC);
+    profile._finalStepRatePerTTicks = uint32_t((finalStepRatePerSec * TTICKS_VALUE) / TICKS_PER_SEC);
+    profile._accStepsPerTTicksPerMS = uint32_t((axisAccStepsPerSec2 * TTICKS_VALUE) / TICKS_PER_SEC / 1000);
+    profile._jerkStepsPerTTicksPerMS2 = std::max(uint32_t((axisJerkStepsPerSec3 * TTICKS_VALUE) / TICKS_PER_SEC / 1000000), uint32_t(1));
+    profile._stepsBeforeDecel = uint32_t(absMaxStepsForAnyAxis) - stepsDecelerating;
+}
+
 void MotionBlock::debugShowBlkHead()
 {
-    Log.notice("#i EntMMps ExtMMps StTotX StTotY StTotZ St>Dec    Init      Pk     Fin     Acc\n");
+    Log.notice("#i EntMMps MaxEnt FeedMMps StTotX StTotY StTotZ\n");
 }
 
-void MotionBlock::debugShowBlock(int elemIdx, AxesParams &axesParams)
+void MotionBlock::debugShowBlock(int elemIdx, MotionBlockPlan &plan)
 {
-    Log.notice("%2d%8.3f%8.3f%7d%7d%7d%7u%8.3f%8.3f%8.3f%8u\n", elemIdx,
-                _entrySpeedMMps, _exitSpeedMMps,
+    Log.notice("%2d%8.3f%8.3f%8.3f%7d%7d%7d\n", elemIdx,
+                plan._entrySpeedMMps, plan._maxEntrySpeedMMps, plan._feedrateMMps,
                 getStepsToTarget(0),
                 getStepsToTarget(1),
-                getStepsToTarget(2),
-                _stepsBeforeDecel,
-                DEBUG_STEP_TTICKS_TO_MMPS(_initialStepRatePerTTicks, axesParams, 0),
-                DEBUG_STEP_TTICKS_TO_MMPS(_maxStepRatePerTTicks, axesParams, 0),
-                DEBUG_STEP_TTICKS_TO_MMPS(_finalStepRatePerTTicks, axesParams, 0),
-                _accStepsPerTTicksPerMS);
+                getStepsToTarget(2));
 }
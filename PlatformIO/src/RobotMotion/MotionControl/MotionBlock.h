@@ -7,6 +7,68 @@
 #include "AxisValues.h"
 #include "../AxesParams.h"
 
+// Planner side of a block - kept alongside the block in the pipeline and no longer used
+// once the block has been started
+struct MotionBlockPlan
+{
+    // Max speed for move (maybe reduced by feedrate in a GCode command)
+    float _feedrateMMps;
+    // Distance (pythagorean) to move considering primary axes only - or the distance moved by the axis
+    // with most steps when planning in actuator space
+    float _moveDistPrimaryAxesMM;
+    // Computed max entry speed for a block based on max junction deviation calculation
+    float _maxEntrySpeedMMps;
+    // Computed entry speed for this block (the exit speed is the entry speed of the following block)
+    float _entrySpeedMMps;
+    // Acceleration and jerk limits for the block's direction of travel (from the per-axis limits)
+    float _accMMps2;
+    float _jerkMMps3;
+
+    MotionBlockPlan()
+    {
+        clear();
+    }
+
+    void clear()
+    {
+        _feedrateMMps = 0;
+        _moveDistPrimaryAxesMM = 0;
+        _maxEntrySpeedMMps = 0;
+        _entrySpeedMMps = 0;
+        _accMMps2 = 0;
+        _jerkMMps3 = 0;
+    }
+};
+
+// Stepping acceleration/deceleration profile - computed when a block is started as its entry and
+// exit speeds are then fixed so only the block being stepped needs one
+struct MotionBlockProfile
+{
+    // Steps before deceleration
+    uint32_t _stepsBeforeDecel;
+    uint32_t _initialStepRatePerTTicks;
+    uint32_t _maxStepRatePerTTicks;
+    uint32_t _finalStepRatePerTTicks;
+    uint32_t _accStepsPerTTicksPerMS;
+    // Change in acceleration per MS for jerk limited (S-curve) profiles - 0 for trapezoidal
+    uint32_t _jerkStepsPerTTicksPerMS2;
+
+    MotionBlockProfile()
+    {
+        clear();
+    }
+
+    void clear()
+    {
+        _stepsBeforeDecel = 0;
+        _initialStepRatePerTTicks = 0;
+        _maxStepRatePerTTicks = 0;
+        _finalStepRatePerTTicks = 0;
+        _accStepsPerTTicksPerMS = 0;
+        _jerkStepsPerTTicksPerMS2 = 0;
+    }
+};
+
 class MotionBlock
 {
 public:
@@ -25,44 +87,34 @@ public:
     // Number of ns in ms
     static constexpr uint32_t NS_IN_A_MS = 1000000;
 
+    // Iterations of bisection when solving for S-curve speeds
+    static constexpr int SCURVE_SOLVE_ITERATIONS = 16;
+
 public:
-    // Max speed for move (maybe reduced by feedrate in a GCode command)
-    float _feedrateMMps;
-    // Distance (pythagorean) to move considering primary axes only
-    float _moveDistPrimaryAxesMM;
-    // Computed max entry speed for a block based on max junction deviation calculation
-    float _maxEntrySpeedMMps;
-    // Computed entry speed for this block
-    float _entrySpeedMMps;
-    // Computed exit speed for this block
-    float _exitSpeedMMps;
+    // Execution record - this is what stays in the pipeline for every block so it is kept compact
+    // Steps to target
+    int32_t _stepsTotalMaybeNeg[RobotConsts::MAX_AXES];
     // End-stops to test
     AxisMinMaxBools _endStopsToCheck;
     // Numbered command index - to help keep track of block execution from other processes
     // like homing
     int _numberedCommandIndex;
+    uint8_t _axisIdxWithMaxSteps;
 
-    // Flags
+    // Flags - only used in the main loop (the ISR works from segments so never reads the block)
     struct
     {
         // Flag indicating the block is currently executing
-        volatile bool _isExecuting : 1;
+        bool _isExecuting : 1;
         // Flag indicating the block can start executing
-        volatile bool _canExecute : 1;
+        bool _canExecute : 1;
         // Block is followed by others
         bool _blockIsFollowed : 1;
     };
 
-    // Steps to target and before deceleration
-    int32_t _stepsTotalMaybeNeg[RobotConsts::MAX_AXES];
-    int _axisIdxWithMaxSteps;
-    uint32_t _stepsBeforeDecel;
-
-    // Stepping acceleration/deceleration profile
-    uint32_t _initialStepRatePerTTicks;
-    uint32_t _maxStepRatePerTTicks;
-    uint32_t _finalStepRatePerTTicks;
-    uint32_t _accStepsPerTTicksPerMS;
+    // Sequence number given to the block when it is started (0 before then) - the ISR only removes
+    // the block from the pipeline when it finishes the segments with this number
+    uint16_t _blockSeq;
 
 public:
     MotionBlock()
@@ -73,20 +125,11 @@ public:
     void clear()
     {
         // Clear values
-        _feedrateMMps = 0;
-        _moveDistPrimaryAxesMM = 0;
-        _maxEntrySpeedMMps = 0;
-        _entrySpeedMMps = 0;
-        _exitSpeedMMps = 0;
         _isExecuting = false;
         _canExecute = false;
         _blockIsFollowed = false;
+        _blockSeq = 0;
         _axisIdxWithMaxSteps = 0;
-        _accStepsPerTTicksPerMS = 0;
-        _finalStepRatePerTTicks = 0;
-        _initialStepRatePerTTicks = 0;
-        _maxStepRatePerTTicks = 0;
-        _stepsBeforeDecel = 0;
         _numberedCommandIndex = 0;
         _endStopsToCheck.none();
         for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
@@ -98,17 +141,23 @@ public:
     int32_t getStepsToTarget(int axisIdx);
     int32_t getAbsStepsToTarget(int axisIdx);
     void setStepsToTarget(int axisIdx, int32_t steps);
-    uint32_t getExitStepRatePerTTicks();
     static float maxAchievableSpeed(float acceleration, float target_velocity, float distance);
+    static float speedChangeDistance(float acceleration, float jerk, float startVelocity, float endVelocity);
+    static float maxAchievableSpeedSCurve(float acceleration, float jerk, float target_velocity, float distance);
     void forceInBounds(float &val, float lowBound, float highBound);
     void setEndStopsToCheck(AxisMinMaxBools &endStopCheck);
 
     // The block's entry and exit speed are now known
     // The block can accelerate and decelerate as required as long as these criteria are met
     // We now compute the stepping parameters to make motion happen
-    bool prepareForStepping(AxesParams &axesParams);
+    // If useSCurve is set and the axis has a jerk limit then the profile is jerk limited (S-curve)
+    bool prepareForStepping(MotionBlockProfile &profile, MotionBlockPlan &plan, float exitSpeedMMps,
+                            AxesParams &axesParams, bool useSCurve);
+    void prepareSCurve(MotionBlockProfile &profile, MotionBlockPlan &plan, AxesParams &axesParams,
+                       float initialStepRatePerSec, float finalStepRatePerSec,
+                       float axisAccStepsPerSec2, float axisJerkStepsPerSec3);
 
     // Debug
     void debugShowBlkHead();
-    void debugShowBlock(int elemIdx, AxesParams &axesParams);
+    void debugShowBlock(int elemIdx, MotionBlockPlan &plan);
 };
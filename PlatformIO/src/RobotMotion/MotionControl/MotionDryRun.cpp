@@ -0,0 +1,109 @@
+// RBotFirmware
+// Rob Dobson 2016-2018
+
+#include "MotionDryRun.h"
+#include "MotionPipeline.h"
+
+void MotionDryRun::service(MotionPipeline &motionPipeline)
+{
+    // Prepare segments as for the ISR and count blocks as they are started
+    _segmentPreparer.prepare(motionPipeline, _segmentBuffer, _rawMotionHwInfo, MotionSegment::BLOCK_SEQ_NONE);
+    countStartedBlocks(motionPipeline);
+
+    // Wait if there is nothing to execute
+    MotionSegment *pSegment = _segmentBuffer.peekGet();
+    if (!pSegment)
+    {
+        _clockUs += 1000;
+        return;
+    }
+
+    // Step rate of the axis with most steps (Bresenham steps are faster when oversampling)
+    float stepsPerSec = float(pSegment->_stepRatePerTTicks >> pSegment->_oversampleLevel) *
+                MotionBlock::TICKS_PER_SEC / MotionBlock::TTICKS_VALUE;
+    uint32_t maxAxisSteps = pSegment->_stepsTotalAbs[pSegment->_axisIdxWithMaxSteps];
+    if (maxAxisSteps > 0)
+    {
+        for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
+        {
+            float axisStepsPerSec = stepsPerSec * pSegment->_stepsTotalAbs[axisIdx] / maxAxisSteps;
+            if (_result._peakStepsPerSec[axisIdx] < axisStepsPerSec)
+                _result._peakStepsPerSec[axisIdx] = axisStepsPerSec;
+        }
+    }
+
+    // Segments last 1ms except the last in a block which ends at the block's last step
+    uint32_t segmentUs = MotionSegment::TICKS_PER_SEGMENT * MotionBlock::TICK_INTERVAL_NS / 1000;
+    if (pSegment->_isLastInBlock && (pSegment->_stepRatePerTTicks > 0))
+    {
+        float stepsUs = float(pSegment->_stepsInSegment) * MotionBlock::TTICKS_VALUE / pSegment->_stepRatePerTTicks *
+                    MotionBlock::TICK_INTERVAL_NS / 1000;
+        segmentUs = uint32_t(std::min(stepsUs, float(segmentUs)));
+    }
+    if (!_hasStarted)
+    {
+        _firstBlockStartUs = _clockUs;
+        _hasStarted = true;
+    }
+    _clockUs += segmentUs;
+
+    // Remove the block from the pipeline when its last segment is done - as the ISR does
+    if (pSegment->_isLastInBlock)
+    {
+        if (motionPipeline.removeIfSeq(pSegment->_blockSeq) && (_blocksCounted > 0))
+            _blocksCounted--;
+        _lastBlockEndUs = _clockUs;
+    }
+    _segmentBuffer.remove();
+}
+
+// Count blocks started by the segment preparer - their entry speeds are now fixed so the
+// junction with the block before can be checked for a slowdown
+void MotionDryRun::countStartedBlocks(MotionPipeline &motionPipeline)
+{
+    while (true)
+    {
+        MotionBlock *pBlock = motionPipeline.peekNthFromGet(_blocksCounted);
+        if (!pBlock || !pBlock->_isExecuting)
+            return;
+        MotionBlockPlan *pPlan = motionPipeline.peekPlanNthFromGet(_blocksCounted);
+        _blocksCounted++;
+        _result._blockCount++;
+
+        // Peak speed the previous block could reach with its entry speed and this block's entry speed as its exit
+        if (_prevPlanValid)
+        {
+            float peakSpeedMMps = sqrtf((2 * _prevPlan._accMMps2 * _prevPlan._moveDistPrimaryAxesMM +
+                        _prevPlan._entrySpeedMMps * _prevPlan._entrySpeedMMps +
+                        pPlan->_entrySpeedMMps * pPlan->_entrySpeedMMps) / 2);
+            peakSpeedMMps = std::min(peakSpeedMMps, _prevPlan._feedrateMMps);
+            if (pPlan->_entrySpeedMMps < peakSpeedMMps * SLOWDOWN_SPEED_RATIO)
+                _result._slowdownCount++;
+        }
+        _prevPlan = *pPlan;
+        _prevPlanValid = true;
+    }
+}
+
+void MotionDryRun::addMove(AxisFloats &startPosMM, AxisFloats &endPosMM)
+{
+    addPoint(startPosMM);
+    addPoint(endPosMM);
+}
+
+void MotionDryRun::addPoint(AxisFloats &ptMM)
+{
+    float x = ptMM.getVal(0);
+    float y = ptMM.getVal(1);
+    if (!_result._boundsValid)
+    {
+        _result._minXMM = _result._maxXMM = x;
+        _result._minYMM = _result._maxYMM = y;
+        _result._boundsValid = true;
+        return;
+    }
+    _result._minXMM = std::min(_result._minXMM, x);
+    _result._maxXMM = std::max(_result._maxXMM, x);
+    _result._minYMM = std::min(_result._minYMM, y);
+    _result._maxYMM = std::max(_result._maxYMM, y);
+}
@@ -0,0 +1,133 @@
+// RBotFirmware
+// Rob Dobson 2016-2018
+
+#pragma once
+
+#include <Arduino.h>
+#include "MotionSegment.h"
+#include "MotionSegmentPreparer.h"
+
+class MotionPipeline;
+
+// Result of a dry run
+struct MotionDryRunResult
+{
+    // Time from the start of the first block to the end of the last
+    float _timeS;
+    // Blocks executed
+    uint32_t _blockCount;
+    // Junctions at which a block had to slow down for the one following it
+    uint32_t _slowdownCount;
+    // Extent of the moves in X and Y
+    bool _boundsValid;
+    float _minXMM;
+    float _maxXMM;
+    float _minYMM;
+    float _maxYMM;
+    // Peak step rate of each axis
+    float _peakStepsPerSec[RobotConsts::MAX_AXES];
+
+    void clear()
+    {
+        _timeS = 0;
+        _blockCount = 0;
+        _slowdownCount = 0;
+        _boundsValid = false;
+        _minXMM = _maxXMM = _minYMM = _maxYMM = 0;
+        for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
+            _peakStepsPerSec[axisIdx] = 0;
+    }
+
+    String toJSON()
+    {
+        String jsonStr = "{\"timeS\":" + String(_timeS, 2) + ",\"blocks\":" + String(_blockCount) +
+                    ",\"slowdowns\":" + String(_slowdownCount);
+        if (_boundsValid)
+            jsonStr += ",\"xMin\":" + String(_minXMM, 2) + ",\"xMax\":" + String(_maxXMM, 2) +
+                    ",\"yMin\":" + String(_minYMM, 2) + ",\"yMax\":" + String(_maxYMM, 2);
+        jsonStr += ",\"peakStepsPerSec\":[";
+        for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
+            jsonStr += (axisIdx == 0 ? "" : ",") + String(int(_peakStepsPerSec[axisIdx]));
+        return jsonStr + "]}";
+    }
+};
+
+// Dry run of motion - the pipeline is consumed against a simulated clock rather than by the ISR so
+// the run time, extent and step rates of a job can be found without moving the motors
+// Segments are prepared by the same MotionSegmentPreparer as is used for the ISR and each is
+// taken to last as long as the ISR would take to step it
+class MotionDryRun
+{
+public:
+    // A junction counts as a slowdown if the speed there is below this fraction of the
+    // peak speed the block before it could have reached
+    static constexpr float SLOWDOWN_SPEED_RATIO = 0.95f;
+
+private:
+    // Segments prepared as for the ISR
+    MotionSegmentBuffer _segmentBuffer;
+    MotionSegmentPreparer _segmentPreparer;
+    RobotConsts::RawMotionHwInfo_t _rawMotionHwInfo;
+
+    // Simulated clock (us) and the time the first block started and the last finished
+    uint64_t _clockUs;
+    uint64_t _firstBlockStartUs;
+    uint64_t _lastBlockEndUs;
+    bool _hasStarted;
+
+    // Blocks at the head of the pipeline which have been started and counted
+    unsigned int _blocksCounted;
+    // Plan of the block last started - used to find slowdowns at the junction with the next
+    MotionBlockPlan _prevPlan;
+    bool _prevPlanValid;
+
+    // Results
+    MotionDryRunResult _result;
+
+public:
+    MotionDryRun()
+    {
+        clear();
+    }
+
+    void configure(RobotConsts::RawMotionHwInfo_t &rawMotionHwInfo, MotionSegmentPreparer::RampType rampType,
+                   bool stepOversampling, AxesParams &axesParams, bool useSCurve, uint32_t blockCommitMs)
+    {
+        _rawMotionHwInfo = rawMotionHwInfo;
+        _segmentPreparer.setRampType(rampType);
+        _segmentPreparer.setOversampleEnabled(stepOversampling);
+        _segmentPreparer.setAxesParams(&axesParams, useSCurve);
+        _segmentPreparer.setBlockCommitMs(blockCommitMs);
+        clear();
+    }
+
+    // Pipeline must be cleared at the same time
+    void clear()
+    {
+        _segmentBuffer.clear();
+        _segmentPreparer.clear();
+        _clockUs = 0;
+        _firstBlockStartUs = 0;
+        _lastBlockEndUs = 0;
+        _hasStarted = false;
+        _blocksCounted = 0;
+        _prevPlanValid = false;
+        _result.clear();
+    }
+
+    // Called in place of the ISR - executes one segment (or waits 1ms if there is none)
+    void service(MotionPipeline &motionPipeline);
+
+    // Extent of a move
+    void addMove(AxisFloats &startPosMM, AxisFloats &endPosMM);
+
+    void getResult(MotionDryRunResult &result)
+    {
+        result = _result;
+        result._timeS = _hasStarted ? (_lastBlockEndUs - _firstBlockStartUs) / 1e6f : 0;
+    }
+
+private:
+    void countStartedBlocks(MotionPipeline &motionPipeline);
+    void addPoint(AxisFloats &ptMM);
+};
@@ -6,18 +6,26 @@
 #include "MotionHelper.h"
 #include "Utils.h"
 #include "AxisValues.h"
+#include "FastTrig.h"
 
 // #define MOTION_LOG_DEBUG 1
 
 static const char* MODULE_PREFIX = "MotionHelper: ";
 
-MotionHelper::MotionHelper() : _motionActuator(_motionIO, &_motionPipeline),
-                               _motionHoming(this)
+MotionHelper::MotionHelper(bool isDryRun) : _motionHoming(this)
 {
+    // Actuator or dry run
+    _pMotionActuator = NULL;
+    _pMotionDryRun = NULL;
+    if (isDryRun)
+        _pMotionDryRun = new MotionDryRun();
+    else
+        _pMotionActuator = new MotionActuator(_motionIO, &_motionPipeline, &_pipelineStats);
     // Init
     _isPaused = false;
     _moveRelative = false;
     _blockDistanceMM = 0;
+    _arcToleranceMM = arcToleranceMM_default;
     _allowAllOutOfBounds = false;
     // Clear axis current location
     _curAxisPosition.clear();
@@ -25,13 +33,23 @@ MotionHelper::MotionHelper() : _motionActuator(_motionIO, &_motionPipeline),
     _ptToActuatorFn = NULL;
     _actuatorToPtFn = NULL;
     _correctStepOverflowFn = NULL;
+    _ptsToActuatorBatchFn = NULL;
+    _ptToActuatorFromBatchFn = NULL;
     // Handling of splitting-up of motion into smaller blocks
     _blocksToAddTotal = 0;
+    _blocksToAddIsArc = false;
+    _blocksToAddIsPolar = false;
+    _blocksToAddBatchEnd = 0;
+    // Telemetry
+    _motionPlanner.setPipelineStats(&_pipelineStats);
+    _motionStatsResetRequested = false;
 }
 
 // Destructor
 MotionHelper::~MotionHelper()
 {
+    delete _pMotionActuator;
+    delete _pMotionDryRun;
 }
 
 // Each robot has a set of functions that transform points from real-world coordinates
@@ -50,6 +68,17 @@ void MotionHelper::setTransforms(ptToActuatorFnType ptToActuatorFn, actuatorToPt
     _setRobotAttributes = setRobotAttributes;
 }
 
+// Robots can also convert the points of split-up moves in batches - the batch function does the
+// part of the conversion which doesn't depend on the position reached and the other function
+// finishes each point as it is planned
+void MotionHelper::setBatchTransforms(ptsToActuatorBatchFnType ptsToActuatorBatchFn,
+                                      ptToActuatorFromBatchFnType ptToActuatorFromBatchFn)
+{
+    _ptsToActuatorBatchFn = ptsToActuatorBatchFn;
+    _ptToActuatorFromBatchFn = ptToActuatorFromBatchFn;
+    _kinematicsBatch.clear();
+}
+
 // Configure the robot and pipeline parameters using a JSON input string
 void MotionHelper::configure(const char *robotConfigJSON)
 {
@@ -61,27 +90,57 @@ void MotionHelper::configure(const char *robotConfigJSON)
     _blockDistanceMM = float(RdJson::getDouble("blockDistanceMM", blockDistanceMM_default, robotGeom.c_str()));
     _allowAllOutOfBounds = bool(RdJson::getLong("allowOutOfBounds", false, robotGeom.c_str()));
     float junctionDeviation = float(RdJson::getDouble("junctionDeviation", junctionDeviation_default, robotGeom.c_str()));
-    Log.notice("%sconfigMotionPipeline len %d, blockDistMM %F (0=no-max), allowOoB %s, jnDev %F\n", MODULE_PREFIX,
-               pipelineLen, _blockDistanceMM, _allowAllOutOfBounds ? "Y" : "N", junctionDeviation);
+    String rampType = RdJson::getString("rampType", rampType_default, robotGeom.c_str());
+    bool stepOversampling = RdJson::getLong("stepOversampling", stepOversampling_default, robotGeom.c_str()) != 0;
+    bool jointSpacePlanning = RdJson::getLong("jointSpacePlanning", jointSpacePlanning_default, robotGeom.c_str()) != 0;
+    uint32_t blockCommitMs = uint32_t(RdJson::getLong("blockCommitMs", blockCommitMs_default, robotGeom.c_str()));
+    _arcToleranceMM = float(RdJson::getDouble("arcToleranceMM", arcToleranceMM_default, robotGeom.c_str()));
+    // A zero tolerance would need an infinite number of chords
+    _arcToleranceMM = fmaxf(_arcToleranceMM, arcToleranceMM_min);
+    float pathMergeTolMM = float(RdJson::getDouble("pathMergeTolMM", pathMergeTolMM_default, robotGeom.c_str()));
+    float pathBlendTolMM = float(RdJson::getDouble("pathBlendTolMM", pathBlendTolMM_default, robotGeom.c_str()));
+    bool fastKinematics = RdJson::getLong("fastKinematics", fastKinematics_default, robotGeom.c_str()) != 0;
+    Log.notice("%sconfigMotionPipeline len %d, blockDistMM %F (0=no-max), allowOoB %s, jnDev %F, ramp %s, oversample %s, jointSpace %s, commitMs %d, arcTolMM %F\n", MODULE_PREFIX,
+               pipelineLen, _blockDistanceMM, _allowAllOutOfBounds ? "Y" : "N", junctionDeviation, rampType.c_str(),
+               stepOversampling ? "Y" : "N", jointSpacePlanning ? "Y" : "N", blockCommitMs, _arcToleranceMM);
 
     // Pipeline length and block size
     _motionPipeline.init(pipelineLen);
 
+    // Path simplification - merged blocks are kept within the block distance
+    _pathSimplifier.configure(pathMergeTolMM, pathBlendTolMM, _blockDistanceMM > 0.01f ? _blockDistanceMM : 0);
+    Log.notice("%sconfigPathSimplifier mergeTolMM %F, blendTolMM %F, fastKinematics %s\n", MODULE_PREFIX,
+               pathMergeTolMM, pathBlendTolMM, fastKinematics ? "Y" : "N");
+
     // Motion Pipeline and Planner
-    _motionPlanner.configure(junctionDeviation);
+    _motionPlanner.configure(junctionDeviation, rampType.equalsIgnoreCase("sCurve"), jointSpacePlanning, blockCommitMs);
 
     // MotionIO
     _motionIO.deinit();
 
     // Configure Axes
     _axesParams.clearAxes();
+    _axesParams.setFastKinematics(fastKinematics);
+    _kinematicsBatch.clear();
     String axisJSON;
     for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
     {
         if (_axesParams.configureAxis(robotGeom.c_str(), axisIdx, axisJSON))
         {
-            // Configure motionIO - motors and end-stops
-            _motionIO.configureAxis(axisJSON.c_str(), axisIdx);
+            // Configure motionIO - motors and end-stops (not used for a dry run)
+            if (_pMotionActuator)
+                _motionIO.configureAxis(axisJSON.c_str(), axisIdx);
+        }
+    }
+
+    // The trig approximations must be well within a microstep (half of one allowing for rounding to steps)
+    if (fastKinematics)
+    {
+        float microstepRads = AxisUtils::TWO_PI_F / fmaxf(_axesParams.getStepsPerRot(0), _axesParams.getStepsPerRot(1));
+        if (3 * FastTrig::MAX_ERR_RADS > microstepRads / 2)
+        {
+            Log.warning("%sfastKinematics not accurate enough for stepsPerRot so not used\n", MODULE_PREFIX);
+            _axesParams.setFastKinematics(false);
         }
     }
 
@@ -93,16 +152,38 @@ void MotionHelper::configure(const char *robotConfigJSON)
     _motionHoming.configure(robotGeom.c_str());
 
     // MotionIO
-    _motionIO.configureMotors(robotGeom.c_str());
+    if (_pMotionActuator)
+        _motionIO.configureMotors(robotGeom.c_str());
 
     // Give the MotionActuator access to raw motionIO info
     // this enables ISR based motion to be faster
     RobotConsts::RawMotionHwInfo_t rawMotionHwInfo;
     _motionIO.getRawMotionHwInfo(rawMotionHwInfo);
-    _motionActuator.setRawMotionHwInfo(rawMotionHwInfo);
+
+    // Acceleration ramp generation
+    MotionSegmentPreparer::RampType segmentRampType = rampType.equalsIgnoreCase("perStep") ?
+                MotionSegmentPreparer::RAMP_PER_STEP : MotionSegmentPreparer::RAMP_PER_MS;
+    if (_pMotionDryRun)
+    {
+        _pMotionDryRun->configure(rawMotionHwInfo, segmentRampType, stepOversampling, _axesParams,
+                    rampType.equalsIgnoreCase("sCurve"), blockCommitMs);
+    }
+    else
+    {
+        _pMotionActuator->setRawMotionHwInfo(rawMotionHwInfo);
+        _pMotionActuator->setRampType(segmentRampType);
+        _pMotionActuator->setStepOversampling(stepOversampling);
+        _pMotionActuator->setAxesParams(_axesParams, rampType.equalsIgnoreCase("sCurve"));
+        _pMotionActuator->setBlockCommitMs(blockCommitMs);
+    }
 
     // Clear motion info
     _curAxisPosition.clear();
+    if (_pMotionActuator)
+    {
+        for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
+            _pMotionActuator->setStepsExecuted(axisIdx, 0);
+    }
 }
 
 // Check if a command can be accepted into the motion pipeline
@@ -111,14 +192,16 @@ bool MotionHelper::canAccept()
     // Check if homing in progress
     if (_motionHoming.isHomingInProgress())
         return false;
-    // Check that the motion pipeline can accept new data
-    return (_blocksToAddTotal == 0) && _motionPipeline.canAccept();
+    // Check that the motion pipeline can accept new data (and a held block)
+    return (_blocksToAddTotal == 0) && _motionPipeline.canAccept() &&
+            (!_pathSimplifier.isHeld() || (_motionPipeline.slotsFree() >= 2));
 }
 
 // Pause (or un-pause) all motion
 void MotionHelper::pause(bool pauseIt)
 {
-    _motionActuator.pause(pauseIt);
+    if (_pMotionActuator)
+        _pMotionActuator->pause(pauseIt);
     _isPaused = pauseIt;
 }
 
@@ -131,15 +214,20 @@ bool MotionHelper::isPaused()
 // Stop
 void MotionHelper::stop()
 {
+    // The actuator is cleared first as this pauses the ISR which consumes the pipeline
+    _pathSimplifier.clear();
+    if (_pMotionActuator)
+        _pMotionActuator->clear();
+    else
+        _pMotionDryRun->clear();
     _motionPipeline.clear();
-    _motionActuator.clear();
     pause(false);
 }
 
 // Check if idle
 bool MotionHelper::isIdle()
 {
-    return !_motionPipeline.canGet();
+    return !_motionPipeline.canGet() && !_pathSimplifier.isHeld() && (_blocksToAddTotal == 0);
 }
 
 // Set parameters such as relative vs absolute motion
@@ -153,9 +241,11 @@ void MotionHelper::setMotionParams(RobotCommandArgs &args)
 // Get current status of robot
 void MotionHelper::getCurStatus(RobotCommandArgs &args)
 {
-    // Get current position
-    args.setPointMM(_curAxisPosition._axisPositionMM);
-    args.setPointSteps(_curAxisPosition._stepsFromHome);
+    // Get current position - from the steps executed as planning can be the whole pipeline ahead
+    AxisPosition livePos;
+    getLivePosition(livePos);
+    args.setPointMM(livePos._axisPositionMM);
+    args.setPointSteps(livePos._stepsFromHome);
     // Get end-stop values
     AxisMinMaxBools endstops;
     _motionIO.getEndStopVals(endstops);
@@ -170,6 +260,28 @@ void MotionHelper::getCurStatus(RobotCommandArgs &args)
     args.setNumQueued(_motionPipeline.count());
 }
 
+// Get the position of the machine from the steps executed so far (for a dry run the planned position)
+void MotionHelper::getLivePosition(AxisPosition &livePos)
+{
+    livePos = _curAxisPosition;
+    if (!_pMotionActuator)
+        return;
+    _pMotionActuator->getStepsExecuted(livePos._stepsFromHome);
+    // The robot may change the axes params it is given (e.g. GeistBot's home offsets) so a copy is used
+    if (_correctStepOverflowFn)
+    {
+        AxesParams axesParams = _axesParams;
+        _correctStepOverflowFn(livePos, axesParams);
+    }
+    if (_actuatorToPtFn)
+    {
+        AxisFloats actuatorPos;
+        for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
+            actuatorPos.setVal(axisIdx, livePos._stepsFromHome.getVal(axisIdx));
+        _actuatorToPtFn(actuatorPos, livePos._axisPositionMM, livePos, _axesParams);
+    }
+}
+
 // Get attributes of robot
 void MotionHelper::getRobotAttributes(String& robotAttrs)
 {
@@ -179,6 +291,14 @@ void MotionHelper::getRobotAttributes(String& robotAttrs)
 // Command the robot to home one or more axes
 void MotionHelper::goHome(RobotCommandArgs &args)
 {
+    releaseHeldBlock(false);
+    // There are no end-stops in a dry run so homing is taken to complete immediately
+    if (_pMotionDryRun)
+    {
+        for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
+            setCurPositionAsHome(axisIdx);
+        return;
+    }
     _motionHoming.homingStart(args);
 }
 
@@ -188,12 +308,15 @@ bool MotionHelper::moveTo(RobotCommandArgs &args)
     // Handle stepwise motion
     if (args.isStepwise())
     {
+        releaseHeldBlock(false);
         return _motionPlanner.moveToStepwise(args, _curAxisPosition, _axesParams, _motionPipeline);
     }
     // Convert coordinates if required
     // Convert coords to MM (in-place conversion)
     if (_convertCoordsFn)
         _convertCoordsFn(args, _axesParams);
+    // Moves start from the end of the last block queued (which may be held by the path simplifier)
+    AxisFloats startPos = queuedEndPosMM();
     // Fill in the destPos for axes for which values not specified
     // Handle relative motion override if present
     // Don't use servo values for computing distance to travel
@@ -203,7 +326,7 @@ bool MotionHelper::moveTo(RobotCommandArgs &args)
     {
         if (!args.isValid(i))
         {
-            destPos.setVal(i, _curAxisPosition._axisPositionMM.getVal(i));
+            destPos.setVal(i, startPos.getVal(i));
         }
         else
         {
@@ -213,14 +336,14 @@ bool MotionHelper::moveTo(RobotCommandArgs &args)
             if (args.getMoveType() != RobotMoveTypeArg_None)
                 moveRelative = (args.getMoveType() == RobotMoveTypeArg_Relative);
             if (moveRelative)
-                destPos.setVal(i, _curAxisPosition._axisPositionMM.getVal(i) + args.getValMM(i));
-            // Log.notice("%smoveTo ax %d, pos %F\n", MODULE_PREFIX, i, _curAxisPosition._axisPositionMM.getVal(i));
+                destPos.setVal(i, startPos.getVal(i) + args.getValMM(i));
+            // Log.notice("%smoveTo ax %d, pos %F\n", MODULE_PREFIX, i, startPos.getVal(i));
         }
         includeDist[i] = _axesParams.isPrimaryAxis(i);
     }
 
     // Split up into blocks of maximum length
-    double lineLen = destPos.distanceTo(_curAxisPosition._axisPositionMM, includeDist);
+    double lineLen = destPos.distanceTo(startPos, includeDist);
 
     // Ensure at least one block
     int numBlocks = 1;
@@ -231,13 +354,29 @@ bool MotionHelper::moveTo(RobotCommandArgs &args)
     // Log.verbose("%snumBlocks %d (lineLen %F / blockDistMM %F)\n", MODULE_PREFIX,
     //                 numBlocks, lineLen, _blockDistanceMM);
 
+    // Arcs are split into chords
+    _blocksToAddIsArc = false;
+    if (args.isArc())
+    {
+        numBlocks = setupArc(args, destPos);
+        if (numBlocks == 0)
+            return false;
+    }
+
+    // Theta-rho moves are split in polar coords (rather than along the chord)
+    _blocksToAddIsPolar = false;
+    if (args.isThetaRho() && !args.isArc() && args.isValid(0) && args.isValid(1) && (numBlocks > 1))
+        numBlocks = setupPolar(startPos, destPos, numBlocks);
+
     // Setup for adding blocks to the pipe
     _blocksToAddCommandArgs = args;
-    _blocksToAddStartPos = _curAxisPosition._axisPositionMM;
-    _blocksToAddDelta = (destPos - _curAxisPosition._axisPositionMM) / float(numBlocks);
+    _blocksToAddStartPos = startPos;
+    _blocksToAddDelta = (destPos - startPos) / float(numBlocks);
     _blocksToAddEndPos = destPos;
     _blocksToAddCurBlock = 0;
     _blocksToAddTotal = numBlocks;
+    _blocksToAddBatchEnd = 0;
+    _kinematicsBatch.clear();
 
     // Process anything that can be done immediately
     blocksToAddProcess();
@@ -249,18 +388,27 @@ bool MotionHelper::moveTo(RobotCommandArgs &args)
 void MotionHelper::blocksToAddProcess()
 {
     // Check if we can add anything to the pipeline
-    while (_motionPipeline.canAccept())
+    while (true)
     {
         // Check if any blocks remain to be expanded out
         if (_blocksToAddTotal <= 0)
             return;
 
-        // Add to pipeline any blocks that are waiting to be expanded out
-        AxisFloats nextBlockDest = _blocksToAddStartPos + _blocksToAddDelta * float(_blocksToAddCurBlock + 1);
+        // Check the pipeline has space
+        if (!_motionPipeline.canAccept())
+        {
+            _pipelineStats.addBlocked();
+            return;
+        }
 
-        // If last block then just use end point coords
-        if (_blocksToAddCurBlock + 1 >= _blocksToAddTotal)
-            nextBlockDest = _blocksToAddEndPos;
+        // Convert the next points to actuator coords together if the robot supports it
+        // (the points of theta-rho moves are always generated into the batch)
+        if ((_ptsToActuatorBatchFn || _blocksToAddIsPolar) && (_blocksToAddCurBlock >= _blocksToAddBatchEnd))
+            blocksToAddFillBatch();
+
+        // Add to pipeline any blocks that are waiting to be expanded out
+        AxisFloats nextBlockDest;
+        blocksToAddGetPoint(_blocksToAddCurBlock, nextBlockDest);
 
         // Bump position
         _blocksToAddCurBlock++;
@@ -279,15 +427,244 @@ void MotionHelper::blocksToAddProcess()
     }
 }
 
-// Add a movement to the pipeline using the planner which computes suitable motion
+// End point of a split-up block
+void MotionHelper::blocksToAddGetPoint(int blockIdx, AxisFloats &pt)
+{
+    // If last block then just use end point coords
+    if (blockIdx + 1 >= _blocksToAddTotal)
+    {
+        pt = _blocksToAddEndPos;
+        return;
+    }
+    pt = _blocksToAddStartPos + _blocksToAddDelta * float(blockIdx + 1);
+
+    // Point on the arc
+    if (_blocksToAddIsArc)
+    {
+        float angle = _blocksToAddArcStartAngle + _blocksToAddArcSweep * (blockIdx + 1) / _blocksToAddTotal;
+        pt.setVal(0, _blocksToAddArcCentreX + _blocksToAddArcRadius * cosf(angle));
+        pt.setVal(1, _blocksToAddArcCentreY + _blocksToAddArcRadius * sinf(angle));
+    }
+
+    // Point in polar coords (generated when the batch was filled)
+    if (_blocksToAddIsPolar)
+    {
+        int batchIdx = blockIdx - (_blocksToAddBatchEnd - _kinematicsBatch._numPts);
+        pt.setVal(0, _kinematicsBatch._ptX[batchIdx]);
+        pt.setVal(1, _kinematicsBatch._ptY[batchIdx]);
+    }
+}
+
+// Put the next points of the split-up move into the kinematics batch and convert them
+// Points are looked up when planned - any that are not (e.g. merged by the path simplifier
+// or still held when the batch is refilled) are just converted on their own
+void MotionHelper::blocksToAddFillBatch()
+{
+    _kinematicsBatch.clear();
+    int numPts = std::min(_blocksToAddTotal - _blocksToAddCurBlock, KinematicsBatch::MAX_PTS);
+    _blocksToAddBatchEnd = _blocksToAddCurBlock + numPts;
+    if (numPts < 2)
+        return;
+    for (int blockIdx = _blocksToAddCurBlock; blockIdx < _blocksToAddBatchEnd; blockIdx++)
+    {
+        if (_blocksToAddIsPolar)
+        {
+            float angle = _blocksToAddPolarStartAngle + _blocksToAddPolarSweep * (blockIdx + 1) / _blocksToAddTotal;
+            float radius = _blocksToAddPolarStartRadius + _blocksToAddPolarDeltaRadius * (blockIdx + 1);
+            if (blockIdx + 1 >= _blocksToAddTotal)
+            {
+                _kinematicsBatch.addPt(_blocksToAddEndPos.getVal(0), _blocksToAddEndPos.getVal(1), angle, radius);
+                continue;
+            }
+            // Rotate on by one block
+            float sinA = _blocksToAddPolarSin * _blocksToAddPolarStepCos + _blocksToAddPolarCos * _blocksToAddPolarStepSin;
+            float cosA = _blocksToAddPolarCos * _blocksToAddPolarStepCos - _blocksToAddPolarSin * _blocksToAddPolarStepSin;
+            _blocksToAddPolarSin = sinA;
+            _blocksToAddPolarCos = cosA;
+            _kinematicsBatch.addPt(radius * sinA, radius * cosA, angle, radius);
+        }
+        else
+        {
+            AxisFloats pt;
+            blocksToAddGetPoint(blockIdx, pt);
+            _kinematicsBatch.addPt(pt._pt[0], pt._pt[1]);
+        }
+    }
+    if (_ptsToActuatorBatchFn)
+        _ptsToActuatorBatchFn(_kinematicsBatch, _axesParams);
+}
+
+// Set up a theta-rho move in the XY plane - the angle and the radius (about the origin) change
+// linearly from the start to the destination taking the shorter way round
+// Returns the number of blocks (at least as many as for the chord)
+int MotionHelper::setupPolar(AxisFloats &startPos, AxisFloats &destPos, int numBlocks)
+{
+    float startX = startPos.getVal(0), startY = startPos.getVal(1);
+    float destX = destPos.getVal(0), destY = destPos.getVal(1);
+    float startRadius = sqrtf(startX * startX + startY * startY);
+    float destRadius = sqrtf(destX * destX + destY * destY);
+
+    // At the origin the angle is that of the other end
+    float startAngle = atan2f(startX, startY);
+    float destAngle = atan2f(destX, destY);
+    if (startRadius < MotionBlock::MINIMUM_MOVE_DIST_MM)
+        startAngle = destAngle;
+    if (destRadius < MotionBlock::MINIMUM_MOVE_DIST_MM)
+        destAngle = startAngle;
+    float sweep = destAngle - startAngle;
+    if (sweep > M_PI)
+        sweep -= 2 * M_PI;
+    else if (sweep < -M_PI)
+        sweep += 2 * M_PI;
+
+    // Length of the spiral (approx) to split into blocks
+    float avgRadius = (startRadius + destRadius) / 2;
+    float polarLen = sqrtf(sweep * sweep * avgRadius * avgRadius +
+                           (destRadius - startRadius) * (destRadius - startRadius));
+    numBlocks = std::max(numBlocks, int(polarLen / _blockDistanceMM));
+
+    _blocksToAddPolarStartAngle = startAngle;
+    _blocksToAddPolarSweep = sweep;
+    _blocksToAddPolarStartRadius = startRadius;
+    _blocksToAddPolarDeltaRadius = (destRadius - startRadius) / numBlocks;
+    _blocksToAddPolarSin = sinf(startAngle);
+    _blocksToAddPolarCos = cosf(startAngle);
+    _blocksToAddPolarStepSin = sinf(sweep / numBlocks);
+    _blocksToAddPolarStepCos = cosf(sweep / numBlocks);
+    _blocksToAddIsPolar = true;
+    return numBlocks;
+}
+
+// Set up an arc in the XY plane from the current position to the destination and return the
+// number of chords needed to keep within the arc tolerance (0 if the arc is invalid)
+int MotionHelper::setupArc(RobotCommandArgs &args, AxisFloats &destPos)
+{
+    float startX = queuedEndPosMM().getVal(0);
+    float startY = queuedEndPosMM().getVal(1);
+    float deltaX = destPos.getVal(0) - startX;
+    float deltaY = destPos.getVal(1) - startY;
+    float centreOffsetX = args.getArcCentreOffset(0);
+    float centreOffsetY = args.getArcCentreOffset(1);
+
+    // Radius form - the centre is on the perpendicular bisector of the chord (as GRBL)
+    if (args.isArcRadiusValid())
+    {
+        float radius = args.getArcRadius();
+        float chordLenSq = deltaX * deltaX + deltaY * deltaY;
+        float hSq = 4 * radius * radius - chordLenSq;
+        // The chord can be longer than the diameter by the tolerance (hSq is then about -4 * r * excess)
+        if ((chordLenSq == 0) || (hSq < -4 * fabsf(radius) * _arcToleranceMM))
+        {
+            Log.warning("%sarc radius %F invalid for end point\n", MODULE_PREFIX, radius);
+            return 0;
+        }
+        float hDivChord = -sqrtf(fmaxf(hSq, 0)) / sqrtf(chordLenSq);
+        if (!args.isArcClockwise())
+            hDivChord = -hDivChord;
+        if (radius < 0)
+            hDivChord = -hDivChord;
+        centreOffsetX = 0.5f * (deltaX - deltaY * hDivChord);
+        centreOffsetY = 0.5f * (deltaY + deltaX * hDivChord);
+    }
+
+    // Centre, radius and angles
+    _blocksToAddArcCentreX = startX + centreOffsetX;
+    _blocksToAddArcCentreY = startY + centreOffsetY;
+    _blocksToAddArcRadius = sqrtf(centreOffsetX * centreOffsetX + centreOffsetY * centreOffsetY);
+    if (_blocksToAddArcRadius < MotionBlock::MINIMUM_MOVE_DIST_MM)
+    {
+        Log.warning("%sarc centre not specified\n", MODULE_PREFIX);
+        return 0;
+    }
+    _blocksToAddArcStartAngle = atan2f(startY - _blocksToAddArcCentreY, startX - _blocksToAddArcCentreX);
+    float endAngle = atan2f(destPos.getVal(1) - _blocksToAddArcCentreY, destPos.getVal(0) - _blocksToAddArcCentreX);
+
+    // Angle swept - an arc which ends where it starts is a full circle
+    static constexpr float ARC_ANGLE_EPSILON = 5e-7f;
+    _blocksToAddArcSweep = endAngle - _blocksToAddArcStartAngle;
+    if (args.isArcClockwise())
+    {
+        if (_blocksToAddArcSweep >= -ARC_ANGLE_EPSILON)
+            _blocksToAddArcSweep -= 2 * M_PI;
+    }
+    else
+    {
+        if (_blocksToAddArcSweep <= ARC_ANGLE_EPSILON)
+            _blocksToAddArcSweep += 2 * M_PI;
+    }
+
+    // Chords are no further than the tolerance from the arc and no longer than the block distance
+    float chordAngle = arcMaxChordAngleRads;
+    if (_arcToleranceMM < _blocksToAddArcRadius)
+        chordAngle = fminf(chordAngle, 2 * acosf(1 - _arcToleranceMM / _blocksToAddArcRadius));
+    int numBlocks = int(ceilf(fabsf(_blocksToAddArcSweep) / chordAngle));
+    if (_blockDistanceMM > 0.01f)
+        numBlocks = std::max(numBlocks, int(fabsf(_blocksToAddArcSweep) * _blocksToAddArcRadius / _blockDistanceMM));
+    numBlocks = std::max(numBlocks, 1);
+    _blocksToAddIsArc = true;
+    return numBlocks;
+}
+
+// Add a movement to the pipeline - through the path simplifier if enabled
 bool MotionHelper::addToPlanner(RobotCommandArgs &args)
+{
+    if (!_pathSimplifier.isEnabled())
+        return planMove(args);
+
+    // Merge with the held block if possible
+    if (_pathSimplifier.merge(_curAxisPosition._axisPositionMM, args))
+        return true;
+
+    // Otherwise release the held block (cutting the corner to this one if blending) and hold this one
+    if (_pathSimplifier.isHeld())
+    {
+        AxisFloats blendStartPt, blendEndPt;
+        if ((_motionPipeline.slotsFree() >= 2) &&
+                _pathSimplifier.getBlend(_curAxisPosition._axisPositionMM, args.getPointMM(), blendStartPt, blendEndPt))
+        {
+            RobotCommandArgs heldArgs = _pathSimplifier.getHeld();
+            heldArgs.setMoreMovesComing(true);
+            heldArgs.setPointMM(blendStartPt);
+            planMove(heldArgs);
+            heldArgs.setPointMM(blendEndPt);
+            planMove(heldArgs);
+            _pathSimplifier.clear();
+        }
+        else
+        {
+            releaseHeldBlock(true);
+        }
+    }
+    _pathSimplifier.hold(args);
+    return true;
+}
+
+// Release the block held by the path simplifier to the planner
+void MotionHelper::releaseHeldBlock(bool moreMovesComing)
+{
+    if (!_pathSimplifier.isHeld())
+        return;
+    RobotCommandArgs heldArgs = _pathSimplifier.getHeld();
+    if (moreMovesComing)
+        heldArgs.setMoreMovesComing(true);
+    _pathSimplifier.clear();
+    planMove(heldArgs);
+}
+
+// Add a movement to the pipeline using the planner which computes suitable motion
+bool MotionHelper::planMove(RobotCommandArgs &args)
 {
     // Convert the move to actuator coordinates
     AxisFloats actuatorCoords;
     bool moveOk = false;
-    if (_ptToActuatorFn)
+    bool allowOutOfBounds = args.getAllowOutOfBounds() || _allowAllOutOfBounds;
+    int batchIdx = _ptToActuatorFromBatchFn ? _kinematicsBatch.find(args.getPointMM()) : -1;
+    if (batchIdx >= 0)
+        moveOk = _ptToActuatorFromBatchFn(_kinematicsBatch, batchIdx, args.getPointMM(), actuatorCoords,
+                    _curAxisPosition, _axesParams, allowOutOfBounds);
+    else if (_ptToActuatorFn)
         moveOk = _ptToActuatorFn(args.getPointMM(), actuatorCoords, _curAxisPosition, _axesParams,
-                    args.getAllowOutOfBounds() || _allowAllOutOfBounds);
+                    allowOutOfBounds);
 
     // Plan the move
     if (moveOk)
@@ -302,6 +679,9 @@ bool MotionHelper::addToPlanner(RobotCommandArgs &args)
     }
     if (moveOk)
     {
+        // Extent of the move for a dry run
+        if (_pMotionDryRun)
+            _pMotionDryRun->addMove(_curAxisPosition._axisPositionMM, args.getPointMM());
         // Update axisMotion
         _curAxisPosition._axisPositionMM = args.getPointMM();
         // Correct overflows
@@ -323,12 +703,33 @@ bool MotionHelper::addToPlanner(RobotCommandArgs &args)
 void MotionHelper::service()
 {
     // Call process on motion actuator - only really used for testing as
-    // motion is handled by ISR
-    _motionActuator.process();
+    // motion is handled by ISR - for a dry run each service executes a segment
+    if (_pMotionActuator)
+        _pMotionActuator->process();
+    else
+        _pMotionDryRun->service(_motionPipeline);
 
     // Process any split-up blocks to be added to the pipeline
     blocksToAddProcess();
 
+    // Release a held block if nothing has followed it in time or the pipeline is running low
+    if (_pathSimplifier.isHeld() && (_blocksToAddTotal == 0) && _motionPipeline.canAccept() &&
+                ((_motionPipeline.count() < PATH_HOLD_MIN_PIPELINE_BLOCKS) || _pathSimplifier.isHeldTooLong()))
+        releaseHeldBlock(false);
+
+    // Reset of the statistics (requested from any task) - the ISR resets its own when it next runs
+    if (_motionStatsResetRequested.exchange(false))
+    {
+        if (_pMotionActuator)
+            _pMotionActuator->resetMotionStats();
+        _pipelineStats.clear();
+        _motionPlanner.resetPlannerStats();
+        _pathSimplifier.clearStats();
+    }
+
+    // Pipeline depth history
+    _pipelineStats.service(_motionPipeline.count());
+
     // Service MotionIO
     if (_motionPipeline.count() > 0)
         _motionIO.motionIsActive();
@@ -338,6 +739,32 @@ void MotionHelper::service()
     _motionHoming.service(_axesParams);
     if (_motionHoming.isHomingInProgress())
         _motionIO.motionIsActive();
+
+    // Keep the steps executed in range on robots which rotate continuously
+    correctStepsExecuted();
+}
+
+// Robots with continuous rotation keep their position in steps within a rotation (see correctStepOverflow)
+// but the steps executed by the ISR keep counting - they are corrected in the same way before they can overflow
+void MotionHelper::correctStepsExecuted()
+{
+    if (!_pMotionActuator || !_correctStepOverflowFn)
+        return;
+    AxisPosition stepsPos;
+    _pMotionActuator->getStepsExecuted(stepsPos._stepsFromHome);
+    bool needsCorrecting = false;
+    for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
+        if (abs(stepsPos._stepsFromHome.getVal(axisIdx)) > STEPS_EXECUTED_CORRECT_ABOVE)
+            needsCorrecting = true;
+    if (!needsCorrecting)
+        return;
+    AxisInt32s stepsBefore = stepsPos._stepsFromHome;
+    AxesParams axesParams = _axesParams;
+    _correctStepOverflowFn(stepsPos, axesParams);
+    AxisInt32s adjust;
+    for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
+        adjust.setVal(axisIdx, stepsPos._stepsFromHome.getVal(axisIdx) - stepsBefore.getVal(axisIdx));
+    _pMotionActuator->adjustStepsExecuted(adjust);
 }
 
 // Set home coordinates
@@ -347,17 +774,50 @@ void MotionHelper::setCurPositionAsHome(int axisIdx)
         return;
     _curAxisPosition._axisPositionMM.setVal(axisIdx, _axesParams.getHomeOffsetVal(axisIdx));
     _curAxisPosition._stepsFromHome.setVal(axisIdx, _axesParams.gethomeOffSteps(axisIdx));
+    if (_pMotionActuator)
+        _pMotionActuator->setStepsExecuted(axisIdx, _axesParams.gethomeOffSteps(axisIdx));
 }
 
 // Debug helper methods
 void MotionHelper::debugShowBlocks()
 {
-    _motionPipeline.debugShowBlocks(_axesParams);
+    _motionPipeline.debugShowBlocks();
+}
+
+void MotionHelper::getMotionStats(String& statsStr)
+{
+    String actuatorStatsStr;
+    if (_pMotionActuator)
+    {
+        _pMotionActuator->getMotionStats(actuatorStatsStr);
+    }
+    else
+    {
+        MotionDryRunResult dryRunResult;
+        _pMotionDryRun->getResult(dryRunResult);
+        actuatorStatsStr = "\"dryRun\":" + dryRunResult.toJSON();
+    }
+    statsStr = "{" + actuatorStatsStr + ",\"pipe\":" + _pipelineStats.toJSON(true) +
+                ",\"plan\":" + _motionPlanner.getPlannerStatsJSON() + ",\"path\":" + _pathSimplifier.toJSON() + "}";
+}
+
+void MotionHelper::getDryRunResult(MotionDryRunResult &result)
+{
+    result.clear();
+    if (_pMotionDryRun)
+        _pMotionDryRun->getResult(result);
+}
+
+void MotionHelper::resetMotionStats()
+{
+    _motionStatsResetRequested = true;
 }
 
 String MotionHelper::getDebugStr()
 {
-    return _motionActuator.getDebugStr();
+    if (!_pMotionActuator)
+        return "";
+    return _pMotionActuator->getDebugStr();
 }
 
 int MotionHelper::testGetPipelineCount()
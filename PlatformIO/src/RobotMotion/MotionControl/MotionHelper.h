@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <atomic>
 #include "../AxesParams.h"
 #include "../AxisPosition.h"
 #include "RobotCommandArgs.h"
@@ -10,6 +11,9 @@
 #include "MotionIO.h"
 #include "MotionActuator.h"
 #include "MotionHoming.h"
+#include "MotionPathSimplifier.h"
+#include "MotionDryRun.h"
+#include "KinematicsBatch.h"
 
 class MotionHelper
 {
@@ -17,13 +21,35 @@ public:
     static constexpr float blockDistanceMM_default = 0.0f;
     static constexpr float junctionDeviation_default = 0.05f;
     static constexpr float distToTravelMM_ignoreBelow = 0.01f;
-    static constexpr int pipelineLen_default = 100;
+    // Each block in the pipeline takes 48 bytes (execution record and planner record)
+    static constexpr int pipelineLen_default = 150;
+    static constexpr const char *rampType_default = "perMS";
+    static constexpr int stepOversampling_default = 0;
+    static constexpr int jointSpacePlanning_default = 0;
+    // Blocks are started (and their speeds fixed) when the ISR will reach them within this time (0 = as soon as possible)
+    static constexpr int blockCommitMs_default = 20;
+    // Max distance of arc chords from the true arc
+    static constexpr float arcToleranceMM_default = 0.01f;
+    static constexpr float arcToleranceMM_min = 0.001f;
+    // Max angle swept by a single arc chord
+    static constexpr float arcMaxChordAngleRads = M_PI / 4;
+    // Path simplification (0 = off) - max deviation of merged blocks and of blended corners
+    static constexpr float pathMergeTolMM_default = 0.0f;
+    static constexpr float pathBlendTolMM_default = 0.0f;
+    // Polynomial trig approximations in the kinematics (robots that support it - see FastTrig)
+    static constexpr int fastKinematics_default = 0;
+    // Blocks are not held by the path simplifier when the pipeline is running lower than this
+    static constexpr unsigned int PATH_HOLD_MIN_PIPELINE_BLOCKS = 2;
+    // Steps executed are brought back into range (see correctStepOverflow) when any axis is beyond this
+    static constexpr int32_t STEPS_EXECUTED_CORRECT_ABOVE = 1 << 30;
 
 private:
     // Pause
     bool _isPaused;
     // Block distance
     float _blockDistanceMM;
+    // Arc tolerance
+    float _arcToleranceMM;
     // Allow all out of bounds movement
     bool _allowAllOutOfBounds;
     // Axes parameters
@@ -36,6 +62,10 @@ private:
     correctStepOverflowFnType _correctStepOverflowFn;
     convertCoordsFnType _convertCoordsFn;
     setRobotAttributesFnType _setRobotAttributes;
+    // Optional callbacks converting the points of split-up moves in batches
+    ptsToActuatorBatchFnType _ptsToActuatorBatchFn;
+    ptToActuatorFromBatchFnType _ptToActuatorFromBatchFn;
+    KinematicsBatch _kinematicsBatch;
     // Relative motion
     bool _moveRelative;
     // Planner used to plan the pipeline of motion
@@ -44,10 +74,18 @@ private:
     AxisPosition _curAxisPosition;
     // Motion pipeline
     MotionPipeline _motionPipeline;
+    // Path simplification in front of the planner
+    MotionPathSimplifier _pathSimplifier;
+    // Pipeline underrun telemetry
+    MotionPipelineStats _pipelineStats;
+    // Reset of the statistics requested (from any task) - done in service()
+    std::atomic<bool> _motionStatsResetRequested;
     // Motion IO (Motors and end-stops)
     MotionIO _motionIO;
-    // Actuators (motors etc)
-    MotionActuator _motionActuator;
+    // Actuators (motors etc) - or for a dry run the pipeline is consumed against a simulated
+    // clock and the motion IO isn't used (only one of these is created)
+    MotionActuator *_pMotionActuator;
+    MotionDryRun *_pMotionDryRun;
     // Homing
     MotionHoming _motionHoming;
 
@@ -64,17 +102,40 @@ private:
     AxisFloats _blocksToAddDelta;
     // Command args for block generation
     RobotCommandArgs _blocksToAddCommandArgs;
+    // Arc (in XY plane) being split into chords - other axes move linearly
+    bool _blocksToAddIsArc;
+    float _blocksToAddArcCentreX;
+    float _blocksToAddArcCentreY;
+    float _blocksToAddArcRadius;
+    float _blocksToAddArcStartAngle;
+    float _blocksToAddArcSweep;
+    // Theta-rho move (in XY plane) split in polar coords - other axes move linearly
+    // Angles are clockwise from North (x = r * sin(angle), y = r * cos(angle)) and the unit vector of
+    // each point is found by rotating the previous one
+    bool _blocksToAddIsPolar;
+    float _blocksToAddPolarStartAngle;
+    float _blocksToAddPolarSweep;
+    float _blocksToAddPolarStartRadius;
+    float _blocksToAddPolarDeltaRadius;
+    float _blocksToAddPolarSin;
+    float _blocksToAddPolarCos;
+    float _blocksToAddPolarStepSin;
+    float _blocksToAddPolarStepCos;
+    // Block after the last one in the kinematics batch
+    int _blocksToAddBatchEnd;
 
     // Debug
     unsigned long _debugLastPosDispMs;
 
 public:
-    MotionHelper();
+    MotionHelper(bool isDryRun = false);
     ~MotionHelper();
 
     void setTransforms(ptToActuatorFnType ptToActuatorFn, actuatorToPtFnType actuatorToPtFn,
                        correctStepOverflowFnType correctStepOverflowFn,
                        convertCoordsFnType convertCoordsFn, setRobotAttributesFnType setRobotAttributes);
+    void setBatchTransforms(ptsToActuatorBatchFnType ptsToActuatorBatchFn,
+                       ptToActuatorFromBatchFnType ptToActuatorFromBatchFn);
 
     void configure(const char *robotConfigJSON);
 
@@ -119,11 +180,18 @@ public:
     bool moveTo(RobotCommandArgs &args);
     void setMotionParams(RobotCommandArgs &args);
     void getCurStatus(RobotCommandArgs &args);
+    void getLivePosition(AxisPosition &livePos);
+    void getPlannedPosition(AxisPosition &plannedPos)
+    {
+        plannedPos = _curAxisPosition;
+    }
     void getRobotAttributes(String& robotAttrs);
     void goHome(RobotCommandArgs &args);
     int getLastCompletedNumberedCmdIdx()
     {
-        return _motionActuator.getLastCompletedNumberedCmdIdx();
+        if (!_pMotionActuator)
+            return RobotConsts::NUMBERED_COMMAND_NONE;
+        return _pMotionActuator->getLastCompletedNumberedCmdIdx();
     }
     void service();
 
@@ -132,6 +200,26 @@ public:
         return _motionIO.getLastActiveUnixTime();
     }
 
+    // Dry run
+    bool isDryRun()
+    {
+        return _pMotionDryRun != NULL;
+    }
+    void getDryRunResult(MotionDryRunResult &result);
+
+    // Motion ISR timing and pipeline statistics - resetMotionStats can be called from any task
+    void getMotionStats(String& statsStr);
+    void resetMotionStats();
+    // Pipeline telemetry summary, and the depth history as CSV
+    String getPipelineStatsJSON()
+    {
+        return _pipelineStats.toJSON(false);
+    }
+    String getPipelineStatsCSV()
+    {
+        return _pipelineStats.toCSV();
+    }
+
     // Test code
     void debugShowBlocks();
     void debugShowTiming();
@@ -140,7 +228,8 @@ public:
     bool testGetPipelineBlock(int elIdx, MotionBlock &elem);
     void setIntrumentationMode(const char *testModeStr)
     {
-        _motionActuator.setInstrumentationMode(testModeStr);
+        if (_pMotionActuator)
+            _pMotionActuator->setInstrumentationMode(testModeStr);
     }
 
 private:
@@ -150,5 +239,20 @@ private:
     }
 
     bool addToPlanner(RobotCommandArgs &args);
+    bool planMove(RobotCommandArgs &args);
+    void releaseHeldBlock(bool moreMovesComing);
     void blocksToAddProcess();
+    void blocksToAddGetPoint(int blockIdx, AxisFloats &pt);
+    void blocksToAddFillBatch();
+    void correctStepsExecuted();
+
+    // End of the last block queued (including a block held by the path simplifier)
+    AxisFloats &queuedEndPosMM()
+    {
+        if (_pathSimplifier.isHeld())
+            return _pathSimplifier.getHeld().getPointMM();
+        return _curAxisPosition._axisPositionMM;
+    }
+    int setupArc(RobotCommandArgs &args, AxisFloats &destPos);
+    int setupPolar(AxisFloats &startPos, AxisFloats &destPos, int numBlocks);
 };
@@ -0,0 +1,193 @@
+// RBotFirmware
+// Rob Dobson 2016-2018
+
+#pragma once
+
+#include <Arduino.h>
+#include <algorithm>
+#include "xtensa/core-macros.h"
+
+// ISR timing statistics from the CPU cycle counter (CCOUNT) - these are always collected as the
+// overhead is a few cycles per ISR call - define NO_MOTION_ISR_STATS in the build flags to remove them
+#ifndef NO_MOTION_ISR_STATS
+#define USE_MOTION_ISR_STATS 1
+#endif
+
+// Histogram of times in CPU cycles with fixed width bins (the last bin holds everything above)
+class MotionISRHistogram
+{
+public:
+    static constexpr int NUM_BINS = 64;
+
+private:
+    uint32_t _binShift;
+    uint32_t _bins[NUM_BINS];
+    uint32_t _count;
+    uint32_t _min;
+    uint32_t _max;
+    uint64_t _sum;
+
+public:
+    MotionISRHistogram(uint32_t binShift)
+    {
+        _binShift = binShift;
+        clear();
+    }
+
+    void clear()
+    {
+        for (int i = 0; i < NUM_BINS; i++)
+            _bins[i] = 0;
+        _count = 0;
+        _min = UINT32_MAX;
+        _max = 0;
+        _sum = 0;
+    }
+
+    void IRAM_ATTR record(uint32_t cycles)
+    {
+        uint32_t binIdx = cycles >> _binShift;
+        _bins[binIdx < NUM_BINS ? binIdx : NUM_BINS - 1]++;
+        _count++;
+        _sum += cycles;
+        if (_min > cycles)
+            _min = cycles;
+        if (_max < cycles)
+            _max = cycles;
+    }
+
+    uint32_t count()
+    {
+        return _count;
+    }
+
+    // Value below which the given percentage of samples fall (upper edge of the bin)
+    uint32_t percentile(uint32_t percent)
+    {
+        if (_count == 0)
+            return 0;
+        uint64_t target = (uint64_t(_count) * percent + 99) / 100;
+        uint64_t cumulative = 0;
+        for (int i = 0; i < NUM_BINS - 1; i++)
+        {
+            cumulative += _bins[i];
+            if (cumulative >= target)
+                return std::min((uint32_t)((i + 1) << _binShift), _max);
+        }
+        return _max;
+    }
+
+    // Min, p50, p99, max and average in microseconds
+    String toJSON(uint32_t cyclesPerUs)
+    {
+        if (_count == 0)
+            return "{\"n\":0}";
+        float usPerCycle = 1.0f / cyclesPerUs;
+        String jsonStr = "{\"n\":" + String(_count);
+        jsonStr += ",\"min\":" + String(_min * usPerCycle, 2);
+        jsonStr += ",\"p50\":" + String(percentile(50) * usPerCycle, 2);
+        jsonStr += ",\"p99\":" + String(percentile(99) * usPerCycle, 2);
+        jsonStr += ",\"max\":" + String(_max * usPerCycle, 2);
+        jsonStr += ",\"avg\":" + String((float)(_sum / _count) * usPerCycle, 2);
+        jsonStr += "}";
+        return jsonStr;
+    }
+};
+
+class MotionISRStats
+{
+public:
+#ifdef F_CPU
+    static constexpr uint32_t CPU_CYCLES_PER_US = F_CPU / 1000000;
+#else
+    static constexpr uint32_t CPU_CYCLES_PER_US = 240;
+#endif
+    // Bins are 2^5 cycles wide (133ns at 240MHz) so the histograms cover ~8.5us
+    static constexpr uint32_t HISTOGRAM_BIN_SHIFT = 5;
+
+private:
+    MotionISRHistogram _durationHist;
+    MotionISRHistogram _jitterHist;
+    // CCOUNT at ISR entry and when the ISR is expected to be entered (valid if _expectedEntryValid)
+    uint32_t _entryCycles;
+    uint32_t _expectedEntryCycles;
+    bool _expectedEntryValid;
+    // ISR entries earlier than expected (counted rather than put in the histogram)
+    uint32_t _earlyEntryCount;
+    // Reset is done by the ISR to avoid clearing the stats while it is updating them
+    volatile bool _resetRequested;
+
+public:
+    MotionISRStats() : _durationHist(HISTOGRAM_BIN_SHIFT), _jitterHist(HISTOGRAM_BIN_SHIFT)
+    {
+        _resetRequested = false;
+        clear();
+    }
+
+    void clear()
+    {
+        _durationHist.clear();
+        _jitterHist.clear();
+        _entryCycles = 0;
+        _expectedEntryCycles = 0;
+        _expectedEntryValid = false;
+        _earlyEntryCount = 0;
+    }
+
+    // Request a reset (from any task)
+    void reset()
+    {
+        _resetRequested = true;
+    }
+
+    // Set when the ISR should next be entered as a number of CPU cycles from now
+    void IRAM_ATTR setExpectedEntry(uint32_t cyclesFromNow)
+    {
+        _expectedEntryCycles = XTHAL_GET_CCOUNT() + cyclesFromNow;
+        _expectedEntryValid = true;
+    }
+
+    void IRAM_ATTR isrEntry()
+    {
+        if (_resetRequested)
+        {
+            clear();
+            _resetRequested = false;
+        }
+        _entryCycles = XTHAL_GET_CCOUNT();
+        if (_expectedEntryValid)
+        {
+            int32_t lateCycles = (int32_t)(_entryCycles - _expectedEntryCycles);
+            if (lateCycles < 0)
+                _earlyEntryCount++;
+            else
+                _jitterHist.record(lateCycles);
+            _expectedEntryValid = false;
+        }
+    }
+
+    // Expect the next entry a fixed number of cycles after this one (periodic timer)
+    void IRAM_ATTR setExpectedEntryAfterThis(uint32_t cyclesAfterEntry)
+    {
+        _expectedEntryCycles = _entryCycles + cyclesAfterEntry;
+        _expectedEntryValid = true;
+    }
+
+    void IRAM_ATTR isrExit()
+    {
+        _durationHist.record(XTHAL_GET_CCOUNT() - _entryCycles);
+    }
+
+    String toJSON(bool includeBraces = true)
+    {
+        String jsonStr;
+        if (includeBraces)
+            jsonStr = "{";
+        jsonStr += "\"isrUs\":" + _durationHist.toJSON(CPU_CYCLES_PER_US);
+        jsonStr += ",\"jitterUs\":" + _jitterHist.toJSON(CPU_CYCLES_PER_US);
+        jsonStr += ",\"early\":" + String(_earlyEntryCount);
+        if (includeBraces)
+            jsonStr += "}";
+        return jsonStr;
+    }
+};
@@ -35,16 +35,16 @@ static constexpr int INSTRUMENT_OUTPUT_STEPS = 1000;
 #define INSTRUMENT_MOTION_ACTUATOR_STEP_END \
     if (_pMotionInstrumentation)         \
         _pMotionInstrumentation->stepEnd();
-#define INSTRUMENT_MOTION_ACTUATOR_STEP_DIRN \
+#define INSTRUMENT_MOTION_ACTUATOR_STEP_DIRN(AX_IDX, DIRN_LEVELS) \
     if (_pMotionInstrumentation)          \
-        _pMotionInstrumentation->stepDirn(axisIdx, stepsTotal >= 0);
+        _pMotionInstrumentation->stepDirn(AX_IDX, (DIRN_LEVELS >> AX_IDX) & 0x01);
 #define INSTRUMENT_MOTION_ACTUATOR_STEP_START(AX_IDX) \
     if (_pMotionInstrumentation)                   \
         _pMotionInstrumentation->stepStart(AX_IDX);
 #else
 #define INSTRUMENT_MOTION_ACTUATOR_PROCESS
 #define INSTRUMENT_MOTION_ACTUATOR_STEP_END
-#define INSTRUMENT_MOTION_ACTUATOR_STEP_DIRN
+#define INSTRUMENT_MOTION_ACTUATOR_STEP_DIRN(AX_IDX, DIRN_LEVELS)
 #define INSTRUMENT_MOTION_ACTUATOR_STEP_START(AX_IDX)
 #endif
 
@@ -0,0 +1,200 @@
+// RBotFirmware
+// Rob Dobson 2016-2018
+
+#pragma once
+
+#include <Arduino.h>
+#include "RobotCommandArgs.h"
+#include "Utils.h"
+
+// Path simplification in front of the planner - the most recent block is held back so that
+// following blocks which are collinear with it (within a tolerance) can be merged into it and
+// corners between blocks can be blended (in the style of G64 P) by cutting them with a short block
+class MotionPathSimplifier
+{
+public:
+    // Max points merged into a single block
+    static constexpr int MAX_MERGED_PTS = 16;
+    // Max time a block is held waiting for a following block
+    static constexpr uint32_t HOLD_MAX_MS = 50;
+    // Corners turning less than this (sine of half the turn angle - approx 11 degrees) are not
+    // blended as the planner's junction deviation handles them well enough
+    static constexpr float BLEND_MIN_SIN_HALF_TURN = 0.1f;
+
+private:
+    // Max distance of merged points from the merged block (0 = no merging)
+    float _mergeTolMM;
+    // Max distance of a blended corner from the original corner (0 = no blending)
+    float _blendTolMM;
+    // Max length of a merged block (0 = no max)
+    float _maxBlockLenMM;
+
+    // Held block and the points merged into it
+    bool _isHeld;
+    RobotCommandArgs _heldArgs;
+    unsigned long _heldMs;
+    AxisFloats _mergedPts[MAX_MERGED_PTS];
+    int _mergedPtsCount;
+
+    // Stats
+    uint32_t _mergedCount;
+    uint32_t _blendedCount;
+
+public:
+    MotionPathSimplifier()
+    {
+        _mergeTolMM = 0;
+        _blendTolMM = 0;
+        _maxBlockLenMM = 0;
+        clear();
+        clearStats();
+    }
+
+    void configure(float mergeTolMM, float blendTolMM, float maxBlockLenMM)
+    {
+        _mergeTolMM = mergeTolMM;
+        _blendTolMM = blendTolMM;
+        _maxBlockLenMM = maxBlockLenMM;
+        clear();
+    }
+
+    bool isEnabled()
+    {
+        return (_mergeTolMM > 0) || (_blendTolMM > 0);
+    }
+
+    void clear()
+    {
+        _isHeld = false;
+        _heldMs = 0;
+        _mergedPtsCount = 0;
+    }
+
+    void clearStats()
+    {
+        _mergedCount = 0;
+        _blendedCount = 0;
+    }
+
+    // Held block
+    bool isHeld()
+    {
+        return _isHeld;
+    }
+    RobotCommandArgs &getHeld()
+    {
+        return _heldArgs;
+    }
+    bool isHeldTooLong()
+    {
+        return _isHeld && Utils::isTimeout(millis(), _heldMs, HOLD_MAX_MS);
+    }
+    void hold(RobotCommandArgs &args)
+    {
+        _heldArgs = args;
+        _heldMs = millis();
+        _isHeld = true;
+        _mergedPtsCount = 0;
+    }
+
+    // Merge a block (starting at the end of the held block) into the held block if the held
+    // block's end point and the points already merged stay within tolerance of the merged block
+    bool merge(AxisFloats &startPt, RobotCommandArgs &args)
+    {
+        if (!_isHeld || (_mergeTolMM <= 0) || (_mergedPtsCount >= MAX_MERGED_PTS))
+            return false;
+
+        // Blocks must move in the same way and the held block must not be tracked or check end-stops
+        if ((args.isFeedrateValid() != _heldArgs.isFeedrateValid()) ||
+                (args.isFeedrateValid() && (args.getFeedrate() != _heldArgs.getFeedrate())) ||
+                (_heldArgs.getNumberedCommandIndex() != RobotConsts::NUMBERED_COMMAND_NONE) ||
+                _heldArgs.getEndstopCheck().any() || args.getEndstopCheck().any())
+            return false;
+
+        // The block must continue forwards and not make the merged block too long
+        AxisFloats &heldPt = _heldArgs.getPointMM();
+        AxisFloats &endPt = args.getPointMM();
+        if (dot(startPt, heldPt, heldPt, endPt) <= 0)
+            return false;
+        if ((_maxBlockLenMM > 0) && (dist(startPt, endPt) > _maxBlockLenMM))
+            return false;
+
+        // Check deviation
+        if (distFromLine(heldPt, startPt, endPt) > _mergeTolMM)
+            return false;
+        for (int i = 0; i < _mergedPtsCount; i++)
+            if (distFromLine(_mergedPts[i], startPt, endPt) > _mergeTolMM)
+                return false;
+
+        // Merge
+        _mergedPts[_mergedPtsCount++] = heldPt;
+        _heldArgs = args;
+        _mergedCount++;
+        return true;
+    }
+
+    // Points at which to cut the corner at the end of the held block - the corner is cut at
+    // the distance which keeps the middle of the cut within the blend tolerance of the corner
+    bool getBlend(AxisFloats &startPt, AxisFloats &nextPt, AxisFloats &blendStartPt, AxisFloats &blendEndPt)
+    {
+        if (!_isHeld || (_blendTolMM <= 0) || _heldArgs.getEndstopCheck().any())
+            return false;
+        AxisFloats &cornerPt = _heldArgs.getPointMM();
+        float inLen = dist(startPt, cornerPt);
+        float outLen = dist(cornerPt, nextPt);
+        if ((inLen <= 0) || (outLen <= 0))
+            return false;
+        float cosTurn = dot(startPt, cornerPt, cornerPt, nextPt) / inLen / outLen;
+        float sinHalfTurn = sqrtf(fmaxf(0.5f * (1 - cosTurn), 0));
+        if (sinHalfTurn < BLEND_MIN_SIN_HALF_TURN)
+            return false;
+        float cutDist = fminf(_blendTolMM / sinHalfTurn, 0.5f * fminf(inLen, outLen));
+        blendStartPt = cornerPt;
+        blendEndPt = cornerPt;
+        for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
+        {
+            blendStartPt.setVal(axisIdx, cornerPt.getVal(axisIdx) - (cornerPt.getVal(axisIdx) - startPt.getVal(axisIdx)) * cutDist / inLen);
+            blendEndPt.setVal(axisIdx, cornerPt.getVal(axisIdx) + (nextPt.getVal(axisIdx) - cornerPt.getVal(axisIdx)) * cutDist / outLen);
+        }
+        _blendedCount++;
+        return true;
+    }
+
+    String toJSON()
+    {
+        return "{\"merged\":" + String(_mergedCount) + ",\"blended\":" + String(_blendedCount) + "}";
+    }
+
+private:
+    static float dist(AxisFloats &p1, AxisFloats &p2)
+    {
+        float sumSq = 0;
+        for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
+            sumSq += powf(p2.getVal(axisIdx) - p1.getVal(axisIdx), 2);
+        return sqrtf(sumSq);
+    }
+
+    // Dot product of the vectors p1->p2 and p3->p4
+    static float dot(AxisFloats &p1, AxisFloats &p2, AxisFloats &p3, AxisFloats &p4)
+    {
+        float sum = 0;
+        for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
+            sum += (p2.getVal(axisIdx) - p1.getVal(axisIdx)) * (p4.getVal(axisIdx) - p3.getVal(axisIdx));
+        return sum;
+    }
+
+    // Distance of a point from the line segment between two points
+    static float distFromLine(AxisFloats &pt, AxisFloats &lineStart, AxisFloats &lineEnd)
+    {
+        float lineLenSq = powf(dist(lineStart, lineEnd), 2);
+        float t = (lineLenSq > 0) ? dot(lineStart, pt, lineStart, lineEnd) / lineLenSq : 0;
+        t = fminf(fmaxf(t, 0), 1);
+        float sumSq = 0;
+        for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
+        {
+            float linePtVal = lineStart.getVal(axisIdx) + t * (lineEnd.getVal(axisIdx) - lineStart.getVal(axisIdx));
+            sumSq += powf(pt.getVal(axisIdx) - linePtVal, 2);
+        }
+        return sqrtf(sumSq);
+    }
+};
@@ -7,11 +7,14 @@
 #include "MotionBlock.h"
 #include <vector>
 
+// Blocks are held as two parallel rings - the compact execution records and the planner records
+// which are only used until a block is started
 class MotionPipeline
 {
   private:
     MotionRingBufferPosn _pipelinePosn;
     std::vector<MotionBlock> _pipeline;
+    std::vector<MotionBlockPlan> _pipelinePlans;
 
   public:
     MotionPipeline() : _pipelinePosn(0)
@@ -21,6 +24,7 @@ class MotionPipeline
     void init(int pipelineSize)
     {
         _pipeline.resize(pipelineSize);
+        _pipelinePlans.resize(pipelineSize);
         _pipelinePosn.init(pipelineSize);
     }
 
@@ -35,6 +39,12 @@ class MotionPipeline
         return _pipelinePosn.count();
     }
 
+    // Number of blocks which can be added
+    unsigned int slotsFree()
+    {
+        return (_pipeline.size() > 0) ? _pipeline.size() - 1 - count() : 0;
+    }
+
     // Check if ready to accept data
     bool canAccept()
     {
@@ -42,7 +52,7 @@ class MotionPipeline
     }
 
     // Add to pipeline
-    bool add(MotionBlock &block)
+    bool add(MotionBlock &block, MotionBlockPlan &plan)
     {
         // Check if full
         if (!_pipelinePosn.canPut())
@@ -50,6 +60,7 @@ class MotionPipeline
 
         // Add the item
         _pipeline[_pipelinePosn._putPos] = block;
+        _pipelinePlans[_pipelinePosn._putPos] = plan;
         _pipelinePosn.hasPut();
         return true;
     }
@@ -85,6 +96,18 @@ class MotionPipeline
         return true;
     }
 
+    // Remove the oldest block if it is the one with the sequence number given - so a block finished
+    // by the ISR can't remove another block if the pipeline has been cleared and refilled meanwhile
+    bool IRAM_ATTR removeIfSeq(uint16_t blockSeq)
+    {
+        if (!_pipelinePosn.canGet())
+            return false;
+        if (_pipeline[_pipelinePosn._getPos]._blockSeq != blockSeq)
+            return false;
+        _pipelinePosn.hasGot();
+        return true;
+    }
+
     // Peek the block which would be got (if there is one)
     MotionBlock* IRAM_ATTR peekGet()
     {
@@ -121,8 +144,24 @@ class MotionPipeline
         return &(_pipeline[nthPos]);
     }
 
+    // Planner records - as peekNthFromPut and peekNthFromGet
+    MotionBlockPlan *peekPlanNthFromPut(unsigned int N)
+    {
+        int nthPos = _pipelinePosn.getNthFromPut(N);
+        if (nthPos < 0)
+            return NULL;
+        return &(_pipelinePlans[nthPos]);
+    }
+    MotionBlockPlan *peekPlanNthFromGet(unsigned int N)
+    {
+        int nthPos = _pipelinePosn.getNthFromGet(N);
+        if (nthPos < 0)
+            return NULL;
+        return &(_pipelinePlans[nthPos]);
+    }
+
     // Debug
-    void debugShowBlocks(AxesParams &axesParams)
+    void debugShowBlocks()
     {
         int elIdx = 0;
         bool headShown = false;
@@ -136,7 +175,7 @@ class MotionPipeline
                     pBlock->debugShowBlkHead();
                     headShown = true;
                 }
-                pBlock->debugShowBlock(elIdx++, axesParams);
+                pBlock->debugShowBlock(elIdx++, *peekPlanNthFromPut(i));
             }
         }
     }
@@ -0,0 +1,206 @@
+// RBotFirmware
+// Rob Dobson 2016-2018
+
+#pragma once
+
+#include <Arduino.h>
+#include "Utils.h"
+
+// Telemetry on the motion pipeline running dry - used to tell whether a stutter came from
+// the ISR being starved of segments, the planner being given blocks too late (so it had to
+// plan a stop) or the work manager waiting on a full pipeline
+class MotionPipelineStats
+{
+public:
+    // Pipeline depth is sampled into a ring at this interval
+    static constexpr int DEPTH_RING_LEN = 64;
+    static constexpr uint32_t DEPTH_SAMPLE_MS = 100;
+    // A block arriving after the pipeline ran dry counts as an unplanned stop if the previous
+    // block was added within this time
+    static constexpr uint32_t UNPLANNED_STOP_MAX_GAP_MS = 2000;
+
+    // Count of an event and the time it last happened
+    struct EventCount
+    {
+        uint32_t _count;
+        uint32_t _lastMs;
+
+        void IRAM_ATTR clear()
+        {
+            _count = 0;
+            _lastMs = 0;
+        }
+        void IRAM_ATTR record()
+        {
+            _count++;
+            _lastMs = millis();
+        }
+        String toJSON()
+        {
+            return "{\"n\":" + String(_count) + ",\"ms\":" + String(_lastMs) + "}";
+        }
+    };
+
+    struct DepthSample
+    {
+        uint32_t _ms;
+        uint16_t _depth;
+    };
+
+private:
+    // ISR found no segment to execute while blocks were waiting in the pipeline
+    EventCount _isrUnderrun;
+    // Block entered at zero speed because the pipeline had run dry
+    EventCount _unplannedStop;
+    // Split-up blocks held back as the pipeline was full
+    EventCount _addBlocked;
+    // ISR has been stepping since the pipeline was last empty and is currently in an underrun
+    bool _isrWasStepping;
+    bool _isrInUnderrun;
+    // The ISR's counters are reset by the ISR to avoid clearing them while it is updating them
+    volatile bool _isrResetRequested;
+    // Ring of depth samples
+    DepthSample _depthRing[DEPTH_RING_LEN];
+    unsigned int _depthRingPos;
+    unsigned int _depthRingCount;
+    uint32_t _depthLastSampleMs;
+    uint16_t _depthMin;
+    uint16_t _depthMax;
+
+public:
+    MotionPipelineStats()
+    {
+        _isrResetRequested = false;
+        clearIsrCounters();
+        clear();
+    }
+
+    // Called from the main loop - the ISR's counters are cleared when it next runs
+    void clear()
+    {
+        _isrResetRequested = true;
+        _unplannedStop.clear();
+        _addBlocked.clear();
+        _depthRingPos = 0;
+        _depthRingCount = 0;
+        _depthLastSampleMs = 0;
+        _depthMin = UINT16_MAX;
+        _depthMax = 0;
+    }
+
+    // Called from the ISR when a segment is being executed
+    void IRAM_ATTR isrHasSegment()
+    {
+        if (_isrResetRequested)
+            clearIsrCounters();
+        _isrWasStepping = true;
+        _isrInUnderrun = false;
+    }
+
+    // Called from the ISR when there is no segment to execute - each underrun is only counted once
+    void IRAM_ATTR isrNoSegment(bool pipelineHasBlocks)
+    {
+        if (_isrResetRequested)
+            clearIsrCounters();
+        if (!pipelineHasBlocks)
+        {
+            _isrWasStepping = false;
+            return;
+        }
+        if (_isrWasStepping && !_isrInUnderrun)
+        {
+            _isrInUnderrun = true;
+            _isrUnderrun.record();
+        }
+    }
+
+    void unplannedStop()
+    {
+        _unplannedStop.record();
+    }
+
+    void addBlocked()
+    {
+        _addBlocked.record();
+    }
+
+    // Called regularly from the main loop
+    void service(unsigned int pipelineDepth)
+    {
+        if (!Utils::isTimeout(millis(), _depthLastSampleMs, DEPTH_SAMPLE_MS))
+            return;
+        _depthLastSampleMs = millis();
+        _depthRing[_depthRingPos]._ms = _depthLastSampleMs;
+        _depthRing[_depthRingPos]._depth = pipelineDepth;
+        _depthRingPos = (_depthRingPos + 1) % DEPTH_RING_LEN;
+        if (_depthRingCount < DEPTH_RING_LEN)
+            _depthRingCount++;
+        if (_depthMin > pipelineDepth)
+            _depthMin = pipelineDepth;
+        if (_depthMax < pipelineDepth)
+            _depthMax = pipelineDepth;
+    }
+
+    String toJSON(bool includeDepthRing)
+    {
+        String jsonStr = "{\"underrun\":" + getIsrUnderrun().toJSON();
+        jsonStr += ",\"unplannedStop\":" + _unplannedStop.toJSON();
+        jsonStr += ",\"addBlocked\":" + _addBlocked.toJSON();
+        if (_depthRingCount > 0)
+            jsonStr += ",\"depthMin\":" + String(_depthMin) + ",\"depthMax\":" + String(_depthMax);
+        if (includeDepthRing)
+        {
+            jsonStr += ",\"depth\":[";
+            for (unsigned int i = 0; i < _depthRingCount; i++)
+            {
+                if (i != 0)
+                    jsonStr += ",";
+                jsonStr += String(getDepthSample(i)._depth);
+            }
+            jsonStr += "]";
+        }
+        jsonStr += "}";
+        return jsonStr;
+    }
+
+    // Depth samples (oldest first) followed by the event counters
+    String toCSV()
+    {
+        String csvStr = "ms,depth\n";
+        for (unsigned int i = 0; i < _depthRingCount; i++)
+        {
+            DepthSample& sample = getDepthSample(i);
+            csvStr += String(sample._ms) + "," + String(sample._depth) + "\n";
+        }
+        csvStr += "event,count,lastMs\n";
+        EventCount isrUnderrun = getIsrUnderrun();
+        csvStr += "underrun," + String(isrUnderrun._count) + "," + String(isrUnderrun._lastMs) + "\n";
+        csvStr += "unplannedStop," + String(_unplannedStop._count) + "," + String(_unplannedStop._lastMs) + "\n";
+        csvStr += "addBlocked," + String(_addBlocked._count) + "," + String(_addBlocked._lastMs) + "\n";
+        return csvStr;
+    }
+
+private:
+    void IRAM_ATTR clearIsrCounters()
+    {
+        _isrUnderrun.clear();
+        _isrWasStepping = false;
+        _isrInUnderrun = false;
+        _isrResetRequested = false;
+    }
+
+    // Underruns counted by the ISR (none if a reset is waiting for the ISR to run)
+    EventCount getIsrUnderrun()
+    {
+        EventCount isrUnderrun = _isrUnderrun;
+        if (_isrResetRequested)
+            isrUnderrun.clear();
+        return isrUnderrun;
+    }
+
+    DepthSample& getDepthSample(unsigned int idx)
+    {
+        unsigned int oldestPos = (_depthRingPos + DEPTH_RING_LEN - _depthRingCount) % DEPTH_RING_LEN;
+        return _depthRing[(oldestPos + idx) % DEPTH_RING_LEN];
+    }
+};
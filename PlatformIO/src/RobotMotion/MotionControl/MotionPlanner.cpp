@@ -3,9 +3,145 @@
 
 #include "MotionPlanner.h"
 
-void MotionPlanner::configure(float junctionDeviation)
+void MotionPlanner::configure(float junctionDeviation, bool useSCurve, bool jointSpacePlanning, uint32_t blockCommitMs)
 {
     _junctionDeviation = junctionDeviation;
+    _useSCurve = useSCurve;
+    _jointSpacePlanning = jointSpacePlanning;
+    _blockCommitMs = blockCommitMs;
+}
+
+float MotionPlanner::maxAchievableSpeed(MotionBlockPlan &plan, float velocity)
+{
+    if (_useSCurve && (plan._jerkMMps3 > 0))
+        return MotionBlock::maxAchievableSpeedSCurve(plan._accMMps2, plan._jerkMMps3,
+                                                     velocity, plan._moveDistPrimaryAxesMM);
+    return MotionBlock::maxAchievableSpeed(plan._accMMps2, velocity, plan._moveDistPrimaryAxesMM);
+}
+
+void MotionPlanner::setBlockLimits(MotionBlock &block, MotionBlockPlan &plan, AxesParams &axesParams)
+{
+    // Speeds in the block are those of the axis with most steps (which sets the step rate) and the
+    // other axes move in proportion to it - so each axis limits the block by its own limit scaled by
+    // the ratio of the axis with most steps' travel to its own travel along the block's direction
+    int maxStepsAxisIdx = block._axisIdxWithMaxSteps;
+    float maxStepsAxisDist = block.getAbsStepsToTarget(maxStepsAxisIdx) * axesParams.getStepDistMM(maxStepsAxisIdx);
+    plan._accMMps2 = axesParams.getMaxAccel(maxStepsAxisIdx);
+    plan._jerkMMps3 = axesParams.getMaxJerk(maxStepsAxisIdx);
+    for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
+    {
+        float axisDist = block.getAbsStepsToTarget(axisIdx) * axesParams.getStepDistMM(axisIdx);
+        if ((axisIdx == maxStepsAxisIdx) || (axisDist <= 0) || (maxStepsAxisDist <= 0))
+            continue;
+        float axisScale = maxStepsAxisDist / axisDist;
+        plan._feedrateMMps = fminf(plan._feedrateMMps, axesParams.getMaxSpeed(axisIdx) * axisScale);
+        plan._accMMps2 = fminf(plan._accMMps2, axesParams.getMaxAccel(axisIdx) * axisScale);
+        float axisJerk = axesParams.getMaxJerk(axisIdx);
+        if (axisJerk > 0)
+            plan._jerkMMps3 = (plan._jerkMMps3 > 0) ? fminf(plan._jerkMMps3, axisJerk * axisScale) : axisJerk * axisScale;
+    }
+    plan._feedrateMMps = fminf(plan._feedrateMMps, axesParams.getMaxSpeed(maxStepsAxisIdx));
+}
+
+void MotionPlanner::setJointSpacePlan(MotionBlock &block, MotionBlockPlan &plan, RobotCommandArgs &args,
+                                      float moveDist, AxisFloats &stepDeltas, AxisFloats &unitVectors, AxesParams &axesParams)
+{
+    // Block speeds are those of the axis with most steps so plan over that axis' distance and
+    // convert a requested feedrate (of the tool) into the average speed that axis needs to achieve it
+    int maxStepsAxisIdx = block._axisIdxWithMaxSteps;
+    float maxStepsAxisDist = block.getAbsStepsToTarget(maxStepsAxisIdx) * axesParams.getStepDistMM(maxStepsAxisIdx);
+    plan._feedrateMMps = args.isFeedrateValid() ? args.getFeedrate() * maxStepsAxisDist / moveDist : 1e8;
+    plan._moveDistPrimaryAxesMM = maxStepsAxisDist;
+
+    // Direction of the move in actuator space for the junction calculation - from the unrounded
+    // step deltas as short blocks rounded to whole steps would make each junction look like a turn
+    setActuatorUnitVectors(stepDeltas, unitVectors, axesParams);
+}
+
+void MotionPlanner::setActuatorUnitVectors(AxisFloats &stepDeltas, AxisFloats &unitVectors, AxesParams &axesParams)
+{
+    float squareSum = 0;
+    for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
+        squareSum += powf(stepDeltas.getVal(axisIdx) * axesParams.getStepDistMM(axisIdx), 2);
+    float actuatorDist = sqrtf(squareSum);
+    for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
+        unitVectors._pt[axisIdx] = stepDeltas.getVal(axisIdx) * axesParams.getStepDistMM(axisIdx) / actuatorDist;
+}
+
+// Max speed for the junction between the previous block and a new one to keep the junction
+// deviation within bounds - there are more comments in the Smoothieware (and GRBL) code
+float MotionPlanner::junctionSpeed(MotionBlockPlan &plan, AxisFloats &unitVectors, bool inActuatorSpace)
+{
+    float junctionDeviation = _junctionDeviation;
+    float vmaxJunction = _minimumPlannerSpeedMMps;
+    float prevParamSpeed = _prevMotionBlock._maxParamSpeedMMps;
+    if (junctionDeviation > 0.0f && prevParamSpeed > 0.0f)
+    {
+        // Compute cosine of angle between previous and current path. (prev_unit_vec is negative)
+        // NOTE: Max junction velocity is computed without sin() or acos() by trig half angle identity.
+        float cosTheta = -_prevMotionBlock._unitVectors.X() * unitVectors.X() - _prevMotionBlock._unitVectors.Y() * unitVectors.Y() - _prevMotionBlock._unitVectors.Z() * unitVectors.Z();
+
+        // Skip and use default max junction speed for 0 degree acute junction.
+        if (cosTheta < 0.95F)
+        {
+            vmaxJunction = fminf(prevParamSpeed, plan._feedrateMMps);
+            // Skip and avoid divide by zero for straight junctions at 180 degrees. Limit to min() of nominal speeds.
+            // In actuator space a smooth tool path bends a little at every junction so only nearly straight ones are skipped
+            if (cosTheta > (inActuatorSpace ? -0.9999F : -0.95F))
+            {
+                // Compute maximum junction velocity based on maximum acceleration and junction deviation
+                // (the acceleration is the lower of the two blocks' limits along their directions)
+                // Trig half angle identity, always positive
+                float sinThetaD2 = sqrtf(0.5F * (1.0F - cosTheta));
+                float junctionAccMMps2 = fminf(_prevMotionBlock._accMMps2, plan._accMMps2);
+                vmaxJunction = fminf(vmaxJunction,
+                                        sqrtf(junctionAccMMps2 * junctionDeviation * sinThetaD2 /
+                                            (1.0F - sinThetaD2)));
+            }
+        }
+    }
+    return vmaxJunction;
+}
+
+// Add a planned block to the pipeline and replan the pipeline
+void MotionPlanner::addToPipeline(MotionBlock &block, MotionBlockPlan &plan, float vmaxJunction,
+                                  MotionBlockSequentialData &blockInfo, AxisPosition &curAxisPositions,
+                                  AxesParams &axesParams, MotionPipeline &motionPipeline)
+{
+    // Check if the pipeline has run dry
+    bool pipelineRanDry = !motionPipeline.canGet();
+
+    // If the pipeline ran dry this block starts from rest - record it if the junction would
+    // otherwise have been taken at speed as motion stopped only because the block arrived late
+    if (pipelineRanDry)
+    {
+        if (_pPipelineStats && _prevMotionBlockValid && (vmaxJunction > _minimumPlannerSpeedMMps) &&
+                    !Utils::isTimeout(millis(), _prevMotionBlockAddedMs, MotionPipelineStats::UNPLANNED_STOP_MAX_GAP_MS))
+            _pPipelineStats->unplannedStop();
+        vmaxJunction = _minimumPlannerSpeedMMps;
+    }
+    plan._maxEntrySpeedMMps = vmaxJunction;
+
+#ifdef DEBUG_MOTIONPLANNER_INFO
+    Log.notice("PrevMoveInQueue %d, JunctionDeviation %F, VmaxJunction %F\n",
+                motionPipeline.canGet(), _junctionDeviation, vmaxJunction);
+#endif
+
+    // Add the element to the pipeline and remember previous element
+    motionPipeline.add(block, plan);
+    if (_plannedBlockIdx >= 0)
+        _plannedBlockIdx++;
+    _prevMotionBlock = blockInfo;
+    _prevMotionBlockValid = true;
+    _prevMotionBlockAddedMs = millis();
+
+    // Recalculate the queue back to the planned block
+    recalculatePipeline(motionPipeline, axesParams);
+
+    // Return the change in actuator position
+    for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
+        curAxisPositions._stepsFromHome.setVal(axisIdx,
+                                                curAxisPositions._stepsFromHome.getVal(axisIdx) + block.getStepsToTarget(axisIdx));
 }
 
 // Entry point for adding a motion block
@@ -42,6 +178,7 @@ bool MotionPlanner::moveTo(RobotCommandArgs &args,
 
     // Create a block for this movement which will end up on the pipeline
     MotionBlock block;
+    MotionBlockPlan plan;
 
     // Set flag to indicate if more moves coming
     block._blockIsFollowed = args.getMoreMovesComing();
@@ -78,17 +215,27 @@ bool MotionPlanner::moveTo(RobotCommandArgs &args,
     Log.notice("ValidatedFeedrate %F\n", validFeedrateMMps);
 #endif
 
-    // Store values in the block
-    block._feedrateMMps = float(validFeedrateMMps);
-    block._moveDistPrimaryAxesMM = float(moveDist);
+    // Store values in the block plan
+    plan._feedrateMMps = float(validFeedrateMMps);
+    plan._moveDistPrimaryAxesMM = float(moveDist);
+
+    // The unrounded step deltas (for joint space planning) are taken from the previous block's
+    // destination where that still matches the current position
+    bool deltasFromPrevDest = _prevMotionBlockValid && !_prevMotionBlock._isStepwise;
+    for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
+        if (fabsf(_prevMotionBlock._destActuatorCoords._pt[axisIdx] - curAxisPositions._stepsFromHome.vals[axisIdx]) >= 1)
+            deltasFromPrevDest = false;
 
     // Find if there are any steps
     bool hasSteps = false;
+    AxisFloats stepDeltas;
     for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
     {
         // Check if any steps to perform
         float stepsFloat = destActuatorCoords._pt[axisIdx] - curAxisPositions._stepsFromHome.vals[axisIdx];
-        int32_t steps = int32_t(ceilf(stepsFloat));
+        stepDeltas.setVal(axisIdx, deltasFromPrevDest ?
+                    destActuatorCoords._pt[axisIdx] - _prevMotionBlock._destActuatorCoords._pt[axisIdx] : stepsFloat);
+        int32_t steps = int32_t(roundf(stepsFloat));
         if (steps != 0)
             hasSteps = true;
         // Value (and direction)
@@ -99,65 +246,28 @@ bool MotionPlanner::moveTo(RobotCommandArgs &args,
     if (!hasSteps)
         return false;
 
-    // If there is a prior block then compute the maximum speed at exit of the second block to keep
-    // the junction deviation within bounds - there are more comments in the Smoothieware (and GRBL) code
-    float junctionDeviation = _junctionDeviation;
-    float vmaxJunction = _minimumPlannerSpeedMMps;
-
-    // Invalidate the data stored for the prev element if the pipeline becomes empty
-    if (!motionPipeline.canGet())
-        _prevMotionBlockValid = false;
+    // Junctions and speeds are planned in actuator space if required - the step deltas from the
+    // kinematics then determine cornering speed rather than the direction of the tool
+    if (_jointSpacePlanning)
+        setJointSpacePlan(block, plan, args, moveDist, stepDeltas, unitVectors, axesParams);
 
-    // Calculate the maximum speed for the junction between two blocks
-    if (isAPrimaryMove && _prevMotionBlockValid)
-    {
-        float prevParamSpeed = isAPrimaryMove ? _prevMotionBlock._maxParamSpeedMMps : 0;
-        if (junctionDeviation > 0.0f && prevParamSpeed > 0.0f)
-        {
-            // Compute cosine of angle between previous and current path. (prev_unit_vec is negative)
-            // NOTE: Max junction velocity is computed without sin() or acos() by trig half angle identity.
-            float cosTheta = -_prevMotionBlock._unitVectors.X() * unitVectors.X() - _prevMotionBlock._unitVectors.Y() * unitVectors.Y() - _prevMotionBlock._unitVectors.Z() * unitVectors.Z();
-
-            // Skip and use default max junction speed for 0 degree acute junction.
-            if (cosTheta < 0.95F)
-            {
-                vmaxJunction = fminf(prevParamSpeed, block._feedrateMMps);
-                // Skip and avoid divide by zero for straight junctions at 180 degrees. Limit to min() of nominal speeds.
-                if (cosTheta > -0.95F)
-                {
-                    // Compute maximum junction velocity based on maximum acceleration and junction deviation
-                    // Trig half angle identity, always positive
-                    float sinThetaD2 = sqrtf(0.5F * (1.0F - cosTheta));
-                    vmaxJunction = fminf(vmaxJunction,
-                                            sqrtf(axesParams._masterAxisMaxAccMMps2 * junctionDeviation * sinThetaD2 /
-                                                (1.0F - sinThetaD2)));
-                }
-            }
-        }
-    }
-    block._maxEntrySpeedMMps = vmaxJunction;
-
-#ifdef DEBUG_MOTIONPLANNER_INFO
-    Log.notice("PrevMoveInQueue %d, JunctionDeviation %F, VmaxJunction %F\n",
-                motionPipeline.canGet(), junctionDeviation, vmaxJunction);
-#endif
-
-    // Add the element to the pipeline and remember previous element
-    motionPipeline.add(block);
-    MotionBlockSequentialData prevBlockInfo;
-    prevBlockInfo._maxParamSpeedMMps = block._feedrateMMps;
-    prevBlockInfo._unitVectors = unitVectors;
-    _prevMotionBlock = prevBlockInfo;
-    _prevMotionBlockValid = true;
-
-    // Recalculate the whole queue
-    recalculatePipeline(motionPipeline, axesParams);
-
-    // Return the change in actuator position
-    for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
-        curAxisPositions._stepsFromHome.setVal(axisIdx,
-                                                curAxisPositions._stepsFromHome.getVal(axisIdx) + block.getStepsToTarget(axisIdx));
+    // Limits for the direction of travel
+    setBlockLimits(block, plan, axesParams);
 
+    // If there is a prior block (which isn't stepwise) then compute the maximum speed at the junction
+    float vmaxJunction = _minimumPlannerSpeedMMps;
+    if (isAPrimaryMove && _prevMotionBlockValid && !_prevMotionBlock._isStepwise)
+        vmaxJunction = junctionSpeed(plan, unitVectors, _jointSpacePlanning);
+
+    // Add to the pipeline
+    MotionBlockSequentialData blockInfo;
+    blockInfo._maxParamSpeedMMps = plan._feedrateMMps;
+    blockInfo._unitVectors = unitVectors;
+    blockInfo._destActuatorCoords = destActuatorCoords;
+    blockInfo._accMMps2 = plan._accMMps2;
+    blockInfo._isStepwise = false;
+    blockInfo._checksEndStops = args.getEndstopCheck().any();
+    addToPipeline(block, plan, vmaxJunction, blockInfo, curAxisPositions, axesParams, motionPipeline);
     return true;
 }
 
@@ -167,11 +277,10 @@ void MotionPlanner::debugDumpQueue(const char *comStr, MotionPipeline &motionPip
     if (minQLen != -1 && motionPipeline.count() != minQLen)
         return;
     int curIdx = 0;
-    while (MotionBlock *pCurBlock = motionPipeline.peekNthFromGet(curIdx))
+    while (MotionBlockPlan *pCurPlan = motionPipeline.peekPlanNthFromGet(curIdx))
     {
-        Log.notice("%s #%d En %F Ex %F (maxEntry %F, maxParam %F)\n", comStr, curIdx,
-                    pCurBlock->_entrySpeedMMps, pCurBlock->_exitSpeedMMps,
-                    pCurBlock->_maxEntrySpeedMMps, pCurBlock->_feedrateMMps);
+        Log.notice("%s #%d En %F (maxEntry %F, maxParam %F)\n", comStr, curIdx,
+                    pCurPlan->_entrySpeedMMps, pCurPlan->_maxEntrySpeedMMps, pCurPlan->_feedrateMMps);
         // Next
         curIdx++;
     }
@@ -180,130 +289,142 @@ void MotionPlanner::debugDumpQueue(const char *comStr, MotionPipeline &motionPip
 
 void MotionPlanner::recalculatePipeline(MotionPipeline &motionPipeline, AxesParams &axesParams)
 {
+    // This follows the GRBL planner - blocks are counted back from the most recently added (0) and
+    // only the blocks after the planned block (whose entry speed can't improve) are revisited
     // The last block in the pipe (most recently added) will have zero exit speed
-    // For each block, walking backwards in the queue :
+    // For each block, walking backwards in the queue as far as the planned block :
     //    We know the desired exit speed so calculate the entry speed using v^2 = u^2 + 2*a*s
-    //    Set the exit speed for the previous block from this entry speed
-    // Then walk forward in the queue starting with the first block that can be changed:
-    //    Set the entry speed from the previous block (or to 0 if none)
-    //    Calculate the max possible exit speed for the block using the same formula as above
-    //    Set the entry speed for the next block using this exit speed
-    // Finally prepare the block for stepper motor actuation
+    //    (or the jerk limited equivalent when using S-curve acceleration)
+    //    Blocks already entered at their max entry speed can't go any faster so are left alone
+    // Then walk forward in the queue starting with the planned block:
+    //    Limit the entry speed of the next block to the max possible exit speed of this one
+    //    Move the planned block on when the next block is at its max entry speed or is acceleration limited
+    // The stepping profile is computed from these speeds when a block is started
 
 #ifdef DEBUG_MOTIONPLANNER_INFO
     Log.notice("^^^^^^^^^^^^^^^^^^^^^^^BEFORE RECALC^^^^^^^^^^^^^^^^^^^^^^^^\n");
-    motionPipeline.debugShowBlocks(axesParams);
+    motionPipeline.debugShowBlocks();
 #endif
 
-    // Iterate the block queue in backwards time order stopping at the first block that has its recalculateFlag false
+    unsigned long recalcStartUs = micros();
+
+    // Walk backwards stopping at the planned block, the block after one that is executing (its entry speed
+    // is the exit speed of the executing block) or the oldest block (which is starting from rest)
     int blockIdx = 0;
-    int earliestBlockToReprocess = -1;
-    float previousBlockExitSpeed = 0;
-    float followingBlockEntrySpeed = 0;
-    MotionBlock *pBlock = NULL;
-    MotionBlock *pFollowingBlock = NULL;
+    MotionBlockPlan *pPlan = NULL;
+    MotionBlockPlan *pFollowingPlan = NULL;
     while (true)
     {
         // Get the block at current index
-        pBlock = motionPipeline.peekNthFromPut(blockIdx);
-        if (pBlock == NULL)
+        pPlan = motionPipeline.peekPlanNthFromPut(blockIdx);
+        if (pPlan == NULL)
             break;
 
-        // Stop if we don't need to recalculate beyond here or if this block is already executing
-        if (pBlock->_isExecuting)
+        // Check the block before
+        MotionBlock *pPrecedingBlock = motionPipeline.peekNthFromPut(blockIdx + 1);
+        if (pPrecedingBlock == NULL)
         {
-            // Get the exit speed from this executing block to use as the entry speed when going forwards
-            previousBlockExitSpeed = pBlock->_exitSpeedMMps;
+            pPlan->_entrySpeedMMps = 0;
             break;
         }
-
-        // If entry speed is already at the maximum entry speed then we can stop here as no further changes are
-        // going to be made by going back further
-        if (pBlock->_entrySpeedMMps == pBlock->_maxEntrySpeedMMps && blockIdx > 1)
-        {
-#ifdef DEBUG_MOTIONPLANNER_INFO
-            Log.notice("++++++++++++++++++++++++++++++ Optimizing block %d, prevSpeed %F\n", blockIdx, pBlock->_exitSpeedMMps);
-#endif
-            //Get the exit speed from this block to use as the entry speed when going forwards
-            previousBlockExitSpeed = pBlock->_exitSpeedMMps;
+        if (pPrecedingBlock->_isExecuting || (blockIdx == _plannedBlockIdx))
             break;
-        }
 
-        // If there was a following block (remember we're working backwards) then now set the entry speed
-        if (pFollowingBlock)
+        // Assume for now that that whole block will be deceleration and calculate the max speed we can enter to be able to slow
+        // to the entry speed of the following block (or to rest if there isn't one)
+        if ((pFollowingPlan == NULL) || (pPlan->_entrySpeedMMps != pPlan->_maxEntrySpeedMMps))
         {
-            // Assume for now that that whole block will be deceleration and calculate the max speed we can enter to be able to slow
-            // to the exit speed required
-            float maxEntrySpeed = MotionBlock::maxAchievableSpeed(axesParams._masterAxisMaxAccMMps2,
-                                                                    pFollowingBlock->_exitSpeedMMps, pFollowingBlock->_moveDistPrimaryAxesMM);
-            pFollowingBlock->_entrySpeedMMps = fminf(maxEntrySpeed, pFollowingBlock->_maxEntrySpeedMMps);
-
-            // Remember entry speed (to use as exit speed in the next loop)
-            followingBlockEntrySpeed = pFollowingBlock->_entrySpeedMMps;
+            float maxEntrySpeed = maxAchievableSpeed(*pPlan, pFollowingPlan ? pFollowingPlan->_entrySpeedMMps : 0);
+            pPlan->_entrySpeedMMps = fminf(maxEntrySpeed, pPlan->_maxEntrySpeedMMps);
         }
 
-        // Remember the following block for the next pass
-        pFollowingBlock = pBlock;
-
-        // Set the block's exit speed to the entry speed of the block after this one
-        pBlock->_exitSpeedMMps = followingBlockEntrySpeed;
-
-        // Remember this as the earliest block to reprocess when going forwards
-        earliestBlockToReprocess = blockIdx;
-
         // Next
+        pFollowingPlan = pPlan;
         blockIdx++;
     }
+    int earliestBlockToReprocess = blockIdx;
 
-    // Now iterate in forward time order
-    for (blockIdx = earliestBlockToReprocess; blockIdx >= 0; blockIdx--)
-    {
-        // Get the block to calculate for
-        pBlock = motionPipeline.peekNthFromPut(blockIdx);
-        if (!pBlock)
-            break;
-
-        // Set the entry speed to the previous block exit speed
-        // if (pBlock->_entrySpeedMMps > previousBlockExitSpeed)
-        pBlock->_entrySpeedMMps = previousBlockExitSpeed;
-
-        // Calculate maximum speed possible for the block - based on acceleration at the best rate
-        float maxExitSpeed = pBlock->maxAchievableSpeed(axesParams._masterAxisMaxAccMMps2,
-                                                        pBlock->_entrySpeedMMps, pBlock->_moveDistPrimaryAxesMM);
-        pBlock->_exitSpeedMMps = fminf(maxExitSpeed, pBlock->_exitSpeedMMps);
-
-        // Remember for next block
-        previousBlockExitSpeed = pBlock->_exitSpeedMMps;
-    }
-
-    // Recalculate acceleration and deceleration curves
-    for (blockIdx = earliestBlockToReprocess; blockIdx >= 0; blockIdx--)
+    // Now iterate in forward time order - the block we stopped at is optimally planned as its entry speed is fixed
+    _plannedBlockIdx = earliestBlockToReprocess;
+    for (blockIdx = earliestBlockToReprocess; blockIdx > 0; blockIdx--)
     {
-        // Get the block to calculate for
-        pBlock = motionPipeline.peekNthFromPut(blockIdx);
-        if (!pBlock)
-            break;
-
-        // Prepare this block for stepping
-        if (pBlock->prepareForStepping(axesParams))
+        pPlan = motionPipeline.peekPlanNthFromPut(blockIdx);
+        pFollowingPlan = motionPipeline.peekPlanNthFromPut(blockIdx - 1);
+        if (!pPlan || !pFollowingPlan)
+            continue;
+
+        // If the following block can't be reached by accelerating through this one then it is acceleration
+        // limited and is now optimally planned
+        if (pPlan->_entrySpeedMMps < pFollowingPlan->_entrySpeedMMps)
         {
-            // Check if the block is part of a split block and has at least one more block following it
-            // in which case wait until at least two blocks are in the pipeline before locking down the
-            // first so that acceleration can be allowed to happen more smoothly
-            if ((!pBlock->_blockIsFollowed) || (motionPipeline.count() > 1))
+            float maxExitSpeed = maxAchievableSpeed(*pPlan, pPlan->_entrySpeedMMps);
+            if (maxExitSpeed < pFollowingPlan->_entrySpeedMMps)
             {
-                // No more changes
-                pBlock->_canExecute = true;
+                pFollowingPlan->_entrySpeedMMps = maxExitSpeed;
+                _plannedBlockIdx = blockIdx - 1;
             }
         }
+
+        // A block at its max entry speed can't be improved
+        if (pFollowingPlan->_entrySpeedMMps == pFollowingPlan->_maxEntrySpeedMMps)
+            _plannedBlockIdx = blockIdx - 1;
     }
 
+    // Allow blocks to start
+    commitBlocks(motionPipeline);
+
+    // Planning cost
+    _recalcCount++;
+    _recalcBlocksVisited += earliestBlockToReprocess + 1;
+    if (_recalcBlocksVisitedMax < (uint32_t)earliestBlockToReprocess + 1)
+        _recalcBlocksVisitedMax = earliestBlockToReprocess + 1;
+    _recalcUsTotal += micros() - recalcStartUs;
+
 #ifdef DEBUG_MOTIONPLANNER_INFO
     Log.notice(".................AFTER RECALC.......................\n");
-    motionPipeline.debugShowBlocks(axesParams);
+    motionPipeline.debugShowBlocks();
 #endif
 }
 
+// While moving every new block can be started - the segment preparer only starts each one when the
+// ISR is within the commit time of reaching it so its speeds can be replanned until then
+// From rest the first block waits until the blocks queued would take at least the commit time (at
+// their max speeds) so that it starts with enough look-ahead - or until no more blocks are coming
+void MotionPlanner::commitBlocks(MotionPipeline &motionPipeline)
+{
+    MotionBlock *pNewestBlock = motionPipeline.peekNthFromPut(0);
+    if (!pNewestBlock || pNewestBlock->_canExecute)
+        return;
+    MotionBlock *pPrecedingBlock = motionPipeline.peekNthFromPut(1);
+    bool canExecute = !pNewestBlock->_blockIsFollowed || !motionPipeline.canAccept() ||
+                (pPrecedingBlock && pPrecedingBlock->_canExecute);
+    if (!canExecute)
+    {
+        float queuedMs = 0;
+        for (int blockIdx = 0; ; blockIdx++)
+        {
+            MotionBlock *pBlock = motionPipeline.peekNthFromPut(blockIdx);
+            MotionBlockPlan *pPlan = motionPipeline.peekPlanNthFromPut(blockIdx);
+            if (!pBlock || !pPlan || pBlock->_canExecute)
+                break;
+            if (pPlan->_feedrateMMps > 0)
+                queuedMs += 1000 * pPlan->_moveDistPrimaryAxesMM / pPlan->_feedrateMMps;
+        }
+        canExecute = queuedMs >= _blockCommitMs;
+    }
+    if (!canExecute)
+        return;
+
+    // Newest block back to the last one already committed
+    for (int blockIdx = 0; ; blockIdx++)
+    {
+        MotionBlock *pBlock = motionPipeline.peekNthFromPut(blockIdx);
+        if (!pBlock || pBlock->_canExecute)
+            break;
+        pBlock->_canExecute = true;
+    }
+}
+
 // Entry point for adding a motion block
 bool MotionPlanner::moveToStepwise(RobotCommandArgs &args,
                     AxisPosition &curAxisPositions,
@@ -311,8 +432,7 @@ bool MotionPlanner::moveToStepwise(RobotCommandArgs &args,
 {
     // Create a block for this movement which will end up on the pipeline
     MotionBlock block;
-    block._entrySpeedMMps = 0;
-    block._exitSpeedMMps = 0;
+    MotionBlockPlan plan;
 
     // Find if there are any steps
     bool hasSteps = false;
@@ -354,27 +474,38 @@ bool MotionPlanner::moveToStepwise(RobotCommandArgs &args,
     if (args.isFeedrateValid())
         minFeedrate = args.getFeedrate();
 
-    block._feedrateMMps = minFeedrate;
-
-    // Prepare for stepping
-    if (block.prepareForStepping(axesParams))
-    {
-        // No more changes
-        block._canExecute = true;
-    }
-
-    // Add the block
-    motionPipeline.add(block);
-    _prevMotionBlockValid = true;
+    plan._feedrateMMps = minFeedrate;
+    setBlockLimits(block, plan, axesParams);
 
-    // Return the change in actuator position
+    // The block is planned in actuator space - over the distance moved by the axis with most steps
+    block._blockIsFollowed = args.getMoreMovesComing();
+    int maxStepsAxisIdx = block._axisIdxWithMaxSteps;
+    plan._moveDistPrimaryAxesMM = block.getAbsStepsToTarget(maxStepsAxisIdx) * axesParams.getStepDistMM(maxStepsAxisIdx);
+    AxisFloats stepDeltas;
     for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
-        curAxisPositions._stepsFromHome.setVal(axisIdx,
-                                                curAxisPositions._stepsFromHome.getVal(axisIdx) + block.getStepsToTarget(axisIdx));
+        stepDeltas.setVal(axisIdx, block.getStepsToTarget(axisIdx));
+    AxisFloats unitVectors;
+    setActuatorUnitVectors(stepDeltas, unitVectors, axesParams);
+
+    // Consecutive stepwise blocks are joined at speed where the junction allows - blocks which
+    // check end-stops (e.g. homing) start and end at rest
+    float vmaxJunction = _minimumPlannerSpeedMMps;
+    bool checksEndStops = args.getEndstopCheck().any();
+    if (_prevMotionBlockValid && _prevMotionBlock._isStepwise && !_prevMotionBlock._checksEndStops && !checksEndStops)
+        vmaxJunction = junctionSpeed(plan, unitVectors, true);
+
+    // Add to the pipeline
+    MotionBlockSequentialData blockInfo;
+    blockInfo._maxParamSpeedMMps = plan._feedrateMMps;
+    blockInfo._unitVectors = unitVectors;
+    blockInfo._accMMps2 = plan._accMMps2;
+    blockInfo._isStepwise = true;
+    blockInfo._checksEndStops = checksEndStops;
+    addToPipeline(block, plan, vmaxJunction, blockInfo, curAxisPositions, axesParams, motionPipeline);
 
 #ifdef DEBUG_MOTIONPLANNER_INFO
     Log.notice("^^^^^^^^^^^^^^^^^^^^^^^STEPWISE^^^^^^^^^^^^^^^^^^^^^^^^\n");
-    motionPipeline.debugShowBlocks(axesParams);
+    motionPipeline.debugShowBlocks();
 #endif
 
     return true;
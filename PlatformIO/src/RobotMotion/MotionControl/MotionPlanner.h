@@ -12,6 +12,7 @@
 #include "../AxisPosition.h"
 #include "../../RobotCommandArgs.h"
 #include "MotionPipeline.h"
+#include "MotionPipelineStats.h"
 
 typedef bool (*ptToActuatorFnType)(AxisFloats &targetPt, AxisFloats &outActuator, AxisPosition &curPos, AxesParams &axesParams, bool allowOutOfBounds);
 typedef void (*actuatorToPtFnType)(AxisFloats &targetActuator, AxisFloats &outPt, AxisPosition &curPos, AxesParams &axesParams);
@@ -26,27 +27,83 @@ class MotionPlanner
     float _minimumPlannerSpeedMMps;
     // Junction deviation
     float _junctionDeviation;
+    // Jerk limited (S-curve) acceleration
+    bool _useSCurve;
+    // Plan junctions and speeds in actuator space (for non-cartesian robots)
+    bool _jointSpacePlanning;
+    // Min time (at max speed) of the blocks queued before the first block from rest can start
+    uint32_t _blockCommitMs;
 
     // Structure to store details on last processed block
     struct MotionBlockSequentialData
     {
         AxisFloats _unitVectors;
+        AxisFloats _destActuatorCoords;
         float _maxParamSpeedMMps;
+        float _accMMps2;
+        bool _isStepwise;
+        bool _checksEndStops;
     };
     // Data on previously processed block
     bool _prevMotionBlockValid;
     MotionBlockSequentialData _prevMotionBlock;
+    unsigned long _prevMotionBlockAddedMs;
+
+    // Index (counting back from the most recently added block) of the newest block known to be
+    // optimally planned - its entry speed can't improve so the planner never revisits blocks before it
+    // -1 if there is no such block in the pipeline
+    int _plannedBlockIdx;
+
+    // Telemetry
+    MotionPipelineStats* _pPipelineStats;
+
+    // Cost of recalculating the pipeline - blocks visited
+    uint32_t _recalcCount;
+    uint32_t _recalcBlocksVisited;
+    uint32_t _recalcBlocksVisitedMax;
+    uint64_t _recalcUsTotal;
 
   public:
     MotionPlanner()
     {
         _prevMotionBlockValid = false;
+        _prevMotionBlockAddedMs = 0;
+        _plannedBlockIdx = -1;
+        _pPipelineStats = NULL;
+        resetPlannerStats();
         _minimumPlannerSpeedMMps = 0;
         // Configure the motion pipeline - these values will be changed in config
         _junctionDeviation = 0;
+        _useSCurve = false;
+        _jointSpacePlanning = false;
+        _blockCommitMs = 0;
     }
 
-    void configure(float junctionDeviation);
+    void configure(float junctionDeviation, bool useSCurve, bool jointSpacePlanning, uint32_t blockCommitMs);
+
+    void setPipelineStats(MotionPipelineStats* pPipelineStats)
+    {
+        _pPipelineStats = pPipelineStats;
+    }
+
+    void resetPlannerStats()
+    {
+        _recalcCount = 0;
+        _recalcBlocksVisited = 0;
+        _recalcBlocksVisitedMax = 0;
+        _recalcUsTotal = 0;
+    }
+
+    String getPlannerStatsJSON()
+    {
+        float recalcCount = _recalcCount > 0 ? _recalcCount : 1;
+        String jsonStr = "{\"n\":" + String(_recalcCount);
+        jsonStr += ",\"visitAvg\":" + String(_recalcBlocksVisited / recalcCount, 2);
+        jsonStr += ",\"visitMax\":" + String(_recalcBlocksVisitedMax);
+        jsonStr += ",\"usAvg\":" + String(_recalcUsTotal / recalcCount, 2);
+        jsonStr += "}";
+        return jsonStr;
+    }
 
     // Entry point for adding a motion block
     bool moveTo(RobotCommandArgs &args,
@@ -58,6 +115,31 @@ class MotionPlanner
 
     void recalculatePipeline(MotionPipeline &motionPipeline, AxesParams &axesParams);
 
+  private:
+    // Max speed reachable from a speed over the block's distance
+    float maxAchievableSpeed(MotionBlockPlan &plan, float velocity);
+
+    // Allow blocks to be started once enough motion is queued
+    void commitBlocks(MotionPipeline &motionPipeline);
+
+    // Speed, acceleration and jerk limits of a block from the per-axis limits
+    void setBlockLimits(MotionBlock &block, MotionBlockPlan &plan, AxesParams &axesParams);
+
+    // Distance, feedrate and direction of a block in actuator space
+    void setJointSpacePlan(MotionBlock &block, MotionBlockPlan &plan, RobotCommandArgs &args,
+                           float moveDist, AxisFloats &stepDeltas, AxisFloats &unitVectors, AxesParams &axesParams);
+    void setActuatorUnitVectors(AxisFloats &stepDeltas, AxisFloats &unitVectors, AxesParams &axesParams);
+
+    // Max speed at the junction with the previous block
+    float junctionSpeed(MotionBlockPlan &plan, AxisFloats &unitVectors, bool inActuatorSpace);
+
+    // Add a block to the pipeline and replan
+    void addToPipeline(MotionBlock &block, MotionBlockPlan &plan, float vmaxJunction,
+                       MotionBlockSequentialData &blockInfo, AxisPosition &curAxisPositions,
+                       AxesParams &axesParams, MotionPipeline &motionPipeline);
+
+  public:
+
     // Entry point for adding a motion block
     bool moveToStepwise(RobotCommandArgs &args,
                         AxisPosition &curAxisPositions,
@@ -1,12 +1,18 @@
 #pragma once
 
+#include <atomic>
+
 // Generic interrupt-safe ring buffer pointer class
-// Each pointer is only updated by one source (ISR or main thread)
+// Each pointer is only updated by one source - the put position by the producer (main thread)
+// and the get position by the consumer (ISR) - clear() must only be called when the consumer is stopped
+// The positions are published with release semantics and read with acquire semantics so that
+// an element is completely written before the consumer can see it and completely read before
+// the producer can overwrite it (the ISR may run on the other core of the ESP32)
 class MotionRingBufferPosn
 {
   public:
-    volatile unsigned int _putPos;
-    volatile unsigned int _getPos;
+    std::atomic<unsigned int> _putPos;
+    std::atomic<unsigned int> _getPos;
     unsigned int _bufLen;
 
     MotionRingBufferPosn(int maxLen)
@@ -17,29 +23,31 @@ class MotionRingBufferPosn
     void init(int maxLen)
     {
         _bufLen = maxLen;
-        _putPos = 0;
-        _getPos = 0;
+        _putPos.store(0, std::memory_order_relaxed);
+        _getPos.store(0, std::memory_order_relaxed);
     }
 
     void clear()
     {
-        _getPos = _putPos = 0;
+        _getPos.store(0, std::memory_order_release);
+        _putPos.store(0, std::memory_order_release);
     }
     bool canPut()
     {
         if (_bufLen == 0)
             return false;
-        if (_putPos == _getPos)
+        unsigned int pp = _putPos.load(std::memory_order_relaxed);
+        unsigned int gp = _getPos.load(std::memory_order_acquire);
+        if (pp == gp)
             return true;
-        unsigned int gp = _getPos;
-        if (_putPos > gp)
+        if (pp > gp)
         {
-            if ((_putPos != _bufLen - 1) || (gp != 0))
+            if ((pp != _bufLen - 1) || (gp != 0))
                 return true;
         }
         else
         {
-            if (gp - _putPos > 1)
+            if (gp - pp > 1)
                 return true;
         }
         return false;
@@ -47,29 +55,32 @@ class MotionRingBufferPosn
 
     bool IRAM_ATTR canGet()
     {
-        return _putPos != _getPos;
+        return _putPos.load(std::memory_order_acquire) != _getPos.load(std::memory_order_relaxed);
     }
 
     void hasPut()
     {
-        _putPos++;
-        if (_putPos >= _bufLen)
-            _putPos = 0;
+        unsigned int pp = _putPos.load(std::memory_order_relaxed) + 1;
+        if (pp >= _bufLen)
+            pp = 0;
+        _putPos.store(pp, std::memory_order_release);
     }
 
     void IRAM_ATTR hasGot()
     {
-        _getPos++;
-        if (_getPos >= _bufLen)
-            _getPos = 0;
+        unsigned int gp = _getPos.load(std::memory_order_relaxed) + 1;
+        if (gp >= _bufLen)
+            gp = 0;
+        _getPos.store(gp, std::memory_order_release);
     }
 
     unsigned int count()
     {
-        unsigned int getPos = _getPos;
-        if (getPos <= _putPos)
-            return _putPos - getPos;
-        return _bufLen - getPos + _putPos;
+        unsigned int getPos = _getPos.load(std::memory_order_acquire);
+        unsigned int putPos = _putPos.load(std::memory_order_acquire);
+        if (getPos <= putPos)
+            return putPos - getPos;
+        return _bufLen - getPos + putPos;
     }
 
     // Get Nth element prior to the put position
@@ -78,15 +89,15 @@ class MotionRingBufferPosn
     // Returns -1 if invalid
     int getNthFromPut(unsigned int N)
     {
-        if (!canGet())
-            return -1;
-        if (N >= _bufLen)
+        // Positions are read once so the result is consistent if the other side moves on
+        unsigned int getPos = _getPos.load(std::memory_order_acquire);
+        unsigned int putPos = _putPos.load(std::memory_order_acquire);
+        unsigned int numInBuf = (getPos <= putPos) ? putPos - getPos : _bufLen - getPos + putPos;
+        if (N >= numInBuf)
             return -1;
-        int nthPos = _putPos - 1 - N;
+        int nthPos = putPos - 1 - N;
         if (nthPos < 0)
             nthPos += _bufLen;
-        if (((unsigned int)(nthPos + 1) == _getPos) || ((unsigned int)(nthPos + 1) == _bufLen && _getPos == 0))
-            return -1;
         return nthPos;
     }
 
@@ -96,15 +107,14 @@ class MotionRingBufferPosn
     // returns -1 if invalid
     int getNthFromGet(unsigned int N)
     {
-        if (!canGet())
+        unsigned int getPos = _getPos.load(std::memory_order_acquire);
+        unsigned int putPos = _putPos.load(std::memory_order_acquire);
+        unsigned int numInBuf = (getPos <= putPos) ? putPos - getPos : _bufLen - getPos + putPos;
+        if (N >= numInBuf)
             return -1;
-        if (N >= _bufLen)
-            return -1;
-        unsigned int nthPos = _getPos + N;
+        unsigned int nthPos = getPos + N;
         if (nthPos >= _bufLen)
             nthPos -= _bufLen;
-        if (nthPos == _putPos)
-            return -1;
         return nthPos;
     }
 };
@@ -0,0 +1,152 @@
+// RBotFirmware
+// Rob Dobson 2016-2018
+
+#pragma once
+
+#include <Arduino.h>
+#include "MotionBlock.h"
+#include "MotionRingBuffer.h"
+
+// Stepping is timed by scheduling the timer alarm for each step edge rather than by polling
+// on a fixed tick - define USE_FIXED_TICK_STEPPING in the build flags to use the fixed tick
+#if defined(ESP32) && !defined(USE_FIXED_TICK_STEPPING)
+#define USE_EVENT_SCHEDULED_STEPPING 1
+#endif
+
+// A segment is a short fixed-duration slice of a MotionBlock at a constant step rate
+// Segments are generated in the main loop by MotionSegmentPreparer so that the ISR
+// only has to step through them - no acceleration or block setup work is done in the ISR
+class MotionSegment
+{
+public:
+    // Number of ISR ticks in a segment - this is the interval at which the step rate changes
+    static constexpr uint32_t TICKS_PER_SEGMENT = MotionBlock::NS_IN_A_MS / MotionBlock::TICK_INTERVAL_NS;
+
+#ifdef USE_EVENT_SCHEDULED_STEPPING
+    // Event timer runs from the 80MHz APB clock
+    static constexpr uint32_t EVENT_TIMER_DIVIDER = 2;
+    static constexpr uint32_t EVENT_TICKS_PER_US = 80 / EVENT_TIMER_DIVIDER;
+    static constexpr uint32_t EVENT_TICKS_PER_ISR_TICK = (MotionBlock::TICK_INTERVAL_NS / 1000) * EVENT_TICKS_PER_US;
+    static constexpr uint32_t EVENT_TICKS_PER_SEGMENT = TICKS_PER_SEGMENT * EVENT_TICKS_PER_ISR_TICK;
+    static constexpr uint32_t EVENT_TICKS_PER_SEC = EVENT_TICKS_PER_US * 1000000;
+    // Step intervals are fixed point with this many fractional bits
+    static constexpr uint32_t EVENT_TICKS_FRAC_BITS = 8;
+#endif
+
+    // Block sequence number which is never used
+    static constexpr uint16_t BLOCK_SEQ_NONE = 0;
+
+    // Oversampling of the step generator at low step rates - at level N the Bresenham algorithm runs at
+    // 2^N times the step rate of the axis with most steps so that the other axes are stepped more evenly
+    static constexpr uint32_t MAX_OVERSAMPLE_LEVEL = 3;
+    static constexpr uint32_t OVERSAMPLE_MAX_TICK_RATE_PER_SEC = 8000;
+
+    // End-stop checks
+    static constexpr int MAX_END_STOP_CHECKS = RobotConsts::MAX_AXES * AxisMinMaxBools::ENDSTOPS_PER_AXIS;
+    struct EndStopCheck
+    {
+        int8_t pin;
+        bool val;
+    };
+
+public:
+    // Step rate (in steps per TTICKS) for the whole segment - this is the rate of Bresenham steps
+    // which is higher than the rate of the axis with most steps when oversampling
+    uint32_t _stepRatePerTTicks;
+    // Number of ISR ticks in the segment (the last segment of a block runs until the block's steps are complete)
+    uint16_t _ticks;
+    // Number of Bresenham steps in this segment
+    uint16_t _stepsInSegment;
+    // Sequence number of the block this segment is part of
+    uint16_t _blockSeq;
+#ifdef USE_EVENT_SCHEDULED_STEPPING
+    // Time of the first step (from the start of the segment) in event timer ticks
+    uint32_t _firstStepEventTicks;
+    // Interval between steps (fixed point event timer ticks) and the change in interval after each step
+    uint32_t _stepIntervalFx;
+    int32_t _stepIntervalDeltaFx;
+#endif
+
+    // Flags
+    struct
+    {
+        bool _isFirstInBlock : 1;
+        bool _isLastInBlock : 1;
+    };
+
+    // Oversampling level
+    uint8_t _oversampleLevel;
+
+    // Block info - only used for the first segment of a block
+    uint8_t _axisIdxWithMaxSteps;
+    // Direction pin level (bit per axis)
+    uint8_t _dirnLevels;
+    // Axes stepping in the negative direction (bit per axis)
+    uint8_t _dirnNegative;
+    // End stops
+    uint8_t _endStopCheckNum;
+    EndStopCheck _endStopChecks[MAX_END_STOP_CHECKS];
+    // Steps in block for each axis
+    uint32_t _stepsTotalAbs[RobotConsts::MAX_AXES];
+    // Numbered command index of the block
+    int _numberedCommandIndex;
+};
+
+// Single-producer (main loop) single-consumer (ISR) buffer of segments
+class MotionSegmentBuffer
+{
+public:
+    // Each segment is TICKS_PER_SEGMENT long (1ms) so this is the time the ISR can run
+    // without the main loop preparing more segments
+    static constexpr int SEGMENT_BUFFER_LEN = 40;
+
+private:
+    MotionRingBufferPosn _segmentPosn;
+    MotionSegment _segments[SEGMENT_BUFFER_LEN];
+
+public:
+    MotionSegmentBuffer() : _segmentPosn(SEGMENT_BUFFER_LEN)
+    {
+    }
+
+    void clear()
+    {
+        _segmentPosn.clear();
+    }
+
+    unsigned int count()
+    {
+        return _segmentPosn.count();
+    }
+
+    bool canPut()
+    {
+        return _segmentPosn.canPut();
+    }
+
+    // Segment to be filled in before calling hasPut()
+    MotionSegment *peekPut()
+    {
+        return &(_segments[_segmentPosn._putPos]);
+    }
+
+    void hasPut()
+    {
+        _segmentPosn.hasPut();
+    }
+
+    // Peek the segment which would be got (if there is one)
+    MotionSegment *IRAM_ATTR peekGet()
+    {
+        if (!_segmentPosn.canGet())
+            return NULL;
+        return &(_segments[_segmentPosn._getPos]);
+    }
+
+    // Remove the segment at the get position
+    void IRAM_ATTR remove()
+    {
+        if (_segmentPosn.canGet())
+            _segmentPosn.hasGot();
+    }
+};
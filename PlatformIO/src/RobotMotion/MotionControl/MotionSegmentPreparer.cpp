@@ -0,0 +1,462 @@
+// RBotFirmware
+// Rob Dobson 2016-2018
+
+#include "MotionSegmentPreparer.h"
+#include "MotionPipeline.h"
+
+void MotionSegmentPreparer::prepare(MotionPipeline &motionPipeline, MotionSegmentBuffer &segmentBuffer,
+                                    RobotConsts::RawMotionHwInfo_t &rawMotionHwInfo, uint16_t abortedBlockSeq)
+{
+    // Check if the ISR has abandoned the block being prepared (it is removed from the pipeline by the ISR)
+    if (_pBlock && (_blockSeq == abortedBlockSeq))
+        _pBlock = NULL;
+
+    // Keep the segment buffer full
+    while (segmentBuffer.canPut())
+    {
+        // Start on the next block if needed
+        if (!_pBlock)
+        {
+            if (!startNextBlock(motionPipeline, segmentBuffer, rawMotionHwInfo))
+                return;
+        }
+
+        // Generate a segment
+        MotionSegment *pSegment = segmentBuffer.peekPut();
+        prepareSegment(*pSegment);
+        segmentBuffer.hasPut();
+
+        // Block done?
+        if (pSegment->_isLastInBlock)
+            _pBlock = NULL;
+    }
+}
+
+// Find the first block in the pipeline which hasn't been started and set up the block info
+bool MotionSegmentPreparer::startNextBlock(MotionPipeline &motionPipeline, MotionSegmentBuffer &segmentBuffer,
+                                           RobotConsts::RawMotionHwInfo_t &rawMotionHwInfo)
+{
+    // Blocks which are executing stay in the pipeline until the ISR has finished them
+    MotionBlock *pBlock = NULL;
+    unsigned int blockIdx = 0;
+    for (; ; blockIdx++)
+    {
+        pBlock = motionPipeline.peekNthFromGet(blockIdx);
+        if (!pBlock)
+            return false;
+        if (!pBlock->_isExecuting)
+            break;
+    }
+
+    // Leave the block to the planner until the ISR is within the commit time of reaching it
+    if ((blockIdx > 0) && (_blockCommitMs > 0) && (segmentBuffer.count() >= _blockCommitMs))
+        return false;
+
+    // Check the planner has finished with the block
+    if (!pBlock->_canExecute || !_pAxesParams)
+    {
+        _blockNotExecutableCount++;
+        return false;
+    }
+
+    // The entry speed of the block and of the one following it (the exit speed) are now fixed
+    // so compute the stepping profile
+    MotionBlockPlan *pPlan = motionPipeline.peekPlanNthFromGet(blockIdx);
+    MotionBlockPlan *pFollowingPlan = motionPipeline.peekPlanNthFromGet(blockIdx + 1);
+    if (!pBlock->prepareForStepping(_profile, *pPlan, pFollowingPlan ? pFollowingPlan->_entrySpeedMMps : 0,
+                                    *_pAxesParams, _useSCurve))
+        return false;
+    _pBlock = pBlock;
+
+    // Sequence number - set in the block before any of its segments are published to the ISR
+    _blockSeq++;
+    if (_blockSeq == MotionSegment::BLOCK_SEQ_NONE)
+        _blockSeq++;
+    pBlock->_blockSeq = _blockSeq;
+    pBlock->_isExecuting = true;
+
+    // Block info
+    _blockSegment._blockSeq = _blockSeq;
+    _blockSegment._axisIdxWithMaxSteps = pBlock->_axisIdxWithMaxSteps;
+    _blockSegment._numberedCommandIndex = pBlock->getNumberedCommandIndex();
+    _blockSegment._dirnLevels = 0;
+    _blockSegment._dirnNegative = 0;
+    _blockSegment._oversampleLevel = 0;
+    for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
+    {
+        int32_t stepsTotal = pBlock->_stepsTotalMaybeNeg[axisIdx];
+        _blockSegment._stepsTotalAbs[axisIdx] = abs(stepsTotal);
+        if ((stepsTotal >= 0) == rawMotionHwInfo._axis[axisIdx]._pinDirectionReversed)
+            _blockSegment._dirnLevels |= (1 << axisIdx);
+        if (stepsTotal < 0)
+            _blockSegment._dirnNegative |= (1 << axisIdx);
+    }
+    setupEndStops(rawMotionHwInfo);
+
+    // Stepping state
+    _stepsTotalMaxAxis = _blockSegment._stepsTotalAbs[pBlock->_axisIdxWithMaxSteps];
+    _stepsDone = 0;
+    _curStepRatePerTTicks = _profile._initialStepRatePerTTicks;
+    _curAccumulatorStep = 0;
+    _oversampleStepsDone = 0;
+    _isFirstSegment = true;
+    _curAccStepsPerTTicksPerMS = 0;
+    _isDecelerating = false;
+#ifdef USE_EVENT_SCHEDULED_STEPPING
+    if (_rampType == RAMP_PER_STEP)
+        startPerStepRamp();
+#endif
+    return true;
+}
+
+// Build the table of end-stops to check while the block is executing
+void MotionSegmentPreparer::setupEndStops(RobotConsts::RawMotionHwInfo_t &rawMotionHwInfo)
+{
+    _blockSegment._endStopCheckNum = 0;
+    if (!_pBlock->_endStopsToCheck.any())
+        return;
+    for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
+    {
+        int32_t stepsTotal = _pBlock->_stepsTotalMaybeNeg[axisIdx];
+
+        // Check if the axis is moving in a direction which might result in hitting an active end-stop
+        for (int minMaxIdx = 0; minMaxIdx < AxisMinMaxBools::ENDSTOPS_PER_AXIS; minMaxIdx++)
+        {
+            // See if anything to check for
+            AxisMinMaxBools::AxisMinMaxEnum minMaxType = _pBlock->_endStopsToCheck.get(axisIdx, minMaxIdx);
+            if (minMaxType == AxisMinMaxBools::END_STOP_NONE)
+                continue;
+
+            // Check for towards - this is different from MAX or MIN because the axis will still move even if
+            // an endstop is hit if the movement is away from that endstop
+            if (minMaxType == AxisMinMaxBools::END_STOP_TOWARDS)
+            {
+                // Stop at max if we're heading towards max OR
+                // stop at min if we're heading towards min
+                if (!(((minMaxIdx == AxisMinMaxBools::MAX_VAL_IDX) && (stepsTotal > 0)) ||
+                        ((minMaxIdx == AxisMinMaxBools::MIN_VAL_IDX) && (stepsTotal < 0))))
+                    continue;
+            }
+
+            // Pin for stop
+            int pinToTest = (minMaxIdx == AxisMinMaxBools::MIN_VAL_IDX) ?
+                                rawMotionHwInfo._axis[axisIdx]._pinEndStopMin :
+                                rawMotionHwInfo._axis[axisIdx]._pinEndStopMax;
+
+            // Endstop test
+            bool valToTestFor = (minMaxType != AxisMinMaxBools::END_STOP_NOT_HIT) ?
+                                rawMotionHwInfo._axis[axisIdx]._pinEndStopMaxactLvl :
+                                !rawMotionHwInfo._axis[axisIdx]._pinEndStopMaxactLvl;
+            if (pinToTest != -1)
+            {
+                MotionSegment::EndStopCheck &check = _blockSegment._endStopChecks[_blockSegment._endStopCheckNum++];
+                check.pin = pinToTest;
+                check.val = valToTestFor;
+            }
+        }
+    }
+}
+
+// Generate the next segment of the block - the steps in the segment are found by running the
+// same accumulator as the ISR so that acceleration changes happen at the same step counts
+void MotionSegmentPreparer::prepareSegment(MotionSegment &segment)
+{
+#ifdef USE_EVENT_SCHEDULED_STEPPING
+    if (_rampType == RAMP_PER_STEP)
+    {
+        prepareSegmentPerStep(segment);
+        return;
+    }
+#endif
+    segment = _blockSegment;
+    segment._ticks = MotionSegment::TICKS_PER_SEGMENT;
+    segment._isFirstInBlock = _isFirstSegment;
+
+    // Bresenham steps are at a multiple of the step rate when oversampling
+    uint32_t oversampleLevel = getOversampleLevel();
+    uint32_t oversampleShift = MotionSegment::MAX_OVERSAMPLE_LEVEL - oversampleLevel;
+    uint32_t tickRatePerTTicks = _curStepRatePerTTicks << oversampleLevel;
+    segment._stepRatePerTTicks = tickRatePerTTicks;
+    segment._oversampleLevel = oversampleLevel;
+
+#ifdef USE_EVENT_SCHEDULED_STEPPING
+    // Time to the first step and between steps - from the time for the accumulator to reach TTICKS_VALUE
+    uint32_t stepTicks = MotionSegment::TICKS_PER_SEGMENT;
+    segment._firstStepEventTicks = 0;
+    segment._stepIntervalFx = 0;
+    segment._stepIntervalDeltaFx = 0;
+    if (tickRatePerTTicks != 0)
+    {
+        segment._firstStepEventTicks = uint32_t(((uint64_t(MotionBlock::TTICKS_VALUE - _curAccumulatorStep) * MotionSegment::EVENT_TICKS_PER_ISR_TICK) +
+                                                 tickRatePerTTicks - 1) / tickRatePerTTicks);
+        uint64_t intervalFx = ((uint64_t(MotionBlock::TTICKS_VALUE) * MotionSegment::EVENT_TICKS_PER_ISR_TICK << MotionSegment::EVENT_TICKS_FRAC_BITS) +
+                               tickRatePerTTicks / 2) / tickRatePerTTicks;
+        segment._stepIntervalFx = uint32_t(std::min(intervalFx, uint64_t(UINT32_MAX)));
+    }
+#else
+    // The first tick of a block is used by the ISR to set up the block (direction etc)
+    uint32_t stepTicks = _isFirstSegment ? MotionSegment::TICKS_PER_SEGMENT - 1 : MotionSegment::TICKS_PER_SEGMENT;
+#endif
+    _isFirstSegment = false;
+
+    // Steps in this segment
+    uint64_t accumulator = _curAccumulatorStep + uint64_t(stepTicks) * tickRatePerTTicks;
+    uint32_t stepsInSegment = uint32_t(accumulator / MotionBlock::TTICKS_VALUE);
+    uint32_t oversampleStepsLeft = (_stepsTotalMaxAxis << MotionSegment::MAX_OVERSAMPLE_LEVEL) - _oversampleStepsDone;
+    uint32_t stepsLeft = (oversampleStepsLeft + (1 << oversampleShift) - 1) >> oversampleShift;
+    if (stepsInSegment >= stepsLeft)
+    {
+        // Block completes in this segment
+        segment._stepsInSegment = stepsLeft;
+        segment._isLastInBlock = true;
+        return;
+    }
+    segment._stepsInSegment = stepsInSegment;
+    segment._isLastInBlock = false;
+    _curAccumulatorStep = uint32_t(accumulator % MotionBlock::TTICKS_VALUE);
+    _oversampleStepsDone += stepsInSegment << oversampleShift;
+    _stepsDone = _oversampleStepsDone >> MotionSegment::MAX_OVERSAMPLE_LEVEL;
+
+    // Acceleration/deceleration for the next segment
+    updateStepRate();
+}
+
+// Oversampling level for the current step rate - the highest which keeps the Bresenham step rate
+// below OVERSAMPLE_MAX_TICK_RATE_PER_SEC
+uint32_t MotionSegmentPreparer::getOversampleLevel()
+{
+    if (!_oversampleEnabled)
+        return 0;
+    uint32_t oversampleLevel = 0;
+    while ((oversampleLevel < MotionSegment::MAX_OVERSAMPLE_LEVEL) &&
+           ((uint64_t(_curStepRatePerTTicks) << (oversampleLevel + 1)) <= OVERSAMPLE_MAX_TICK_RATE_PER_TTICKS))
+        oversampleLevel++;
+    return oversampleLevel;
+}
+
+// Change the step rate to handle acceleration and deceleration
+void MotionSegmentPreparer::updateStepRate()
+{
+    // Jerk limited blocks
+    if (_profile._jerkStepsPerTTicksPerMS2 != 0)
+    {
+        updateStepRateSCurve();
+        return;
+    }
+
+    // Check if decelerating
+    if (_stepsDone > _profile._stepsBeforeDecel)
+    {
+        if (_curStepRatePerTTicks > std::max(MIN_STEP_RATE_PER_TTICKS + _profile._accStepsPerTTicksPerMS,
+                                             _profile._finalStepRatePerTTicks + _profile._accStepsPerTTicksPerMS))
+            _curStepRatePerTTicks -= _profile._accStepsPerTTicksPerMS;
+    }
+    else if (_curStepRatePerTTicks < _profile._maxStepRatePerTTicks)
+    {
+        if (_curStepRatePerTTicks + _profile._accStepsPerTTicksPerMS < MotionBlock::TTICKS_VALUE)
+            _curStepRatePerTTicks += _profile._accStepsPerTTicksPerMS;
+    }
+}
+
+// Change the step rate with limited jerk - the acceleration is ramped up to the maximum and ramped back
+// down to zero in time for the rate to arrive at the target (the peak rate or the final rate)
+void MotionSegmentPreparer::updateStepRateSCurve()
+{
+    // Deceleration starts at zero acceleration
+    if (!_isDecelerating && (_stepsDone > _profile._stepsBeforeDecel))
+    {
+        _isDecelerating = true;
+        _curAccStepsPerTTicksPerMS = 0;
+    }
+
+    // Rate change remaining
+    uint32_t targetRatePerTTicks = _isDecelerating ?
+                    std::max(_profile._finalStepRatePerTTicks, MIN_STEP_RATE_PER_TTICKS) :
+                    std::min(_profile._maxStepRatePerTTicks, MotionBlock::TTICKS_VALUE - 1);
+    uint32_t rateChangeLeft = _isDecelerating ?
+                    (_curStepRatePerTTicks > targetRatePerTTicks ? _curStepRatePerTTicks - targetRatePerTTicks : 0) :
+                    (_curStepRatePerTTicks < targetRatePerTTicks ? targetRatePerTTicks - _curStepRatePerTTicks : 0);
+    if (rateChangeLeft == 0)
+    {
+        _curAccStepsPerTTicksPerMS = 0;
+        return;
+    }
+
+    // Rate change if acceleration is reduced to zero from now
+    uint32_t jerk = _profile._jerkStepsPerTTicksPerMS2;
+    uint64_t rateChangeWhileReducing = uint64_t(_curAccStepsPerTTicksPerMS) * _curAccStepsPerTTicksPerMS / (2 * jerk);
+    bool isReducing = rateChangeLeft <= rateChangeWhileReducing;
+    if (isReducing)
+        _curAccStepsPerTTicksPerMS = std::max(_curAccStepsPerTTicksPerMS - std::min(jerk, _curAccStepsPerTTicksPerMS), jerk);
+    else
+        _curAccStepsPerTTicksPerMS = std::min(_curAccStepsPerTTicksPerMS + jerk, _profile._accStepsPerTTicksPerMS);
+
+    // Apply
+    uint32_t rateChange = std::min(_curAccStepsPerTTicksPerMS, rateChangeLeft);
+    if (!_isDecelerating)
+    {
+        _curStepRatePerTTicks += rateChange;
+        return;
+    }
+    _curStepRatePerTTicks -= rateChange;
+    if (!isReducing)
+        return;
+
+    // While the deceleration is reduced the rate should not fall below that of a jerk limited stop in the
+    // steps left (v = J.t^2/2 where steps left = J.t^3/6) otherwise the last few steps are very slow
+    constexpr float STEPS_PER_RATE_MS = float(MotionSegment::TICKS_PER_SEGMENT) / MotionBlock::TTICKS_VALUE;
+    float msToStop = cbrtf(6.0f * (_stepsTotalMaxAxis - _stepsDone) / (jerk * STEPS_PER_RATE_MS));
+    uint32_t stoppingRatePerTTicks = uint32_t(jerk * msToStop * msToStop / 2);
+    if (_curStepRatePerTTicks < stoppingRatePerTTicks)
+        _curStepRatePerTTicks = std::min(stoppingRatePerTTicks, targetRatePerTTicks + rateChangeLeft);
+}
+
+#ifdef USE_EVENT_SCHEDULED_STEPPING
+
+// Set up the per-step ramp for a new block
+// The step interval follows the integer recurrence approximation c(n) = c(n-1) - 2c(n-1)/(4n+1)
+// (D. Austin, "Generate stepper-motor speed profiles in real time") - n is the step number counted
+// from zero speed so the ramp can start or end at any speed
+void MotionSegmentPreparer::startPerStepRamp()
+{
+    constexpr float RATE_PER_TTICKS_TO_STEPS_PER_SEC = MotionBlock::TICKS_PER_SEC / MotionBlock::TTICKS_VALUE;
+    constexpr float FX_TICKS_PER_SEC = float(MotionSegment::EVENT_TICKS_PER_SEC) * (1 << MotionSegment::EVENT_TICKS_FRAC_BITS);
+
+    // Speeds in steps per second and acceleration in steps per second per second
+    float initialStepsPerSec = _profile._initialStepRatePerTTicks * RATE_PER_TTICKS_TO_STEPS_PER_SEC;
+    float maxStepsPerSec = std::max(_profile._maxStepRatePerTTicks * RATE_PER_TTICKS_TO_STEPS_PER_SEC, float(MIN_STEP_RATE_PER_SEC));
+    float finalStepsPerSec = std::max(_profile._finalStepRatePerTTicks * RATE_PER_TTICKS_TO_STEPS_PER_SEC, float(MIN_STEP_RATE_PER_SEC));
+    _accStepsPerSec2 = _profile._accStepsPerTTicksPerMS * RATE_PER_TTICKS_TO_STEPS_PER_SEC * 1000;
+    _minStepIntervalFx = int64_t(FX_TICKS_PER_SEC / maxStepsPerSec);
+    _maxStepIntervalFx = int64_t(FX_TICKS_PER_SEC / finalStepsPerSec);
+
+    // Initial interval - from standstill the first interval is corrected by 0.676 to allow for the
+    // inaccuracy of the recurrence at low step numbers
+    _rampStepN = 0;
+    if (_accStepsPerSec2 <= 0)
+    {
+        _stepIntervalFx = _minStepIntervalFx;
+    }
+    else
+    {
+        float stepsFromZero = initialStepsPerSec * initialStepsPerSec / (2 * _accStepsPerSec2);
+        if (stepsFromZero < 1)
+        {
+            _stepIntervalFx = int64_t(0.676f * FX_TICKS_PER_SEC * sqrtf(2 / _accStepsPerSec2));
+        }
+        else
+        {
+            _stepIntervalFx = int64_t(FX_TICKS_PER_SEC / initialStepsPerSec);
+            _rampStepN = int32_t(stepsFromZero + 0.5f);
+        }
+    }
+    _stepIntervalFx = std::max(_stepIntervalFx, _minStepIntervalFx);
+    _stepIntervalRest = 0;
+    _rampIsDecel = false;
+    _segmentStartFx = 0;
+    _nextStepFx = _stepIntervalFx;
+}
+
+// Calculate the interval to the next step
+void MotionSegmentPreparer::updateStepInterval()
+{
+    if (_accStepsPerSec2 <= 0)
+        return;
+
+    // Start of deceleration - the step number is the number of steps needed to stop from the current speed
+    // at the deceleration which reaches the final speed on the last step (the speed reached by the ramp
+    // can be a little below the profile's so decelerating at the profile's rate would stop short)
+    if (!_rampIsDecel && (_stepsDone > _profile._stepsBeforeDecel))
+    {
+        constexpr float FX_TICKS_PER_SEC = float(MotionSegment::EVENT_TICKS_PER_SEC) * (1 << MotionSegment::EVENT_TICKS_FRAC_BITS);
+        float stepsPerSec = FX_TICKS_PER_SEC / _stepIntervalFx;
+        float finalStepsPerSec = FX_TICKS_PER_SEC / _maxStepIntervalFx;
+        float speedDropSq = stepsPerSec * stepsPerSec - finalStepsPerSec * finalStepsPerSec;
+        float stepsToStop = stepsPerSec * stepsPerSec / (2 * _accStepsPerSec2);
+        if (speedDropSq > 0)
+            stepsToStop = stepsPerSec * stepsPerSec * (_stepsTotalMaxAxis - _stepsDone) / speedDropSq;
+        _rampStepN = std::max(int32_t(stepsToStop + 0.5f), int32_t(1));
+        _stepIntervalRest = 0;
+        _rampIsDecel = true;
+    }
+
+    if (_rampIsDecel)
+    {
+        if (_stepIntervalFx >= _maxStepIntervalFx)
+            return;
+        int64_t numerator = 2 * _stepIntervalFx + _stepIntervalRest;
+        int64_t denominator = 4 * _rampStepN - 1;
+        _stepIntervalFx += numerator / denominator;
+        _stepIntervalRest = numerator % denominator;
+        if (_rampStepN > 1)
+            _rampStepN--;
+        _stepIntervalFx = std::min(_stepIntervalFx, _maxStepIntervalFx);
+    }
+    else
+    {
+        if (_stepIntervalFx <= _minStepIntervalFx)
+            return;
+        _rampStepN++;
+        int64_t numerator = 2 * _stepIntervalFx + _stepIntervalRest;
+        int64_t denominator = 4 * _rampStepN + 1;
+        _stepIntervalFx -= numerator / denominator;
+        _stepIntervalRest = numerator % denominator;
+        _stepIntervalFx = std::max(_stepIntervalFx, _minStepIntervalFx);
+    }
+}
+
+// Generate the next segment using the per-step ramp
+// Step times within the segment are sent to the ISR as the first step time, the first interval and
+// the (constant) change in interval per step - which matches the first two and last step times
+void MotionSegmentPreparer::prepareSegmentPerStep(MotionSegment &segment)
+{
+    segment = _blockSegment;
+    segment._ticks = MotionSegment::TICKS_PER_SEGMENT;
+    segment._isFirstInBlock = _isFirstSegment;
+    _isFirstSegment = false;
+
+    // Generate steps which fall within the segment
+    uint64_t segmentEndFx = _segmentStartFx + (uint64_t(MotionSegment::EVENT_TICKS_PER_SEGMENT) << MotionSegment::EVENT_TICKS_FRAC_BITS);
+    uint32_t stepsInSegment = 0;
+    int64_t firstStepFx = 0, secondStepFx = 0, lastStepFx = 0;
+    while ((_stepsDone < _stepsTotalMaxAxis) && (_nextStepFx < segmentEndFx) && (stepsInSegment < UINT16_MAX))
+    {
+        int64_t stepFx = int64_t(_nextStepFx - _segmentStartFx);
+        if (stepsInSegment == 0)
+            firstStepFx = stepFx;
+        else if (stepsInSegment == 1)
+            secondStepFx = stepFx;
+        lastStepFx = stepFx;
+        stepsInSegment++;
+        _stepsDone++;
+        if (_stepsDone < _stepsTotalMaxAxis)
+        {
+            updateStepInterval();
+            _nextStepFx += _stepIntervalFx;
+        }
+    }
+    _segmentStartFx = segmentEndFx;
+    segment._stepsInSegment = stepsInSegment;
+    segment._isLastInBlock = _stepsDone >= _stepsTotalMaxAxis;
+
+    // Step timing for the ISR
+    segment._firstStepEventTicks = uint32_t(firstStepFx >> MotionSegment::EVENT_TICKS_FRAC_BITS);
+    int64_t baseFx = int64_t(segment._firstStepEventTicks) << MotionSegment::EVENT_TICKS_FRAC_BITS;
+    int64_t intervalFx = (stepsInSegment > 1) ? secondStepFx - baseFx : 0;
+    int64_t deltaFx = 0;
+    if (stepsInSegment > 2)
+    {
+        int64_t deltaDivisor = int64_t(stepsInSegment - 1) * (stepsInSegment - 2) / 2;
+        int64_t errorFx = (lastStepFx - baseFx) - int64_t(stepsInSegment - 1) * intervalFx;
+        deltaFx = (errorFx + (errorFx >= 0 ? deltaDivisor / 2 : -deltaDivisor / 2)) / deltaDivisor;
+    }
+    segment._stepIntervalFx = uint32_t(intervalFx);
+    segment._stepIntervalDeltaFx = int32_t(deltaFx);
+
+    // Step rate at the end of the segment
+    _curStepRatePerTTicks = uint32_t(((uint64_t(MotionBlock::TTICKS_VALUE) * MotionSegment::EVENT_TICKS_PER_ISR_TICK) << MotionSegment::EVENT_TICKS_FRAC_BITS) /
+                                     _stepIntervalFx);
+    segment._stepRatePerTTicks = _curStepRatePerTTicks;
+}
+
+#endif
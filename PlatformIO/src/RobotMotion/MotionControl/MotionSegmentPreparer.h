@@ -0,0 +1,151 @@
+// RBotFirmware
+// Rob Dobson 2016-2018
+
+#pragma once
+
+#include "MotionSegment.h"
+#include "RobotConsts.h"
+
+class MotionPipeline;
+
+// Runs in the main loop and converts MotionBlocks into MotionSegments for the ISR
+// The acceleration profile is evaluated here (once per segment) rather than in the ISR
+class MotionSegmentPreparer
+{
+public:
+    // This is to ensure that the robot never goes to 0 tick rate - which would leave it
+    // immobile forever
+    static constexpr uint32_t MIN_STEP_RATE_PER_SEC = 1;
+    static constexpr uint32_t MIN_STEP_RATE_PER_TTICKS = uint32_t((MIN_STEP_RATE_PER_SEC * 1.0 * MotionBlock::TTICKS_VALUE) / MotionBlock::TICKS_PER_SEC);
+    static constexpr uint32_t OVERSAMPLE_MAX_TICK_RATE_PER_TTICKS =
+                uint32_t((MotionSegment::OVERSAMPLE_MAX_TICK_RATE_PER_SEC * 1.0 * MotionBlock::TTICKS_VALUE) / MotionBlock::TICKS_PER_SEC);
+
+    // Ramp generation - the step rate is either changed once per segment (perMS) or the step
+    // interval is recalculated for every step of the axis with most steps (perStep)
+    // Blocks with a jerk limit (S-curve) are ramped once per segment
+    enum RampType
+    {
+        RAMP_PER_MS,
+        RAMP_PER_STEP
+    };
+
+private:
+    // Block currently being prepared and its stepping profile
+    MotionBlock *_pBlock;
+    MotionBlockProfile _profile;
+    // Axes and ramp type used to compute the profile
+    AxesParams *_pAxesParams;
+    bool _useSCurve;
+    uint16_t _blockSeq;
+    // Template segment holding the block info
+    MotionSegment _blockSegment;
+    // Stepping state - mirrors the step accumulator in the ISR
+    uint32_t _stepsTotalMaxAxis;
+    uint32_t _stepsDone;
+    uint32_t _curStepRatePerTTicks;
+    uint32_t _curAccumulatorStep;
+    bool _isFirstSegment;
+    RampType _rampType;
+    // Oversampling at low step rates and Bresenham steps done for the axis with most steps (in units of
+    // 1/2^MAX_OVERSAMPLE_LEVEL of a step)
+    bool _oversampleEnabled;
+    uint32_t _oversampleStepsDone;
+    // Acceleration for jerk limited (S-curve) blocks
+    uint32_t _curAccStepsPerTTicksPerMS;
+    bool _isDecelerating;
+    // Count of times the next block was waiting for the planner (_canExecute not set)
+    uint32_t _blockNotExecutableCount;
+    // A block following one that is executing is only started when the segments buffered for the
+    // ISR last less than this (each segment is 1ms) so the planner can change its speeds for as
+    // long as possible - 0 starts blocks as soon as there is room in the segment buffer
+    uint32_t _blockCommitMs;
+
+#ifdef USE_EVENT_SCHEDULED_STEPPING
+    // Per-step ramp state - times are fixed point event ticks from the start of the block
+    uint64_t _segmentStartFx;
+    uint64_t _nextStepFx;
+    // Current step interval (fixed point event ticks) and remainder from the interval calculation
+    int64_t _stepIntervalFx;
+    int64_t _stepIntervalRest;
+    // Step number in the ramp (from zero speed) - counts down when decelerating
+    int32_t _rampStepN;
+    bool _rampIsDecel;
+    // Limits on the step interval and acceleration in steps per second per second
+    int64_t _minStepIntervalFx;
+    int64_t _maxStepIntervalFx;
+    float _accStepsPerSec2;
+#endif
+
+public:
+    MotionSegmentPreparer()
+    {
+        _blockSeq = MotionSegment::BLOCK_SEQ_NONE;
+        _rampType = RAMP_PER_MS;
+        _oversampleEnabled = false;
+        _blockNotExecutableCount = 0;
+        _blockCommitMs = 0;
+        _pAxesParams = NULL;
+        _useSCurve = false;
+        clear();
+    }
+
+    void clear()
+    {
+        _pBlock = NULL;
+    }
+
+    void setRampType(RampType rampType)
+    {
+        _rampType = rampType;
+    }
+    RampType getRampType()
+    {
+        return _rampType;
+    }
+
+    // Axis parameters for computing the stepping profile of each block when it is started
+    void setAxesParams(AxesParams *pAxesParams, bool useSCurve)
+    {
+        _pAxesParams = pAxesParams;
+        _useSCurve = useSCurve;
+    }
+
+    void setBlockCommitMs(uint32_t blockCommitMs)
+    {
+        _blockCommitMs = blockCommitMs;
+    }
+
+    // Oversampling of the step generator at low rates (not used with per-step ramps)
+    void setOversampleEnabled(bool enabled)
+    {
+        _oversampleEnabled = enabled;
+    }
+
+    uint32_t getBlockNotExecutableCount()
+    {
+        return _blockNotExecutableCount;
+    }
+    void resetBlockNotExecutableCount()
+    {
+        _blockNotExecutableCount = 0;
+    }
+
+    // Fill the segment buffer from the pipeline
+    // abortedBlockSeq is the sequence number of a block the ISR has stopped early (end-stop hit)
+    void prepare(MotionPipeline &motionPipeline, MotionSegmentBuffer &segmentBuffer,
+                 RobotConsts::RawMotionHwInfo_t &rawMotionHwInfo, uint16_t abortedBlockSeq);
+
+private:
+    bool startNextBlock(MotionPipeline &motionPipeline, MotionSegmentBuffer &segmentBuffer,
+                        RobotConsts::RawMotionHwInfo_t &rawMotionHwInfo);
+    void setupEndStops(RobotConsts::RawMotionHwInfo_t &rawMotionHwInfo);
+    void prepareSegment(MotionSegment &segment);
+    uint32_t getOversampleLevel();
+    void updateStepRate();
+    void updateStepRateSCurve();
+#ifdef USE_EVENT_SCHEDULED_STEPPING
+    void startPerStepRamp();
+    void prepareSegmentPerStep(MotionSegment &segment);
+    void updateStepInterval();
+#endif
+};
@@ -0,0 +1,94 @@
+// RBotFirmware
+// Rob Dobson 2016-2018
+
+#include "StepOutputDriver.h"
+
+#if defined(ESP32) && !defined(STEP_OUTPUT_DRIVER_MOCK)
+#define STEP_OUTPUT_USE_GPIO_REGS 1
+#include "soc/gpio_struct.h"
+#endif
+
+#ifdef STEP_OUTPUT_DRIVER_MOCK
+std::vector<StepOutputDriver::MockMaskWrite> StepOutputDriver::_mockWrites;
+#endif
+
+void StepOutputDriver::configure(RobotConsts::RawMotionHwInfo_t &rawMotionHwInfo)
+{
+    clear();
+    for (int axesBits = 0; axesBits < MASK_COMBINATIONS; axesBits++)
+    {
+        for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
+        {
+            RobotConsts::RawMotionAxis_t &axisInfo = rawMotionHwInfo._axis[axisIdx];
+            bool axisBitSet = (axesBits >> axisIdx) & 0x01;
+            // Step pins for axes in the combination
+            if (axisBitSet)
+                addPinToMask(_stepMasks[axesBits], axisInfo._pinStep);
+            // Direction pins to set high or low
+            addPinToMask(axisBitSet ? _dirnSetMasks[axesBits] : _dirnClearMasks[axesBits], axisInfo._pinDirection);
+        }
+    }
+}
+
+void StepOutputDriver::addPinToMask(PinMask &mask, int pin)
+{
+    if (pin < 0)
+        return;
+    if (pin < 32)
+        mask.lo |= (1ul << pin);
+    else if (pin < 40)
+        mask.hi |= (1ul << (pin - 32));
+}
+
+#ifdef STEP_OUTPUT_USE_GPIO_REGS
+
+void IRAM_ATTR StepOutputDriver::writeSet(const PinMask &mask)
+{
+    if (mask.lo)
+        GPIO.out_w1ts = mask.lo;
+    if (mask.hi)
+        GPIO.out1_w1ts.val = mask.hi;
+}
+
+void IRAM_ATTR StepOutputDriver::writeClear(const PinMask &mask)
+{
+    if (mask.lo)
+        GPIO.out_w1tc = mask.lo;
+    if (mask.hi)
+        GPIO.out1_w1tc.val = mask.hi;
+}
+
+#else
+
+// Pin at a time when there is no direct register access
+static void writePinsInMask(const StepOutputDriver::PinMask &mask, int level)
+{
+    for (int pin = 0; pin < 32; pin++)
+        if (mask.lo & (1ul << pin))
+            digitalWrite(pin, level);
+    for (int pin = 32; pin < 40; pin++)
+        if (mask.hi & (1ul << (pin - 32)))
+            digitalWrite(pin, level);
+}
+
+void StepOutputDriver::writeSet(const PinMask &mask)
+{
+    if (!(mask.lo || mask.hi))
+        return;
+#ifdef STEP_OUTPUT_DRIVER_MOCK
+    _mockWrites.push_back({(uint32_t)micros(), true, mask});
+#endif
+    writePinsInMask(mask, 1);
+}
+
+void StepOutputDriver::writeClear(const PinMask &mask)
+{
+    if (!(mask.lo || mask.hi))
+        return;
+#ifdef STEP_OUTPUT_DRIVER_MOCK
+    _mockWrites.push_back({(uint32_t)micros(), false, mask});
+#endif
+    writePinsInMask(mask, 0);
+}
+
+#endif
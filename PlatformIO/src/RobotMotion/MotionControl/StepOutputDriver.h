@@ -0,0 +1,104 @@
+// RBotFirmware
+// Rob Dobson 2016-2018
+
+#pragma once
+
+#include <Arduino.h>
+#include "RobotConsts.h"
+
+// Define STEP_OUTPUT_DRIVER_MOCK to record mask writes (for testing off-target)
+#ifdef STEP_OUTPUT_DRIVER_MOCK
+#include <vector>
+#endif
+
+// Fast output to step and direction pins
+// Pin masks are computed from the raw motion hardware info when configured so that all axes
+// stepping together are set in a single GPIO register write (and cleared in another)
+class StepOutputDriver
+{
+public:
+    // Masks are indexed by a bit-per-axis value so there is one for every combination of axes
+    static constexpr int MASK_COMBINATIONS = 1 << RobotConsts::MAX_AXES;
+    static constexpr uint32_t ALL_AXES = MASK_COMBINATIONS - 1;
+
+    // Mask for GPIO 0..31 and GPIO 32..39
+    struct PinMask
+    {
+        uint32_t lo;
+        uint32_t hi;
+    };
+
+#ifdef STEP_OUTPUT_DRIVER_MOCK
+    struct MockMaskWrite
+    {
+        uint32_t timeUs;
+        bool isSet;
+        PinMask mask;
+    };
+#endif
+
+private:
+    // Step pins for each combination of axes
+    PinMask _stepMasks[MASK_COMBINATIONS];
+    // Direction pins to set and clear for each combination of direction levels
+    PinMask _dirnSetMasks[MASK_COMBINATIONS];
+    PinMask _dirnClearMasks[MASK_COMBINATIONS];
+
+#ifdef STEP_OUTPUT_DRIVER_MOCK
+    static std::vector<MockMaskWrite> _mockWrites;
+#endif
+
+public:
+    StepOutputDriver()
+    {
+        clear();
+    }
+
+    void clear()
+    {
+        for (int i = 0; i < MASK_COMBINATIONS; i++)
+        {
+            _stepMasks[i] = {0, 0};
+            _dirnSetMasks[i] = {0, 0};
+            _dirnClearMasks[i] = {0, 0};
+        }
+    }
+
+    // Compute masks from pin assignments
+    void configure(RobotConsts::RawMotionHwInfo_t &rawMotionHwInfo);
+
+    // Set step pins for axes (bit per axis)
+    void IRAM_ATTR stepStart(uint32_t axesToStep)
+    {
+        writeSet(_stepMasks[axesToStep & ALL_AXES]);
+    }
+
+    // Clear all step pins
+    void IRAM_ATTR stepEnd()
+    {
+        writeClear(_stepMasks[ALL_AXES]);
+    }
+
+    // Set direction pins to levels (bit per axis)
+    void IRAM_ATTR setDirections(uint32_t dirnLevels)
+    {
+        writeSet(_dirnSetMasks[dirnLevels & ALL_AXES]);
+        writeClear(_dirnClearMasks[dirnLevels & ALL_AXES]);
+    }
+
+#ifdef STEP_OUTPUT_DRIVER_MOCK
+    static std::vector<MockMaskWrite> &getMockWrites()
+    {
+        return _mockWrites;
+    }
+    static void clearMockWrites()
+    {
+        _mockWrites.clear();
+    }
+#endif
+
+private:
+    static void addPinToMask(PinMask &mask, int pin);
+    static void IRAM_ATTR writeSet(const PinMask &mask);
+    static void IRAM_ATTR writeClear(const PinMask &mask);
+};
@@ -13,7 +13,7 @@
 #include "Robots/RobotSandTableScara.h"
 #include "Robots/RobotXYBot.h"
 
-RobotController::RobotController()
+RobotController::RobotController(bool isDryRun) : _motionHelper(isDryRun)
 {
     // Init
     _pRobot = NULL;
@@ -142,6 +142,12 @@ bool RobotController::canAcceptCommand()
     return _pRobot->canAcceptCommand();
 }
 
+// Check if all motion is complete
+bool RobotController::isIdle()
+{
+    return _motionHelper.isIdle();
+}
+
 void RobotController::moveTo(RobotCommandArgs& args)
 {
     if (!_pRobot)
@@ -165,6 +171,11 @@ void RobotController::getCurStatus(RobotCommandArgs& args)
     _pRobot->getCurStatus(args);
 }
 
+void RobotController::getPlannedPosition(AxisPosition& plannedPos)
+{
+    _motionHelper.getPlannedPosition(plannedPos);
+}
+
 // Get robot attributes
 void RobotController::getRobotAttributes(String& robotAttrs)
 {
@@ -197,6 +208,31 @@ bool RobotController::wasActiveInLastNSeconds(int nSeconds)
     return _pRobot->wasActiveInLastNSeconds(nSeconds);
 }
 
+void RobotController::getDryRunResult(MotionDryRunResult& result)
+{
+    _motionHelper.getDryRunResult(result);
+}
+
+void RobotController::getMotionStats(String& statsStr)
+{
+    _motionHelper.getMotionStats(statsStr);
+}
+
+void RobotController::resetMotionStats()
+{
+    _motionHelper.resetMotionStats();
+}
+
+String RobotController::getPipelineStatsJSON()
+{
+    return _motionHelper.getPipelineStatsJSON();
+}
+
+String RobotController::getPipelineStatsCSV()
+{
+    return _motionHelper.getPipelineStatsCSV();
+}
+
 String RobotController::getDebugStr()
 {
     return _motionHelper.getDebugStr();
@@ -15,7 +15,8 @@ private:
     MotionHelper _motionHelper;
 
 public:
-    RobotController();
+    // A dry run controller doesn't move the motors - see MotionDryRun
+    RobotController(bool isDryRun = false);
     ~RobotController();
     bool init(const char* configStr);
 
@@ -37,6 +38,9 @@ public:
     // Check if the robot can accept a (motion) command
     bool canAcceptCommand();
 
+    // Check if all motion is complete
+    bool isIdle();
+
     void moveTo(RobotCommandArgs& args);
 
     // Set motion parameters
@@ -45,6 +49,9 @@ public:
     // Get status
     void getCurStatus(RobotCommandArgs& args);
 
+    // Get the position at the end of the last block planned (status has the position reached by the steps executed)
+    void getPlannedPosition(AxisPosition& plannedPos);
+
     // Get robot attributes
     void getRobotAttributes(String& robotAttrs);
 
@@ -56,5 +63,15 @@ public:
 
     bool wasActiveInLastNSeconds(int nSeconds);
 
+    // Result of a dry run
+    void getDryRunResult(MotionDryRunResult& result);
+
+    // Motion ISR timing and pipeline statistics
+    void getMotionStats(String& statsStr);
+    void resetMotionStats();
+    // Pipeline underrun telemetry (as JSON for status and the depth history as CSV)
+    String getPipelineStatsJSON();
+    String getPipelineStatsCSV();
+
     String getDebugStr();
 };
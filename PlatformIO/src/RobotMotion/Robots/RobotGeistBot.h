@@ -36,69 +36,40 @@ public:
         _motionHelper.setTransforms(ptToActuator, actuatorToPt, correctStepOverflow, convertCoords, setRobotAttributes);
     }
 
+    // Azimuth is measured clockwise from North and the arm takes the shortest rotation to reach it
     static bool ptToActuator(AxisFloats& targetPt, AxisFloats& outActuator, AxisPosition& curPos, AxesParams& axesParams, bool allowOutOfBounds)
     {
-        // // Trig for required position (azimuth is measured clockwise from North)
-        // PointND& pt = motionElem._pt2MM;
-        // double reqAlphaRads = atan2(pt._pt[0], pt._pt[1]);
-        // if (reqAlphaRads < 0)
-        //     reqAlphaRads = 2 * M_PI + reqAlphaRads;
-        // double reqLinearMM = sqrt(pt._pt[0] * pt._pt[0] + pt._pt[1] * pt._pt[1]);
-        //
-        // // Log.trace("xyToActuator x %F y %F ax0StNow %d ax1StNow %d rqAlphaD %F rqLinMM %F\n",
-        // //         xy[0], xy[1], axisParams[0]._stepsFromHome, axisParams[1]._stepsFromHome,
-        // //         reqAlphaRads * 180 / M_PI, reqLinearMM);
-        //
-        // // Get current position
-        // PointND axisPosns;
-        // for (int i = 0; i < MAX_AXES; i++)
-        //     axisPosns._pt[i] = axisParams[i]._stepsFromHome;
-        // double currentPolar[NUM_ROBOT_AXES];
-        // actuatorToPolar(axisPosns, currentPolar, axisParams, 2);
-        //
-        // // Calculate shortest azimuth distance
-        // double alphaDiffRads = reqAlphaRads - currentPolar[0];
-        // bool alphaRotateCw = alphaDiffRads > 0;
-        // if (fabs(alphaDiffRads) > M_PI)
-        // {
-        //     alphaDiffRads = 2 * M_PI - fabs(alphaDiffRads);
-        //     alphaRotateCw = !alphaRotateCw;
-        // }
-        // double alphaDiffDegs = fabs(alphaDiffRads) * 180 / M_PI;
-        //
-        // // Linear distance
-        // double linearDiffMM = reqLinearMM - currentPolar[1];
-        //
-        // // Convert to steps - note that to keep the linear position constant the linear stepper needs to step one step in the same
-        // // direction as the arm rotation stepper - so the linear stepper steps required is the sum of the rotation and linear steps
-        // double actuator0Diff = alphaDiffDegs * axisParams[0].stepsPerUnit() * (alphaRotateCw ? 1 : -1);
-        // double actuator1Diff = linearDiffMM * axisParams[1].stepsPerUnit() + actuator0Diff;
-        // actuatorCoords._pt[0] = axisParams[0]._stepsFromHome + actuator0Diff;
-        // actuatorCoords._pt[1] = axisParams[1]._stepsFromHome + actuator1Diff;
-        //
-        // // Log.trace("xyToActuator reqAlphaD %F curAlphaD %F alphaDiffD %F aRotCw %d linDiffMM %F ax0Diff %F ax1Diff %F ax0Tgt %F ax1Tgt %F\n",
-        // //                 reqAlphaRads * 180 / M_PI, currentPolar[0] * 180 / M_PI, alphaDiffDegs, alphaRotateCw,
-        // //                 linearDiffMM, actuator0Diff, actuator1Diff, actuatorCoords[0], actuatorCoords[1]);
-        // //
-        // // Log.trace("bounds check X (En%d) %d, Y (En%d) %d\n", axisParams[1]._minValValid, reqLinearMM < axisParams[1]._minVal,
-        // //             axisParams[1]._maxValValid, reqLinearMM > axisParams[1]._maxVal);
-        //
-        // // Cross check
-        // double checkPolarCoords[NUM_ROBOT_AXES];
-        // actuatorToPolar(actuatorCoords, checkPolarCoords, axisParams, 2);
-        // double checkX = checkPolarCoords[1] * sin(checkPolarCoords[0]);
-        // double checkY = checkPolarCoords[1] * cos(checkPolarCoords[0]);
-        // double checkErr = sqrt((checkX-pt._pt[0]) * (checkX-pt._pt[0]) + (checkY-pt._pt[1]) * (checkY-pt._pt[1]));
-        // if (checkErr > 0.1)
-        //     Log.trace("check reqX %F checkX %F, reqY %F checkY %F, error %F, %s\n", pt._pt[0], checkX, pt._pt[1], checkY,
-        //                     checkErr, (checkErr>0.1) ? "****** FAILED ERROR CHECK" : "");
-        //
-        // // Check machine bounds for linear axis
-        // if (axisParams[1]._minValValid && reqLinearMM < axisParams[1]._minVal)
-        //     return false;
-        // if (axisParams[1]._maxValValid && reqLinearMM > axisParams[1]._maxVal)
-        //     return false;
-        return true;
+        // Required polar position
+        float reqAlphaRads = atan2f(targetPt.getVal(0), targetPt.getVal(1));
+        if (reqAlphaRads < 0)
+            reqAlphaRads += 2 * M_PI;
+        float reqLinearMM = sqrtf(targetPt.getVal(0) * targetPt.getVal(0) + targetPt.getVal(1) * targetPt.getVal(1));
+
+        // Check machine bounds for the linear axis and fix the value if required
+        bool ptWasValid = axesParams.getAxisParamsArray()[1].ptInBounds(reqLinearMM, !allowOutOfBounds);
+
+        // Current polar position
+        AxisFloats curActuator;
+        for (int axisIdx = 0; axisIdx < NUM_ROBOT_AXES; axisIdx++)
+            curActuator.setVal(axisIdx, curPos._stepsFromHome.getVal(axisIdx));
+        float curPolar[NUM_ROBOT_AXES];
+        actuatorToPolar(curActuator, curPolar, axesParams);
+
+        // Shortest azimuth distance
+        float alphaDiffRads = reqAlphaRads - curPolar[0];
+        if (alphaDiffRads > M_PI)
+            alphaDiffRads -= 2 * M_PI;
+        else if (alphaDiffRads < -M_PI)
+            alphaDiffRads += 2 * M_PI;
+        float alphaDiffDegs = alphaDiffRads * 180 / M_PI;
+
+        // Convert to steps - to keep the linear position constant the linear stepper needs to step in the same
+        // direction as the arm rotation stepper so its steps are the sum of the rotation and linear steps
+        float actuator0Diff = alphaDiffDegs * axesParams.getStepsPerUnit(0);
+        float actuator1Diff = (reqLinearMM - curPolar[1]) * axesParams.getStepsPerUnit(1) + actuator0Diff;
+        outActuator.setVal(0, curPos._stepsFromHome.getVal(0) + actuator0Diff);
+        outActuator.setVal(1, curPos._stepsFromHome.getVal(1) + actuator1Diff);
+        return ptWasValid;
     }
 
     static void actuatorToPolar(AxisFloats& actuatorCoords, float polarCoordsAzFirst[], AxesParams& axesParams)
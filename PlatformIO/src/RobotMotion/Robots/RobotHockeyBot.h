@@ -17,49 +17,43 @@ public:
         _motionHelper.setTransforms(ptToActuator, actuatorToPt, correctStepOverflow, convertCoords, setRobotAttributes);
     }
 
+    // The two motors drive a single belt (as a CoreXY) so X is the sum of the motor positions and
+    // Y the difference - axes other than X and Y are driven directly
     static bool ptToActuator(AxisFloats& targetPt, AxisFloats& outActuator, AxisPosition& curPos, AxesParams& axesParams, bool allowOutOfBounds)
     {
-        // // Simple scaling from one domain to another
-        // bool isValid = true;
-        // double aStepper = (motionElem._pt2MM.getVal(0) + motionElem._pt2MM.getVal(1)) * axisParams[0].stepsPerUnit();
-        // actuatorCoords.setVal(0, aStepper);
-        // double bStepper = (motionElem._pt2MM.getVal(0) - motionElem._pt2MM.getVal(1)) * axisParams[1].stepsPerUnit();
-        // actuatorCoords.setVal(1, bStepper);
-        //
-        //
-        //     // Check machine bounds
-        //     // bool thisAxisValid = true;
-        //     // if (axisParams[i]._minValValid && motionElem._pt2MM.getVal(i) < axisParams[i]._minVal)
-        //     //     thisAxisValid = false;
-        //     // if (axisParams[i]._maxValValid && motionElem._pt2MM.getVal(i) > axisParams[i]._maxVal)
-        //     //     thisAxisValid = false;
-        // bool axis0Valid = true;
-        // bool axis1Valid = true;
-        // Log.trace("ptToActuator X (%s) %F -> %F Y (%s) %F -> %F\n",
-        //     axis0Valid ? "OK" : "INVALID",
-        //     motionElem._pt2MM.getVal(0), actuatorCoords._pt[0],
-        //     axis1Valid ? "OK" : "INVALID",
-        //     motionElem._pt2MM.getVal(1), actuatorCoords._pt[1]);
-        //     // isValid &&= thisAxisValid;
-        // // }
-        return true;
+        // Check machine bounds and fix the value if required
+        bool ptWasValid = axesParams.ptInBounds(targetPt, !allowOutOfBounds);
+
+        // Axis vals from home point
+        AxisFloats fromHome;
+        for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
+            fromHome.setVal(axisIdx, targetPt.getVal(axisIdx) - axesParams.getHomeOffsetVal(axisIdx));
+
+        // Perform conversion and add offset to home in steps
+        outActuator.setVal(0, (fromHome.getVal(0) + fromHome.getVal(1)) * axesParams.getStepsPerUnit(0));
+        outActuator.setVal(1, (fromHome.getVal(0) - fromHome.getVal(1)) * axesParams.getStepsPerUnit(1));
+        for (int axisIdx = 2; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
+            outActuator.setVal(axisIdx, fromHome.getVal(axisIdx) * axesParams.getStepsPerUnit(axisIdx));
+        for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
+            outActuator.setVal(axisIdx, outActuator.getVal(axisIdx) + axesParams.gethomeOffSteps(axisIdx));
+        return ptWasValid;
     }
 
     static void actuatorToPt(AxisFloats& targetActuator, AxisFloats& outPt, AxisPosition& curPos, AxesParams& axesParams)
     {
-        // double x = (actuatorCoords.getVal(0) + actuatorCoords.getVal(1)) / 2 / axisParams[0].stepsPerUnit();
-        // double y = (actuatorCoords.getVal(0) - actuatorCoords.getVal(1)) / 2 / axisParams[1].stepsPerUnit();
-        //
-        //     // if (axisParams[i]._minValValid && ptVal < axisParams[i]._minVal)
-        //     //     ptVal = axisParams[i]._minVal;
-        //     // if (axisParams[i]._maxValValid && ptVal > axisParams[i]._maxVal)
-        //     //     ptVal = axisParams[i]._maxVal;
-        // pt.setVal(0, x);
-        // pt.setVal(1, y);
-        //
-        // Log.trace("actuatorToPt 0 %F -> %F (perunit %F) 1 %F -> %F (perunit %F)\n",
-        //         actuatorCoords.getVal(0), x, axisParams[0].stepsPerUnit(),
-        //         actuatorCoords.getVal(1), y, axisParams[1].stepsPerUnit());
+        // Actuator vals from home in steps
+        AxisFloats fromHome;
+        for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
+            fromHome.setVal(axisIdx, (targetActuator.getVal(axisIdx) - axesParams.gethomeOffSteps(axisIdx)) /
+                            axesParams.getStepsPerUnit(axisIdx));
+
+        // Perform conversion and add the home point
+        outPt.setVal(0, (fromHome.getVal(0) + fromHome.getVal(1)) / 2);
+        outPt.setVal(1, (fromHome.getVal(0) - fromHome.getVal(1)) / 2);
+        for (int axisIdx = 2; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
+            outPt.setVal(axisIdx, fromHome.getVal(axisIdx));
+        for (int axisIdx = 0; axisIdx < RobotConsts::MAX_AXES; axisIdx++)
+            outPt.setVal(axisIdx, outPt.getVal(axisIdx) + axesParams.getHomeOffsetVal(axisIdx));
     }
 
     static void correctStepOverflow(AxisPosition& curPos, AxesParams& axesParams)
@@ -5,6 +5,7 @@
 #include "RobotSandTableScara.h"
 #include "../MotionControl/MotionHelper.h"
 #include "Utils.h"
+#include "FastTrig.h"
 #include "math.h"
 
 static const char* MODULE_PREFIX = "SandTableScara: ";
@@ -22,6 +23,7 @@ RobotSandTableScara::RobotSandTableScara(const char* pRobotTypeName, MotionHelpe
 {
     // Set transforms
     _motionHelper.setTransforms(ptToActuator, actuatorToPt, correctStepOverflow, convertCoords, setRobotAttributes);
+    _motionHelper.setBatchTransforms(ptsToActuatorBatch, ptToActuatorFromBatch);
 }
 
 RobotSandTableScara::~RobotSandTableScara()
@@ -31,6 +33,51 @@ RobotSandTableScara::~RobotSandTableScara()
 // Convert a cartesian point to actuator coordinates
 bool RobotSandTableScara::ptToActuator(AxisFloats& targetPt, AxisFloats& outActuator, 
             AxisPosition& curAxisPositions, AxesParams& axesParams, bool allowOutOfBounds)
+{
+    // Convert the target cartesian coords to polar wrapped to 0..360 degrees (not needed close to the origin)
+    AxisFloats soln1, soln2;
+    bool isValid = true;
+    if (!isNearOrigin(targetPt))
+        isValid = cartesianToPolar(targetPt, soln1, soln2, axesParams);
+    return polarToActuator(targetPt, soln1, soln2, isValid, outActuator, curAxisPositions, axesParams, allowOutOfBounds);
+}
+
+// Convert the points in a batch to both polar solutions
+// _vals[0..1] are alpha and beta of solution 1 and _vals[2..3] of solution 2
+void RobotSandTableScara::ptsToActuatorBatch(KinematicsBatch& batch, AxesParams& axesParams)
+{
+    float shoulderElbowMM = 0, elbowHandMM = 0;
+    getArmLengths(axesParams, shoulderElbowMM, elbowHandMM);
+    bool useFastTrig = axesParams.isFastKinematics();
+    if (batch._hasPolar)
+    {
+        for (int i = 0; i < batch._numPts; i++)
+        {
+            batch._valid[i] = polarToArmAngles(batch._ptAngleRads[i], batch._ptRadiusMM[i], shoulderElbowMM, elbowHandMM,
+                        useFastTrig, batch._vals[0][i], batch._vals[1][i], batch._vals[2][i], batch._vals[3][i]);
+        }
+        return;
+    }
+    for (int i = 0; i < batch._numPts; i++)
+    {
+        batch._valid[i] = cartesianToPolar(batch._ptX[i], batch._ptY[i], shoulderElbowMM, elbowHandMM, useFastTrig,
+                    batch._vals[0][i], batch._vals[1][i], batch._vals[2][i], batch._vals[3][i]);
+    }
+}
+
+// Convert a point in a batch to actuator coordinates - same result as ptToActuator
+bool RobotSandTableScara::ptToActuatorFromBatch(KinematicsBatch& batch, int ptIdx, AxisFloats& targetPt, AxisFloats& outActuator,
+            AxisPosition& curAxisPositions, AxesParams& axesParams, bool allowOutOfBounds)
+{
+    AxisFloats soln1, soln2;
+    soln1.set(batch._vals[0][ptIdx], batch._vals[1][ptIdx]);
+    soln2.set(batch._vals[2][ptIdx], batch._vals[3][ptIdx]);
+    return polarToActuator(targetPt, soln1, soln2, batch._valid[ptIdx], outActuator, curAxisPositions, axesParams, allowOutOfBounds);
+}
+
+// Choose the polar solution with least rotation from the current position and convert to actuator coordinates
+bool RobotSandTableScara::polarToActuator(AxisFloats& targetPt, AxisFloats& soln1, AxisFloats& soln2, bool isValid,
+            AxisFloats& outActuator, AxisPosition& curAxisPositions, AxesParams& axesParams, bool allowOutOfBounds)
 {
     // Convert the current position to polar wrapped 0..360 degrees
     AxisFloats curPolar;
@@ -40,7 +87,7 @@ bool RobotSandTableScara::ptToActuator(AxisFloats& targetPt, AxisFloats& outActu
     AxisFloats relativePolarSolution;
 
 	// Check for points close to the origin
-	if (AxisUtils::isApprox(targetPt._pt[0], 0, 1) && (AxisUtils::isApprox(targetPt._pt[1], 0, 1)))
+	if (isNearOrigin(targetPt))
 	{
 		// Special case
 		// Log.trace("%sptToActuator x %F y %F close to origin\n", MODULE_PREFIX, targetPt._pt[0], targetPt._pt[1]);
@@ -51,9 +98,6 @@ bool RobotSandTableScara::ptToActuator(AxisFloats& targetPt, AxisFloats& outActu
 	}
     else
     {
-        // Convert the target cartesian coords to polar wrapped to 0..360 degrees
-        AxisFloats soln1, soln2;
-        bool isValid = cartesianToPolar(targetPt, soln1, soln2, axesParams);
         if ((!isValid) && (!allowOutOfBounds))
         {
             Log.verbose("%sOut of bounds not allowed\n", MODULE_PREFIX);
@@ -67,7 +111,7 @@ bool RobotSandTableScara::ptToActuator(AxisFloats& targetPt, AxisFloats& outActu
         float b2Rel = calcRelativePolar(soln2.getVal(1), curPolar.getVal(1));
 
         // Which solution involves least overall rotation
-        if (abs(a1Rel) + abs(b1Rel) <= abs(a2Rel) + abs(b2Rel))
+        if (fabsf(a1Rel) + fabsf(b1Rel) <= fabsf(a2Rel) + fabsf(b2Rel))
         {
             relativePolarSolution.setVal(0, a1Rel);
             relativePolarSolution.setVal(1, b1Rel);
@@ -94,28 +138,51 @@ bool RobotSandTableScara::ptToActuator(AxisFloats& targetPt, AxisFloats& outActu
     return true;
 }
 
+// Convert actuator coordinates (steps) to a cartesian point - the end of the lower arm from the arm angles
 void RobotSandTableScara::actuatorToPt(AxisFloats& actuatorPos, AxisFloats& outPt, AxisPosition& curPos, AxesParams& axesParams)
 {
-    // Not currently used so unimplemented
+    AxisInt32s actuatorSteps;
+    for (int axisIdx = 0; axisIdx < NUM_ROBOT_AXES; axisIdx++)
+        actuatorSteps.setVal(axisIdx, int32_t(roundf(actuatorPos.getVal(axisIdx))));
+    AxisFloats polarDegrees;
+    stepsToPolar(actuatorSteps, polarDegrees, axesParams);
+
+    // Angles are clockwise from North so X is from the sine and Y from the cosine
+    float shoulderElbowMM = 0, elbowHandMM = 0;
+    getArmLengths(axesParams, shoulderElbowMM, elbowHandMM);
+    float alphaRads = AxisUtils::d2r(polarDegrees.getVal(0));
+    float betaRads = AxisUtils::d2r(polarDegrees.getVal(1));
+    outPt.setVal(0, shoulderElbowMM * sinf(alphaRads) + elbowHandMM * sinf(betaRads));
+    outPt.setVal(1, shoulderElbowMM * cosf(alphaRads) + elbowHandMM * cosf(betaRads));
 }
 
 void RobotSandTableScara::correctStepOverflow(AxisPosition& curPos, AxesParams& axesParams)
 {
     // Since the robot is polar each stepper can be considered to have a value between
-    // 0 and the stepsPerRot
+    // 0 and the stepsPerRot (any number of rotations either way - e.g. the steps executed)
     int32_t stepsPerRot0 = int32_t(roundf(axesParams.getStepsPerRot(0)));
-    curPos._stepsFromHome.setVal(0, (curPos._stepsFromHome.getVal(0) + stepsPerRot0) % stepsPerRot0);
+    curPos._stepsFromHome.setVal(0, (curPos._stepsFromHome.getVal(0) % stepsPerRot0 + stepsPerRot0) % stepsPerRot0);
     int32_t stepsPerRot1 = int32_t(roundf(axesParams.getStepsPerRot(1)));
-    curPos._stepsFromHome.setVal(1, (curPos._stepsFromHome.getVal(1) + stepsPerRot1) % stepsPerRot1);
+    curPos._stepsFromHome.setVal(1, (curPos._stepsFromHome.getVal(1) % stepsPerRot1 + stepsPerRot1) % stepsPerRot1);
 }
 
 bool RobotSandTableScara::cartesianToPolar(AxisFloats& targetPt, AxisFloats& targetSoln1, 
                     AxisFloats& targetSoln2, AxesParams& axesParams)
 {
-	// Calculate arm lengths
+	float shoulderElbowMM = 0, elbowHandMM = 0;
+	getArmLengths(axesParams, shoulderElbowMM, elbowHandMM);
+	float alpha1 = 0, beta1 = 0, alpha2 = 0, beta2 = 0;
+	bool posValid = cartesianToPolar(targetPt._pt[0], targetPt._pt[1], shoulderElbowMM, elbowHandMM,
+	                    axesParams.isFastKinematics(), alpha1, beta1, alpha2, beta2);
+	targetSoln1.set(alpha1, beta1);
+	targetSoln2.set(alpha2, beta2);
+	return posValid;
+}
+
+void RobotSandTableScara::getArmLengths(AxesParams& axesParams, float& shoulderElbowMM, float& elbowHandMM)
+{
 	// The maxVal for axis0 and axis1 are used to determine the arm lengths
 	// The radius of the machine is the sum of these two lengths
-	float shoulderElbowMM = 0, elbowHandMM = 0;
 	bool axis0MaxValid = axesParams.getMaxVal(0, shoulderElbowMM);
 	bool axis1MaxValid = axesParams.getMaxVal(1, elbowHandMM);
     // If not valid set to some values to avoid arithmetic errors
@@ -123,48 +190,6 @@ bool RobotSandTableScara::cartesianToPolar(AxisFloats& targetPt, AxisFloats& tar
 		shoulderElbowMM = 100;
 	if (!axis1MaxValid)
 		elbowHandMM = 100;
-
-	// Calculate distance from origin to pt (forms one side of triangle where arm segments form other sides)
-	float thirdSideL3MM = sqrt(pow(targetPt._pt[0], 2) + pow(targetPt._pt[1], 2));
-
-	// Check validity of position
-	bool posValid = thirdSideL3MM <= shoulderElbowMM + elbowHandMM;
-
-	// Calculate angle from North to the point (note in atan2 X and Y are flipped from normal as angles are clockwise)
-	float delta1 = atan2(targetPt._pt[0], targetPt._pt[1]);
-	if (delta1 < 0)
-		delta1 += M_PI * 2;
-
-	// Calculate angle of triangle opposite elbow-hand side
-	float delta2 = AxisUtils::cosineRule(thirdSideL3MM, shoulderElbowMM, elbowHandMM);
-
-	// Calculate angle of triangle opposite third side
-	float innerAngleOppThirdGamma = AxisUtils::cosineRule(shoulderElbowMM, elbowHandMM, thirdSideL3MM);
-
-	// The two pairs of angles that solve these equations
-	// alpha is the angle from shoulder to elbow
-	// beta is angle from elbow to hand
-	float alpha1rads = delta1 - delta2;
-	float beta1rads = alpha1rads - innerAngleOppThirdGamma + M_PI;
-	float alpha2rads = delta1 + delta2;
-	float beta2rads = alpha2rads + innerAngleOppThirdGamma - M_PI;
-
-	// Calculate the alpha and beta angles in degrees
-	targetSoln1.setVal(0, AxisUtils::r2d(AxisUtils::wrapRadians(alpha1rads + 2 * M_PI)));
-	targetSoln1.setVal(1, AxisUtils::r2d(AxisUtils::wrapRadians(beta1rads + 2 * M_PI)));
-	targetSoln2.setVal(0, AxisUtils::r2d(AxisUtils::wrapRadians(alpha2rads + 2 * M_PI)));
-	targetSoln2.setVal(1, AxisUtils::r2d(AxisUtils::wrapRadians(beta2rads + 2 * M_PI)));
-
-    // Log.trace("%scartesianToPolar target X%F Y%F l1 %F, l2 %F\n", MODULE_PREFIX,
-    //                 targetPt.getVal(0), targetPt.getVal(1),
-    //                  shoulderElbowMM, elbowHandMM);	
-    // Log.trace("%scartesianToPolar %s 3rdSide %Fmm D1 %Fd D2 %Fd innerAng %Fd\n", MODULE_PREFIX,
-	// 	posValid ? "ok" : "OUT_OF_BOUNDS",
-	// 	thirdSideL3MM, AxisUtils::r2d(delta1), AxisUtils::r2d(delta2), AxisUtils::r2d(innerAngleOppThirdGamma));
-	// Log.trace("%scartesianToActuator alpha1 %Fd, beta1 %Fd\n", MODULE_PREFIX,
-	// 	targetSoln1.getVal(0), targetSoln1.getVal(1));
-
-    return posValid;
 }
 
 void RobotSandTableScara::stepsToPolar(AxisInt32s& actuatorCoords, AxisFloats& rotationDegrees, AxesParams& axesParams)
@@ -172,8 +197,8 @@ void RobotSandTableScara::stepsToPolar(AxisInt32s& actuatorCoords, AxisFloats& r
     // Axis 0 positive steps clockwise, axis 1 postive steps are anticlockwise
     // Axis 0 zero steps is at 0 degrees, axis 1 zero steps is at 180 degrees
     // All angles returned are in degrees clockwise from North
-    double axis0Degrees = AxisUtils::wrapDegrees(actuatorCoords.getVal(0) * 360 / axesParams.getStepsPerRot(0));
-    double axis1Degrees = AxisUtils::wrapDegrees(540 - (actuatorCoords.getVal(1) * 360 / axesParams.getStepsPerRot(1)));
+    float axis0Degrees = AxisUtils::wrapDegrees(actuatorCoords.getVal(0) * 360.0f / axesParams.getStepsPerRot(0));
+    float axis1Degrees = AxisUtils::wrapDegrees(540.0f - (actuatorCoords.getVal(1) * 360.0f / axesParams.getStepsPerRot(1)));
     rotationDegrees.set(axis0Degrees, axis1Degrees);
     // Log.trace("%sstepsToPolar: ax0Steps %d ax1Steps %d a %Fd b %Fd\n", MODULE_PREFIX,
     //         actuatorCoords.getVal(0), actuatorCoords.getVal(1), rotationDegrees._pt[0], rotationDegrees._pt[1]);
@@ -198,14 +223,15 @@ float RobotSandTableScara::calcRelativePolar(float targetRotation, float curRota
 void RobotSandTableScara::relativePolarToSteps(AxisFloats& relativePolar, AxisPosition& curAxisPositions, 
             AxisFloats& outActuator, AxesParams& axesParams)
 {
-    // Convert relative polar to steps
-    int32_t stepsRel0 = int32_t(roundf(relativePolar.getVal(0) * axesParams.getStepsPerRot(0) / 360));
-    int32_t stepsRel1 = int32_t(roundf(-relativePolar.getVal(1) * axesParams.getStepsPerRot(1) / 360));
+    // Convert relative polar to steps - left unrounded (the planner rounds to whole steps) so that
+    // the direction of a short move in actuator space isn't distorted
+    float stepsRel0 = relativePolar.getVal(0) * axesParams.getStepsPerRot(0) / 360;
+    float stepsRel1 = -relativePolar.getVal(1) * axesParams.getStepsPerRot(1) / 360;
 
     // Add to existing
     outActuator.setVal(0, curAxisPositions._stepsFromHome.getVal(0) + stepsRel0);
     outActuator.setVal(1, curAxisPositions._stepsFromHome.getVal(1) + stepsRel1);
-    // Log.trace("%srelativePolarToSteps: stepsRel0 %d stepsRel1 %d curSteps0 %d curSteps1 %d destSteps0 %F destSteps1 %F\n",
+    // Log.trace("%srelativePolarToSteps: stepsRel0 %F stepsRel1 %F curSteps0 %d curSteps1 %d destSteps0 %F destSteps1 %F\n",
     //         MODULE_PREFIX,
     //         stepsRel0, stepsRel1, curAxisPositions._stepsFromHome.getVal(0), curAxisPositions._stepsFromHome.getVal(1),
     //         outActuator.getVal(0), outActuator.getVal(1));
@@ -226,8 +252,8 @@ void RobotSandTableScara::convertCoords(RobotCommandArgs& cmdArgs, AxesParams& a
             float theta = cmdArgs.getValCoordUnits(0);
             float rho = cmdArgs.getValCoordUnits(1);
             // Calculate coords
-            float xVal = sin(theta) * rho * radius;
-            float yVal = cos(theta) * rho * radius;
+            float xVal = sinf(theta) * rho * radius;
+            float yVal = cosf(theta) * rho * radius;
             cmdArgs.setAxisValMM(0, xVal, true);
             cmdArgs.setAxisValMM(1, yVal, true);
             Log.verbose("%sconvertCoords theta %F rho %F -> x %F y %F\n", MODULE_PREFIX,
@@ -4,6 +4,10 @@
 #pragma once
 
 #include "RobotBase.h"
+#include "AxisValues.h"
+#include "FastTrig.h"
+#include "../MotionControl/KinematicsBatch.h"
+#include <math.h>
 
 class AxisFloats;
 class AxisPosition;
@@ -32,7 +36,7 @@ public:
     RobotSandTableScara(const char* pRobotTypeName, MotionHelper& motionHelper);
     ~RobotSandTableScara();
 
-private:
+    // Transforms (public so that the kinematics can be tested on their own)
 
     // Convert a cartesian point to actuator coordinates
     static bool ptToActuator(AxisFloats& targetPt, AxisFloats& outActuator, 
@@ -51,9 +55,76 @@ private:
     // Set robot attributes
     static void setRobotAttributes(AxesParams& axesParams, String& robotAttributes);
 
-private:
+    // Batch versions of ptToActuator (points of split-up moves) - for theta-rho moves the batch
+    // has the polar coords of the points which are used directly
+    static void ptsToActuatorBatch(KinematicsBatch& batch, AxesParams& axesParams);
+    static bool ptToActuatorFromBatch(KinematicsBatch& batch, int ptIdx, AxisFloats& targetPt, AxisFloats& outActuator,
+                AxisPosition& curPos, AxesParams& axesParams, bool allowOutOfBounds);
+
+    // Cartesian to polar - both solutions in degrees clockwise from North
     static bool cartesianToPolar(AxisFloats& targetPt, AxisFloats& targetSoln1, 
                     AxisFloats& targetSoln2, AxesParams& axesParams);
+
+    // Cartesian to polar for arm lengths l1 (shoulder-elbow) and l2 (elbow-hand)
+    // Inline so that it is compiled into the batch loop
+    static inline bool cartesianToPolar(float x, float y, float l1, float l2, bool useFastTrig,
+                    float& alpha1, float& beta1, float& alpha2, float& beta2)
+    {
+        // Calculate distance from origin to pt (forms one side of triangle where arm segments form other sides)
+        float thirdSideL3MM = sqrtf(x * x + y * y);
+
+        // Calculate angle from North to the point (note in atan2 X and Y are flipped from normal as angles are clockwise)
+        float delta1 = useFastTrig ? FastTrig::atan2(x, y) : atan2f(x, y);
+        if (delta1 < 0)
+            delta1 += AxisUtils::TWO_PI_F;
+        return polarToArmAngles(delta1, thirdSideL3MM, l1, l2, useFastTrig, alpha1, beta1, alpha2, beta2);
+    }
+
+    // Point in polar coords (angle clockwise from North, distance from the centre) to arm angles
+    static inline bool polarToArmAngles(float delta1, float thirdSideL3MM, float l1, float l2, bool useFastTrig,
+                    float& alpha1, float& beta1, float& alpha2, float& beta2)
+    {
+        // All of this is single precision (double is emulated in software on the ESP32) - the angles
+        // are within 0.001 degrees of a double calculation except very near the centre or the edge where
+        // acos is ill-conditioned (see AxisUtils and Tests/TestScaraKinematics)
+        // With fastKinematics the trig is polynomial approximations which add less than FastTrig::MAX_ERR_RADS
+        // to alpha and 3 times that to beta
+
+        // Check validity of position
+        bool posValid = thirdSideL3MM <= l1 + l2;
+
+        // Calculate angle of triangle opposite elbow-hand side
+        float delta2 = useFastTrig ? AxisUtils::cosineRuleFast(thirdSideL3MM, l1, l2) :
+                                     AxisUtils::cosineRule(thirdSideL3MM, l1, l2);
+
+        // Calculate angle of triangle opposite third side
+        float innerAngleOppThirdGamma = useFastTrig ? AxisUtils::cosineRuleFast(l1, l2, thirdSideL3MM) :
+                                                      AxisUtils::cosineRule(l1, l2, thirdSideL3MM);
+
+        // The two pairs of angles that solve these equations
+        // alpha is the angle from shoulder to elbow
+        // beta is angle from elbow to hand
+        float alpha1rads = delta1 - delta2;
+        float beta1rads = alpha1rads - innerAngleOppThirdGamma + AxisUtils::PI_F;
+        float alpha2rads = delta1 + delta2;
+        float beta2rads = alpha2rads + innerAngleOppThirdGamma - AxisUtils::PI_F;
+
+        // Calculate the alpha and beta angles in degrees
+        alpha1 = AxisUtils::r2d(AxisUtils::wrapRadians(alpha1rads));
+        beta1 = AxisUtils::r2d(AxisUtils::wrapRadians(beta1rads));
+        alpha2 = AxisUtils::r2d(AxisUtils::wrapRadians(alpha2rads));
+        beta2 = AxisUtils::r2d(AxisUtils::wrapRadians(beta2rads));
+        return posValid;
+    }
+
+private:
+    static void getArmLengths(AxesParams& axesParams, float& shoulderElbowMM, float& elbowHandMM);
+    static bool isNearOrigin(AxisFloats& targetPt)
+    {
+        return AxisUtils::isApprox(targetPt._pt[0], 0, 1) && AxisUtils::isApprox(targetPt._pt[1], 0, 1);
+    }
+    static bool polarToActuator(AxisFloats& targetPt, AxisFloats& soln1, AxisFloats& soln2, bool isValid,
+            AxisFloats& outActuator, AxisPosition& curAxisPositions, AxesParams& axesParams, bool allowOutOfBounds);
     static void stepsToPolar(AxisInt32s& actuatorCoords, AxisFloats& rotationDegrees, AxesParams& axesParams);
     static float calcRelativePolar(float targetRotation, float curRotation);
     static void relativePolarToSteps(AxisFloats& relativePolar, AxisPosition& curAxisPositions, 
@@ -44,8 +44,6 @@ void RobotXYBot::actuatorToPt(AxisFloats& targetActuator, AxisFloats& outPt,
         float ptVal = targetActuator.getVal(axisIdx) - axesParams.gethomeOffSteps(axisIdx);
         ptVal = ptVal / axesParams.getStepsPerUnit(axisIdx) + axesParams.getHomeOffsetVal(axisIdx);
         outPt.setVal(axisIdx, ptVal);
-        Log.trace("actuatorToPt %d %F -> %F (perunit %F)\n", axisIdx, targetActuator.getVal(axisIdx),
-                        ptVal, axesParams.getStepsPerUnit(axisIdx));
     }
 }
 
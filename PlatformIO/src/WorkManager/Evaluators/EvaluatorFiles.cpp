@@ -5,7 +5,7 @@
 #include <ArduinoLog.h>
 #include "EvaluatorFiles.h"
 #include "RdJson.h"
-#include "../WorkManager.h"
+#include "../WorkItemSink.h"
 
 static const char* MODULE_PREFIX = "EvaluatorFiles: ";
 
@@ -81,21 +81,21 @@ bool EvaluatorFiles::execWorkItem(WorkItem& workItem)
     return retc;
 }
 
-void EvaluatorFiles::service(WorkManager* pWorkManager)
+void EvaluatorFiles::service(WorkItemSink* pWorkItemSink)
 {
     // Check in progress
     if (!_inProgress)
         return;
 
     // See if we can add to the queue
-    if (!pWorkManager->canAcceptWorkItem())
+    if (!pWorkItemSink->canAcceptWorkItem())
         return;
 
     // If the file type is not pure GCODE then
     // only add to the queue if the queue is completely empty
     if (_fileType != FILE_TYPE_GCODE)
     {
-        if (!pWorkManager->queueIsEmpty())
+        if (!pWorkItemSink->queueIsEmpty())
             return;
     }
 
@@ -112,39 +112,13 @@ void EvaluatorFiles::service(WorkManager* pWorkManager)
     {
         // Process the line
         String newLine = (char*)pLine;
-        newLine.replace("\n", "");
-        newLine.replace("\r", "");
-        newLine.trim();
-        bool isComment = false;
-        if (_fileType == FILE_TYPE_THETA_RHO)
-            isComment = newLine.startsWith("#");
-        else if (_fileType == FILE_TYPE_GCODE)
-            isComment = newLine.startsWith(";");
-        if (!isComment)
+        if (formLine(newLine, _fileType, _firstValidLineProcessed))
         {
-            bool isValid = true;
-            // Format line if Theta-Rho
-            if (_fileType == FILE_TYPE_THETA_RHO)
-            {
-                int spacePos = newLine.indexOf(" ");
-                if (spacePos > 0)
-                {
-                    newLine = (!_firstValidLineProcessed ? "_THRLINE0_/" : "_THRLINEN_/") + newLine.substring(0,spacePos) + "/" + newLine.substring(spacePos+1);
-                }
-                else
-                {
-                    isValid = false;
-                }
-            }
-            // Form the work item if valid
-            if (isValid)
-            {
-                Log.verbose("%sservice new line %s\n", MODULE_PREFIX, newLine.c_str());
-                String retStr;
-                WorkItem workItem(newLine.c_str());
-                pWorkManager->addWorkItem(workItem, retStr);
-                _firstValidLineProcessed = true;
-            }
+            Log.verbose("%sservice new line %s\n", MODULE_PREFIX, newLine.c_str());
+            String retStr;
+            WorkItem workItem(newLine.c_str());
+            pWorkItemSink->addWorkItem(workItem, retStr);
+            _firstValidLineProcessed = true;
         }
     }
 
@@ -158,6 +132,28 @@ void EvaluatorFiles::service(WorkManager* pWorkManager)
 
 }
 
+// Form a work item from a line of a file - returns false if the line is a comment or invalid
+bool EvaluatorFiles::formLine(String& line, int fileType, bool firstValidLineProcessed)
+{
+    line.replace("\n", "");
+    line.replace("\r", "");
+    line.trim();
+    if (fileType == FILE_TYPE_THETA_RHO)
+    {
+        if (line.startsWith("#"))
+            return false;
+        // Format line if Theta-Rho
+        int spacePos = line.indexOf(" ");
+        if (spacePos <= 0)
+            return false;
+        line = (!firstValidLineProcessed ? "_THRLINE0_/" : "_THRLINEN_/") + line.substring(0,spacePos) + "/" + line.substring(spacePos+1);
+        return true;
+    }
+    if (fileType == FILE_TYPE_GCODE)
+        return !line.startsWith(";");
+    return true;
+}
+
 void EvaluatorFiles::stop()
 {
     _inProgress = false;
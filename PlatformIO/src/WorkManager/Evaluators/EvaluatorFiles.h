@@ -5,7 +5,7 @@
 
 #include "FileManager.h"
 
-class WorkManager;
+class WorkItemSink;
 class WorkItem;
 
 class EvaluatorFiles
@@ -27,7 +27,7 @@ public:
     bool execWorkItem(WorkItem& workItem);
 
     // Call frequently
-    void service(WorkManager* pWorkManager);
+    void service(WorkItemSink* pWorkItemSink);
 
     // Control
     void stop();
@@ -38,6 +38,12 @@ public:
         FILE_TYPE_GCODE,
         FILE_TYPE_THETA_RHO
     };
+
+    // File type from the file name
+    static int getFileTypeFromExtension(String& fileName);
+
+    // Form a work item from a line of a file - returns false if the line is a comment or invalid
+    static bool formLine(String& line, int fileType, bool firstValidLineProcessed);
     
 private:
     // Filename in progress
@@ -51,8 +57,4 @@ private:
 
     // Start of file handling
     bool _firstValidLineProcessed;
-
-private:
-    int getFileTypeFromExtension(String& fileName);
-
 };
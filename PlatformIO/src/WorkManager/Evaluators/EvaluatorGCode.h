@@ -67,7 +67,22 @@ public:
                     cmdArgs.setFeedrate(strtod(++pStr, &pEndStr));
                     pStr = pEndStr;
                     break;
+                case 'I':
+                    cmdArgs.setArcCentreOffset(0, strtod(++pStr, &pEndStr));
+                    pStr = pEndStr;
+                    break;
+                case 'J':
+                    cmdArgs.setArcCentreOffset(1, strtod(++pStr, &pEndStr));
+                    pStr = pEndStr;
+                    break;
                 case 'R':
+                    // R followed by a value is an arc radius - otherwise relative motion
+                    if (isdigit(*(pStr + 1)) || (*(pStr + 1) == '-') || (*(pStr + 1) == '.'))
+                    {
+                        cmdArgs.setArcRadius(strtod(++pStr, &pEndStr));
+                        pStr = pEndStr;
+                        break;
+                    }
                     cmdArgs.setMoveType(RobotMoveTypeArg_Relative);
                     pStr++;
                     break;
@@ -106,6 +121,8 @@ public:
         // Check for Theta-Rho values
         if (isThetaValid && isRhoValid)
         {
+            // Theta in a long pattern can be many turns so it is wrapped before it is stored as a float
+            thetaVal -= 2 * M_PI * floor(thetaVal / (2 * M_PI));
             cmdArgs.setAxisValThetaRho(0, thetaVal, true);
             cmdArgs.setAxisValThetaRho(1, rhoVal, true);
         }
@@ -145,6 +162,14 @@ public:
                     pRobotController->moveTo(cmdArgs);
                 }
                 return true;
+            case 2: // Arc clockwise
+            case 3: // Arc anticlockwise
+                if (takeAction)
+                {
+                    cmdArgs.setArc(cmdNum == 2);
+                    pRobotController->moveTo(cmdArgs);
+                }
+                return true;
             case 6: // Direct stepper move
                 if (takeAction)
                 {
@@ -3,8 +3,11 @@
 
 // #define DEBUG_EVALUATOR_PATTERN 1
 
+#include <ArduinoLog.h>
 #include "EvaluatorPatterns.h"
-#include "../WorkManager.h"
+#include "RdJson.h"
+#include "FileManager.h"
+#include "../WorkItemSink.h"
 
 static const char* MODULE_PREFIX = "EvaluatorPatterns: ";
 
@@ -176,14 +179,14 @@ void EvaluatorPatterns::stop()
     _isRunning = false;
 }
 
-void EvaluatorPatterns::service(WorkManager* pWorkManager)
+void EvaluatorPatterns::service(WorkItemSink* pWorkItemSink)
 {
     // Check running
     if (!_isRunning)
         return;
 
     // Check if the work manager can accept new stuff
-    if (!pWorkManager->canAcceptWorkItem())
+    if (!pWorkItemSink->canAcceptWorkItem())
         return;
 
     // Evaluate expressions
@@ -203,7 +206,7 @@ void EvaluatorPatterns::service(WorkManager* pWorkManager)
     // Log.verbose("%scmdInterp %s\n", MODULE_PREFIX, cmdStr);
     String retStr;
     WorkItem workItem(cmdStr);
-    pWorkManager->addWorkItem(workItem, retStr);
+    pWorkItemSink->addWorkItem(workItem, retStr);
 
     // Check if we reached a limit
     bool stopReqd = 0;
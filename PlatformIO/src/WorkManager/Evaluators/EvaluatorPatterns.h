@@ -8,7 +8,7 @@
 #include <vector>
 #include "AxisValues.h"
 
-class WorkManager;
+class WorkItemSink;
 class WorkItem;
 class FileManager;
 
@@ -46,7 +46,7 @@ public:
     void stop();
 
     // Call frequently
-    void service(WorkManager* pWorkManager);
+    void service(WorkItemSink* pWorkItemSink);
 
     // Process WorkItem
     bool execWorkItem(WorkItem& workItem, FileManager& fileManager);
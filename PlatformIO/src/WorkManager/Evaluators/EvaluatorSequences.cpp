@@ -5,7 +5,8 @@
 #include <ArduinoLog.h>
 #include "EvaluatorSequences.h"
 #include "RdJson.h"
-#include "../WorkManager.h"
+#include "FileManager.h"
+#include "../WorkItemSink.h"
 
 static const char* MODULE_PREFIX = "EvaluatorSequences: ";
 
@@ -66,10 +67,10 @@ bool EvaluatorSequences::execWorkItem(WorkItem& workItem)
     return false;
 }
 
-void EvaluatorSequences::service(WorkManager* pWorkManager)
+void EvaluatorSequences::service(WorkItemSink* pWorkItemSink)
 {
     // Only add process commands at this level if the workitem queue is completely empty
-    if (!pWorkManager->queueIsEmpty())
+    if (!pWorkItemSink->queueIsEmpty())
         return;
 
     // Check if operative
@@ -104,7 +105,7 @@ void EvaluatorSequences::service(WorkManager* pWorkManager)
         {
             String retStr;
             WorkItem workItem(newCmd);
-            pWorkManager->addWorkItem(workItem, retStr, _curLineIdx);
+            pWorkItemSink->addWorkItem(workItem, retStr, _curLineIdx);
         }
         // Bump
         _curLineIdx++;
@@ -121,7 +122,7 @@ void EvaluatorSequences::service(WorkManager* pWorkManager)
     // {
     //     _lastMillis = millis();
     //     Log.trace("%sprocess cmdStr %s cmdIdx %d numToProc %d isEmpty %d\n", MODULE_PREFIX, _commandList.c_str(), _curCmdIdx, _numCmdsToProcess,
-    //                     pWorkManager->queueIsEmpty());
+    //                     pWorkItemSink->queueIsEmpty());
     // }
 }
 
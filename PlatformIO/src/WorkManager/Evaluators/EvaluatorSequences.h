@@ -3,7 +3,7 @@
 
 #pragma once
 
-class WorkManager;
+class WorkItemSink;
 class WorkItem;
 class FileManager;
 
@@ -28,7 +28,7 @@ public:
     bool execWorkItem(WorkItem& workItem);
 
     // Call frequently
-    void service(WorkManager* pWorkManager);
+    void service(WorkItemSink* pWorkItemSink);
 
     // Control
     void stop();
@@ -6,7 +6,7 @@
 #include "EvaluatorThetaRhoLine.h"
 #include "RdJson.h"
 #include "Utils.h"
-#include "../WorkManager.h"
+#include "../WorkItemSink.h"
 
 //#define THETA_RHO_DEBUG 1
 
@@ -106,7 +106,7 @@ bool EvaluatorThetaRhoLine::execWorkItem(WorkItem& workItem)
     return true;
 }
 
-void EvaluatorThetaRhoLine::service(WorkManager* pWorkManager)
+void EvaluatorThetaRhoLine::service(WorkItemSink* pWorkItemSink)
 {
     // Process multiple if possible
     for (int i = 0; i < PROCESS_STEPS_PER_SERVICE; i++)
@@ -116,7 +116,7 @@ void EvaluatorThetaRhoLine::service(WorkManager* pWorkManager)
             return;
 
         // See if we can add to the queue
-        if (!pWorkManager->canAcceptWorkItem())
+        if (!pWorkItemSink->canAcceptWorkItem())
             return;
 
         // Inc
@@ -131,7 +131,7 @@ void EvaluatorThetaRhoLine::service(WorkManager* pWorkManager)
 #ifdef THETA_RHO_DEBUG
         Log.trace("%sservice %s\n", MODULE_PREFIX, lineBuf);
 #endif
-        pWorkManager->addWorkItem(workItem, retStr);
+        pWorkItemSink->addWorkItem(workItem, retStr);
 
         // Check complete
         _curStep++;
@@ -3,7 +3,7 @@
 
 #pragma once
 
-class WorkManager;
+class WorkItemSink;
 class WorkItem;
 
 class EvaluatorThetaRhoLine
@@ -25,7 +25,7 @@ public:
     bool execWorkItem(WorkItem& workItem);
 
     // Call frequently
-    void service(WorkManager* pWorkManager);
+    void service(WorkItemSink* pWorkItemSink);
 
     // Control
     void stop();
@@ -0,0 +1,115 @@
+// RBotFirmware
+// Rob Dobson 2016-2018
+
+#include "MotionTask.h"
+#include "WorkManager.h"
+#include "RobotMotion/RobotController.h"
+#include <ArduinoLog.h>
+
+#ifdef USE_MOTION_TASK_THREAD
+#include <chrono>
+#endif
+
+static const char* MODULE_PREFIX = "MotionTask: ";
+
+MotionTask::MotionTask(WorkManager& workManager, RobotController& robotController) :
+            _workManager(workManager),
+            _robotController(robotController)
+{
+    _isRunning = false;
+    _stopRequested = false;
+#if defined(USE_MOTION_TASK) && !defined(USE_MOTION_TASK_THREAD)
+    _taskHandle = NULL;
+#endif
+}
+
+MotionTask::~MotionTask()
+{
+    stop();
+}
+
+void MotionTask::start()
+{
+#ifdef USE_MOTION_TASK
+    if (_isRunning)
+        return;
+    _stopRequested = false;
+    _workManager.setUseHandoff(true);
+    _isRunning = true;
+#ifndef USE_MOTION_TASK_THREAD
+    BaseType_t rslt = xTaskCreatePinnedToCore(taskEntry, "motion", MOTION_TASK_STACK_SIZE, this,
+                            MOTION_TASK_PRIORITY, &_taskHandle, MOTION_TASK_CORE);
+    if (rslt != pdPASS)
+    {
+        Log.warning("%sfailed to create task - servicing from loop\n", MODULE_PREFIX);
+        _taskHandle = NULL;
+        _isRunning = false;
+        _workManager.setUseHandoff(false);
+        return;
+    }
+#else
+    _thread = std::thread(&MotionTask::taskLoop, this);
+#endif
+    Log.notice("%sstarted core %d priority %d\n", MODULE_PREFIX, MOTION_TASK_CORE, MOTION_TASK_PRIORITY);
+#endif
+}
+
+void MotionTask::stop()
+{
+#ifdef USE_MOTION_TASK
+    if (!_isRunning)
+        return;
+    _stopRequested = true;
+#ifndef USE_MOTION_TASK_THREAD
+    // The task deletes itself when it sees the stop request
+    while (_isRunning)
+        delay(1);
+    _taskHandle = NULL;
+#else
+    if (_thread.joinable())
+        _thread.join();
+#endif
+    _workManager.setUseHandoff(false);
+#endif
+}
+
+void MotionTask::service()
+{
+    if (_isRunning)
+        return;
+    serviceMotion();
+}
+
+void MotionTask::serviceMotion()
+{
+    // Service the robot controller
+    _robotController.service();
+
+    // Service the command interface (which pumps the workflow queue)
+    _workManager.service();
+}
+
+void MotionTask::taskLoop()
+{
+    while (!_stopRequested)
+    {
+        serviceMotion();
+#ifdef USE_MOTION_TASK_THREAD
+        std::this_thread::sleep_for(std::chrono::milliseconds(MOTION_TASK_SERVICE_MS));
+#elif defined(USE_MOTION_TASK)
+        // Always block for at least one tick so lower priority tasks on this core get to run
+        TickType_t delayTicks = pdMS_TO_TICKS(MOTION_TASK_SERVICE_MS);
+        vTaskDelay(delayTicks > 0 ? delayTicks : 1);
+#endif
+    }
+    _isRunning = false;
+}
+
+#if defined(USE_MOTION_TASK) && !defined(USE_MOTION_TASK_THREAD)
+void MotionTask::taskEntry(void* pParam)
+{
+    MotionTask* pMotionTask = (MotionTask*)pParam;
+    pMotionTask->taskLoop();
+    vTaskDelete(NULL);
+}
+#endif
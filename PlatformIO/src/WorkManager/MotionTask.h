@@ -0,0 +1,74 @@
+// RBotFirmware
+// Rob Dobson 2016-2018
+
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+
+// The robot controller, work manager (and its evaluators) and the motion planner are serviced in a
+// task of their own pinned to the core which doesn't run the WiFi stack so that web and MQTT load
+// can't starve the motion pipeline - define NO_MOTION_TASK in the build flags to service them in loop()
+#ifndef NO_MOTION_TASK
+#define USE_MOTION_TASK 1
+#endif
+
+// The task is a FreeRTOS task on the ESP32 and a std::thread elsewhere - define MOTION_TASK_STD_THREAD
+// to use a std::thread on an ESP32 build without FreeRTOS (the Linux host build)
+#if defined(USE_MOTION_TASK) && (!defined(ESP32) || defined(MOTION_TASK_STD_THREAD))
+#define USE_MOTION_TASK_THREAD 1
+#include <thread>
+#endif
+
+class WorkManager;
+class RobotController;
+
+class MotionTask
+{
+public:
+    // WiFi and the TCP/IP stack run on core 0 on the ESP32
+    static constexpr int MOTION_TASK_CORE = 1;
+    // Above the Arduino loop task (1) and the async TCP task (3)
+    static constexpr int MOTION_TASK_PRIORITY = 4;
+    static constexpr int MOTION_TASK_STACK_SIZE = 8192;
+    // Time the task sleeps between services - must be well within the time covered by
+    // the segment buffer (see MotionSegmentBuffer)
+    static constexpr int MOTION_TASK_SERVICE_MS = 1;
+
+private:
+    WorkManager& _workManager;
+    RobotController& _robotController;
+    std::atomic<bool> _isRunning;
+    std::atomic<bool> _stopRequested;
+#ifdef USE_MOTION_TASK_THREAD
+    std::thread _thread;
+#elif defined(USE_MOTION_TASK)
+    TaskHandle_t _taskHandle;
+#endif
+
+public:
+    MotionTask(WorkManager& workManager, RobotController& robotController);
+    ~MotionTask();
+
+    // Start the task - from this point the networking side must only use the
+    // thread-safe WorkManager methods (postWorkItem, queryStatus, etc)
+    void start();
+
+    // Stop the task and wait for it to finish
+    void stop();
+
+    // Call from loop() - services motion directly when there is no motion task
+    void service();
+
+    bool isRunning()
+    {
+        return _isRunning;
+    }
+
+private:
+    void serviceMotion();
+    void taskLoop();
+#if defined(USE_MOTION_TASK) && !defined(USE_MOTION_TASK_THREAD)
+    static void taskEntry(void* pParam);
+#endif
+};
@@ -0,0 +1,207 @@
+// RBotFirmware
+// Rob Dobson 2016-2018
+
+#include <ArduinoLog.h>
+#include "RobotDryRun.h"
+#include "RdJson.h"
+#include "FileManager.h"
+#include "Utils.h"
+#include "Evaluators/EvaluatorFiles.h"
+#include "Evaluators/EvaluatorGCode.h"
+
+static const char* MODULE_PREFIX = "RobotDryRun: ";
+
+// Work items fed to the robot controller for each segment executed - on the device
+// the work manager is serviced many times for each segment the ISR executes
+static const int MAX_FEEDS_PER_SEGMENT = 100;
+
+RobotDryRun::RobotDryRun(FileManager& fileManager) :
+            _fileManager(fileManager),
+            _robotController(true)
+{
+    _pFile = NULL;
+    _fileType = EvaluatorFiles::FILE_TYPE_UNKNOWN;
+    _firstValidLineProcessed = false;
+    _itemPending = false;
+    _isBusy = false;
+    _wasAbandoned = false;
+}
+
+RobotDryRun::~RobotDryRun()
+{
+    if (_pFile)
+        fclose(_pFile);
+}
+
+bool RobotDryRun::start(const char* robotConfigStr, const String& fileName)
+{
+    // Stop any dry run in progress
+    finish();
+    _itemPending = false;
+    _wasAbandoned = false;
+
+    // Robot and evaluators configured as for the real robot
+    _robotController.init(robotConfigStr);
+    _robotController.stop();
+    String robotAttributes;
+    _robotController.getRobotAttributes(robotAttributes);
+    String evaluatorConfig = RdJson::getString("evaluators", "{}", robotConfigStr);
+    _evaluatorPatterns.setConfig(evaluatorConfig.c_str(), robotAttributes.c_str());
+    _evaluatorThetaRhoLine.setConfig(evaluatorConfig.c_str());
+
+    // Patterns are evaluated in full
+    WorkItem fileItem(fileName);
+    if (_evaluatorPatterns.isValid(fileItem))
+    {
+        if (!_evaluatorPatterns.execWorkItem(fileItem, _fileManager))
+            return false;
+        Log.notice("%sstarted pattern %s\n", MODULE_PREFIX, fileName.c_str());
+        _isBusy = true;
+        return true;
+    }
+
+    // Files are read directly rather than with chunked access which may be in use for playing a file
+    String fileNameStr = fileName;
+    _fileType = EvaluatorFiles::getFileTypeFromExtension(fileNameStr);
+    if (_fileType == EvaluatorFiles::FILE_TYPE_UNKNOWN)
+        return false;
+    String filePath = _fileManager.getFileFullPath("", fileName);
+    if (filePath.length() == 0)
+        return false;
+    _pFile = fopen(filePath.c_str(), "r");
+    if (!_pFile)
+    {
+        Log.notice("%sfailed to open %s\n", MODULE_PREFIX, filePath.c_str());
+        return false;
+    }
+    Log.notice("%sstarted file %s\n", MODULE_PREFIX, filePath.c_str());
+    _firstValidLineProcessed = false;
+    _isBusy = true;
+    return true;
+}
+
+void RobotDryRun::service(uint32_t maxMs)
+{
+    unsigned long startMs = millis();
+    while (_isBusy)
+    {
+        serviceOnce();
+        if ((maxMs != 0) && Utils::isTimeout(millis(), startMs, maxMs))
+            break;
+    }
+}
+
+void RobotDryRun::getResult(MotionDryRunResult& result)
+{
+    _robotController.getDryRunResult(result);
+}
+
+bool RobotDryRun::canAcceptWorkItem()
+{
+    return !_itemPending;
+}
+
+bool RobotDryRun::queueIsEmpty()
+{
+    return !_itemPending;
+}
+
+void RobotDryRun::addWorkItem(WorkItem& workItem, String &retStr, int cmdIdx)
+{
+    if (_itemPending)
+    {
+        retStr = "{\"rslt\":\"busy\"}";
+        return;
+    }
+    _pendingItem = workItem;
+    _itemPending = true;
+    retStr = "{\"rslt\":\"ok\"}";
+}
+
+// Feed the robot controller then execute a single segment of motion
+void RobotDryRun::serviceOnce()
+{
+    for (int i = 0; i < MAX_FEEDS_PER_SEGMENT; i++)
+    {
+        processPendingItem();
+        if (_itemPending)
+            break;
+        _evaluatorThetaRhoLine.service(this);
+        _evaluatorPatterns.service(this);
+        if (_itemPending || _evaluatorThetaRhoLine.isBusy() || _evaluatorPatterns.isBusy())
+            continue;
+        if (!_pFile)
+            break;
+        readFileLine();
+    }
+    _robotController.service();
+
+    // Check if finished
+    bool evaluatorsBusy = _evaluatorThetaRhoLine.isBusy() || _evaluatorPatterns.isBusy();
+    if (!_pFile && !_itemPending && !evaluatorsBusy && _robotController.isIdle())
+    {
+        Log.notice("%sfinished\n", MODULE_PREFIX);
+        finish();
+        return;
+    }
+
+    // Check the time limit
+    MotionDryRunResult result;
+    _robotController.getDryRunResult(result);
+    if (result._timeS > MAX_SIMULATED_S)
+    {
+        Log.notice("%sabandoned after %Fs\n", MODULE_PREFIX, result._timeS);
+        _wasAbandoned = true;
+        finish();
+    }
+}
+
+void RobotDryRun::processPendingItem()
+{
+    if (!_itemPending)
+        return;
+
+    // Theta-rho lines are interpolated by their evaluator
+    if (_evaluatorThetaRhoLine.isValid(_pendingItem))
+    {
+        if (_evaluatorThetaRhoLine.isBusy())
+            return;
+        _evaluatorThetaRhoLine.execWorkItem(_pendingItem);
+        _itemPending = false;
+        return;
+    }
+
+    // Everything else is GCode
+    if (!_robotController.canAcceptCommand())
+        return;
+    EvaluatorGCode::interpretGcode(_pendingItem, &_robotController, true);
+    _itemPending = false;
+}
+
+void RobotDryRun::readFileLine()
+{
+    char* pLine = _fileManager.readLineFromFile(_lineBuf, MAX_LINE_LEN, _pFile);
+    if (!pLine)
+    {
+        fclose(_pFile);
+        _pFile = NULL;
+        return;
+    }
+    String line = pLine;
+    if (!EvaluatorFiles::formLine(line, _fileType, _firstValidLineProcessed))
+        return;
+    String retStr;
+    WorkItem workItem(line);
+    addWorkItem(workItem, retStr);
+    _firstValidLineProcessed = true;
+}
+
+void RobotDryRun::finish()
+{
+    if (_pFile)
+        fclose(_pFile);
+    _pFile = NULL;
+    _evaluatorPatterns.stop();
+    _evaluatorThetaRhoLine.stop();
+    _isBusy = false;
+}
@@ -0,0 +1,130 @@
+// RBotFirmware
+// Rob Dobson 2016-2018
+
+#pragma once
+
+#include <Arduino.h>
+#include <stdio.h>
+#include "WorkItemSink.h"
+#include "RobotMotion/RobotController.h"
+#include "Evaluators/EvaluatorPatterns.h"
+#include "Evaluators/EvaluatorThetaRhoLine.h"
+
+class FileManager;
+
+// Status of the latest dry run - plain data so that it can be handed off between tasks
+struct RobotDryRunStatus
+{
+    static const int MAX_FILE_NAME_LEN = 100;
+    char _fileName[MAX_FILE_NAME_LEN];
+    bool _isBusy;
+    // False if the file could not be started
+    bool _isValid;
+    bool _wasAbandoned;
+    // Result so far while busy
+    MotionDryRunResult _result;
+
+    RobotDryRunStatus()
+    {
+        clear();
+    }
+
+    void clear()
+    {
+        _fileName[0] = 0;
+        _isBusy = false;
+        _isValid = false;
+        _wasAbandoned = false;
+        _result.clear();
+    }
+
+    void setFileName(const char* fileName)
+    {
+        strncpy(_fileName, fileName, MAX_FILE_NAME_LEN - 1);
+        _fileName[MAX_FILE_NAME_LEN - 1] = 0;
+    }
+
+    String toJSON()
+    {
+        if (_fileName[0] == 0)
+            return "{\"rslt\":\"none\"}";
+        if (!_isValid)
+            return "{\"rslt\":\"fail\",\"file\":\"" + String(_fileName) + "\"}";
+        String jsonStr = "{\"rslt\":\"ok\",\"file\":\"" + String(_fileName) + "\",\"busy\":" + String(_isBusy ? 1 : 0);
+        if (_wasAbandoned)
+            jsonStr += ",\"abandoned\":1";
+        return jsonStr + ",\"dryRun\":" + _result.toJSON() + "}";
+    }
+};
+
+// Dry run of a file (.gcode, .thr or .param) - the work items from the file go through a robot
+// controller of their own whose motion is consumed against a simulated clock (see MotionDryRun)
+// so the run time, block count, extent and peak step rates are found without moving the motors
+class RobotDryRun : public WorkItemSink
+{
+public:
+    // Simulated time after which a dry run is abandoned (patterns may not stop)
+    static constexpr float MAX_SIMULATED_S = 24 * 3600;
+
+private:
+    FileManager& _fileManager;
+    RobotController _robotController;
+
+    // Evaluators for the work items that a file can generate
+    EvaluatorPatterns _evaluatorPatterns;
+    EvaluatorThetaRhoLine _evaluatorThetaRhoLine;
+
+    // File being read line by line (gcode and theta-rho)
+    FILE* _pFile;
+    int _fileType;
+    bool _firstValidLineProcessed;
+
+    // Work item waiting to be processed
+    WorkItem _pendingItem;
+    bool _itemPending;
+
+    // State
+    bool _isBusy;
+    bool _wasAbandoned;
+
+    // Line buffer
+    static const int MAX_LINE_LEN = 200;
+    char _lineBuf[MAX_LINE_LEN];
+
+public:
+    RobotDryRun(FileManager& fileManager);
+    ~RobotDryRun();
+
+    // Start a dry run of a file with the given robot configuration
+    bool start(const char* robotConfigStr, const String& fileName);
+
+    // Call frequently - runs for up to maxMs of real time (0 to run until finished)
+    void service(uint32_t maxMs);
+
+    // Check if running
+    bool isBusy()
+    {
+        return _isBusy;
+    }
+
+    // Check if the simulated time limit was reached
+    bool wasAbandoned()
+    {
+        return _wasAbandoned;
+    }
+
+    // Result (complete when no longer busy)
+    void getResult(MotionDryRunResult& result);
+
+    // Work items from the evaluators
+    bool canAcceptWorkItem();
+    bool queueIsEmpty();
+    void addWorkItem(WorkItem& workItem, String &retStr, int cmdIdx = -1);
+
+private:
+    // Execute one step of the dry run
+    void serviceOnce();
+    void processPendingItem();
+    void readFileLine();
+    void finish();
+};
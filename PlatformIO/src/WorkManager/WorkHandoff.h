@@ -0,0 +1,174 @@
+// RBotFirmware
+// Rob Dobson 2016-2018
+
+#pragma once
+
+#include <atomic>
+#include <string.h>
+#include "WorkItem.h"
+#include "RobotCommandArgs.h"
+
+// Lock-free handoff between the networking side (web server, MQTT, console, scheduler)
+// and the motion task which owns the work item queue, evaluators and planner
+
+// Bounded multi-producer single-consumer queue of work items
+// Each slot carries a sequence number which tells producers and the consumer whose turn it is
+// to use the slot so no locks are needed (producers only contend on the put position)
+class WorkCommandHandoff
+{
+public:
+    static constexpr unsigned int HANDOFF_LEN = 16;
+
+private:
+    struct Slot
+    {
+        std::atomic<unsigned int> _seq;
+        WorkItem _workItem;
+    };
+    Slot _slots[HANDOFF_LEN];
+    std::atomic<unsigned int> _putPos;
+    unsigned int _getPos;
+
+public:
+    WorkCommandHandoff()
+    {
+        for (unsigned int i = 0; i < HANDOFF_LEN; i++)
+            _slots[i]._seq.store(i, std::memory_order_relaxed);
+        _putPos.store(0, std::memory_order_relaxed);
+        _getPos = 0;
+    }
+
+    // Called from any task - returns false if full
+    bool put(const WorkItem& workItem)
+    {
+        unsigned int pos = _putPos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Slot& slot = _slots[pos % HANDOFF_LEN];
+            int diff = (int)slot._seq.load(std::memory_order_acquire) - (int)pos;
+            if (diff < 0)
+                return false;
+            if ((diff == 0) && _putPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                slot._workItem = workItem;
+                slot._seq.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+            if (diff > 0)
+                pos = _putPos.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Called only from the motion task - returns false if empty (the item is left in the handoff)
+    bool peek(WorkItem& workItem)
+    {
+        Slot& slot = _slots[_getPos % HANDOFF_LEN];
+        if (slot._seq.load(std::memory_order_acquire) != _getPos + 1)
+            return false;
+        workItem = slot._workItem;
+        return true;
+    }
+
+    // Called only from the motion task - returns false if empty
+    bool get(WorkItem& workItem)
+    {
+        Slot& slot = _slots[_getPos % HANDOFF_LEN];
+        if (slot._seq.load(std::memory_order_acquire) != _getPos + 1)
+            return false;
+        workItem = slot._workItem;
+        slot._workItem = WorkItem();
+        slot._seq.store(_getPos + HANDOFF_LEN, std::memory_order_release);
+        _getPos++;
+        return true;
+    }
+
+    // Approximate count (for debug)
+    unsigned int count()
+    {
+        return _putPos.load(std::memory_order_relaxed) - _getPos;
+    }
+};
+
+// Latest value (robot status, dry run status) published by the motion task and read by the networking side
+// A sequence count is odd while the value is being written so readers retry on a torn copy
+template <typename T>
+class WorkLatestHandoff
+{
+private:
+    std::atomic<unsigned int> _seq;
+    T _value;
+    static constexpr int MAX_READ_RETRIES = 100;
+
+public:
+    WorkLatestHandoff()
+    {
+        _seq.store(0, std::memory_order_relaxed);
+    }
+
+    // Called only from the motion task
+    void put(const T& value)
+    {
+        unsigned int seq = _seq.load(std::memory_order_relaxed);
+        _seq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        _value = value;
+        _seq.store(seq + 2, std::memory_order_release);
+    }
+
+    // Called from any task - returns false if no consistent copy could be made
+    bool get(T& value)
+    {
+        return read([&value](const T& latest) { value = latest; });
+    }
+
+    // Called from any task - readFn copies what it needs from the value (so a large value needn't be
+    // copied to the stack) and is called again if the value changed while it was reading
+    template <typename ReadFn>
+    bool read(ReadFn readFn)
+    {
+        for (int i = 0; i < MAX_READ_RETRIES; i++)
+        {
+            unsigned int seqBefore = _seq.load(std::memory_order_acquire);
+            if (seqBefore & 1)
+                continue;
+            readFn(_value);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (_seq.load(std::memory_order_relaxed) == seqBefore)
+                return true;
+        }
+        return false;
+    }
+};
+
+typedef WorkLatestHandoff<RobotCommandArgs> WorkStatusHandoff;
+
+// Fixed size text (debug info, JSON) for a WorkLatestHandoff - a String can't be used as the
+// reader may copy it while it is being changed
+// The last char is always the terminator so a reader copying the text while it is changed stays in bounds
+template <unsigned int MAX_LEN>
+class WorkHandoffText
+{
+private:
+    char _text[MAX_LEN];
+
+public:
+    WorkHandoffText()
+    {
+        _text[0] = 0;
+        _text[MAX_LEN - 1] = 0;
+    }
+
+    // Returns false if the text had to be truncated
+    bool set(const String& str)
+    {
+        unsigned int len = str.length() < MAX_LEN ? str.length() : MAX_LEN - 1;
+        memcpy(_text, str.c_str(), len);
+        _text[len] = 0;
+        return len == str.length();
+    }
+
+    const char* c_str() const
+    {
+        return _text;
+    }
+};
@@ -42,6 +42,12 @@ public:
         return (_workItemQueue.size() >= _workItemQueueMaxLen);
     }
 
+    // Check if there is space for a number of items
+    bool hasSpaceFor(unsigned int numItems)
+    {
+        return (_workItemQueue.size() + numItems <= _workItemQueueMaxLen);
+    }
+
     // Check if queue empty
     bool isEmpty()
     {
@@ -0,0 +1,26 @@
+// RBotFirmware
+// Rob Dobson 2016-2018
+
+#pragma once
+
+#include <Arduino.h>
+#include "WorkItem.h"
+
+// Destination for the work items generated by evaluators - this is the WorkManager's queue
+// except for a dry run where the items go straight to the dry run's robot controller
+class WorkItemSink
+{
+public:
+    virtual ~WorkItemSink()
+    {
+    }
+
+    // Check if a work item can be accepted
+    virtual bool canAcceptWorkItem() = 0;
+
+    // Check if all work items have been taken
+    virtual bool queueIsEmpty() = 0;
+
+    // Add a work item
+    virtual void addWorkItem(WorkItem& workItem, String &retStr, int cmdIdx = -1) = 0;
+};
@@ -30,6 +30,11 @@ WorkManager::WorkManager(ConfigBase& mainConfig,
 {
     _statusReportLastCheck = 0;
     _statusLastHashVal = 0;
+    _useHandoff = false;
+    _statusPublishLastMs = 0;
+    _debugPublishLastMs = 0;
+    _statsPublishLastMs = 0;
+    _pRobotDryRun = NULL;
 #ifdef DEBUG_WORK_ITEM_SERVICE
     _debugLastWorkServiceMs = 0;
 #endif
@@ -47,12 +52,34 @@ void WorkManager::queryStatus(String &respStr)
     innerJsonStr += healthStrSystem;
     // Robot info
     RobotCommandArgs cmdArgs;
-    _robotController.getCurStatus(cmdArgs);
+    getRobotStatus(cmdArgs);
     String healthStrRobot = cmdArgs.toJSON(false);
     if (innerJsonStr.length() > 0)
         innerJsonStr += ",";
     innerJsonStr += healthStrRobot;
-    String ledStrip = _ledStrip.getConfigStrPtr();
+    // Pipeline underrun telemetry
+    String pipeStatsStr;
+    if (_useHandoff)
+    {
+        if (!_pipeStatsHandoff.read([&pipeStatsStr](const WorkHandoffText<PIPE_STATS_TEXT_LEN>& text) { pipeStatsStr = text.c_str(); }))
+            pipeStatsStr = "{}";
+    }
+    else
+    {
+        pipeStatsStr = _robotController.getPipelineStatsJSON();
+    }
+    innerJsonStr += ",\"pipe\":" + pipeStatsStr;
+    // LED strip (owned by the motion task when it is running)
+    String ledStrip;
+    if (_useHandoff)
+    {
+        if (!_ledStripPublished.read([&ledStrip](const WorkHandoffText<LED_STRIP_TEXT_LEN>& text) { ledStrip = text.c_str(); }))
+            ledStrip = "{}";
+    }
+    else
+    {
+        ledStrip = _ledStrip.getConfigStrPtr();
+    }
     if (innerJsonStr.length() > 0)
         innerJsonStr += ",";
     innerJsonStr += ledStrip.substring(1, ledStrip.length() - 1);    
@@ -90,16 +117,28 @@ bool WorkManager::queueIsEmpty()
 
 void WorkManager::getRobotConfig(String &respStr)
 {
-    respStr = _robotConfig.getConfigString();
+    // The config is owned by the motion task when it is running
+    if (!_useHandoff)
+    {
+        respStr = _robotConfig.getConfigString();
+        return;
+    }
+    // Copied straight from the published config as it is too big for the caller's stack
+    if (!_robotConfigPublished.read([&respStr](const WorkHandoffText<ROBOT_CONFIG_TEXT_LEN>& text) { respStr = text.c_str(); }))
+        respStr = "{\"rslt\":\"busy\"}";
 }
 
 bool WorkManager::setLedStripConfig(const uint8_t* pData, int len) {
+    // Check sensible length
+    if (len >= (int)LED_STRIP_TEXT_LEN)
+        return false;
     char tmpBuf[len + 1];
     memcpy(tmpBuf, pData, len);
     tmpBuf[len] = 0;
     // Make sure string is terminated
+    if (_useHandoff)
+        return _ledStripConfigHandoff.put(WorkItem(tmpBuf));
     _ledStrip.updateLedFromConfig(tmpBuf);
-    
     return true;
 }
 
@@ -107,7 +146,7 @@ bool WorkManager::setRobotConfig(const uint8_t *pData, int len)
 {
     Log.trace("%ssetRobotConfig len %d\n", MODULE_PREFIX, len);
     // Check sensible length
-    if (len + 10 > _robotConfig.getMaxLen())
+    if ((len + 10 > _robotConfig.getMaxLen()) || (len >= (int)ROBOT_CONFIG_TEXT_LEN))
         return false;
     char* pTmp = new char[len + 1];
     if (!pTmp)
@@ -115,13 +154,38 @@ bool WorkManager::setRobotConfig(const uint8_t *pData, int len)
     memcpy(pTmp, pData, len);
     pTmp[len] = 0;
     // Make sure string is terminated
-    _robotConfig.setConfigData(pTmp);
+    bool rslt = true;
+    if (_useHandoff)
+        rslt = _robotConfigHandoff.put(WorkItem(pTmp));
+    else
+        applyRobotConfig(pTmp);
     delete[] pTmp;
+    return rslt;
+}
+
+void WorkManager::applyRobotConfig(const char* pConfigStr)
+{
+    _robotConfig.setConfigData(pConfigStr);
     // Reconfigure the robot
     reconfigure();
     // Store the configuration permanently
     _robotConfig.writeConfig();
-    return true;
+    publishRobotConfig();
+}
+
+void WorkManager::publishRobotConfig()
+{
+    WorkHandoffText<ROBOT_CONFIG_TEXT_LEN> configText;
+    if (!configText.set(_robotConfig.getConfigString()))
+        Log.warning("%srobot config too long to publish\n", MODULE_PREFIX);
+    _robotConfigPublished.put(configText);
+}
+
+void WorkManager::publishLedStrip()
+{
+    WorkHandoffText<LED_STRIP_TEXT_LEN> ledStripText;
+    ledStripText.set(_ledStrip.getConfigStrPtr());
+    _ledStripPublished.put(ledStripText);
 }
 
 void WorkManager::processSingle(const char *pCmdStr, String &retStr)
@@ -160,6 +224,11 @@ void WorkManager::processSingle(const char *pCmdStr, String &retStr)
         evaluatorsStop();
         retStr = okRslt;
     }
+    else if (strncasecmp(pCmdStr, "dryrun ", 7) == 0)
+    {
+        // Dry run of a file - doesn't affect the robot
+        dryRunStart(pCmdStr + 7, retStr);
+    }
     else
     {
         // Send the line to the workflow manager
@@ -184,6 +253,14 @@ void WorkManager::processSingle(const char *pCmdStr, String &retStr)
     // Log.verbose("%sprocSingle rslt %s\n", MODULE_PREFIX, retStr.c_str());
 }
 
+bool WorkManager::isImmediateCommand(const char* pCmdStr)
+{
+    // As handled by processSingle
+    return (strcasecmp(pCmdStr, "pause") == 0) || (strcasecmp(pCmdStr, "sleep") == 0) ||
+           (strcasecmp(pCmdStr, "resume") == 0) || (strcasecmp(pCmdStr, "playpause") == 0) ||
+           (strcasecmp(pCmdStr, "stop") == 0) || (strncasecmp(pCmdStr, "dryrun ", 7) == 0);
+}
+
 void WorkManager::addWorkItem(WorkItem& workItem, String &retStr, int cmdIdx)
 {
     // Handle the case of a single string
@@ -238,6 +315,51 @@ void WorkManager::addWorkItem(WorkItem& workItem, String &retStr, int cmdIdx)
     }
 }
 
+void WorkManager::postWorkItem(WorkItem& workItem, String &retStr)
+{
+    if (!_useHandoff)
+    {
+        addWorkItem(workItem, retStr);
+        return;
+    }
+    // Commands are handled when the motion task next runs (within a few ms) - others are left in the
+    // handoff until there is space for them in the queue so the networking side sees busy when it is full
+    WorkCommandHandoff& handoff = isImmediateCommand(workItem.getCString()) ? _immediateHandoff : _commandHandoff;
+    if (!handoff.put(workItem))
+    {
+        retStr = "{\"rslt\":\"busy\"}";
+        Log.trace("%spostWorkItem handoff full\n", MODULE_PREFIX);
+        return;
+    }
+    retStr = "{\"rslt\":\"ok\"}";
+}
+
+void WorkManager::setUseHandoff(bool useHandoff)
+{
+    // Make sure there is a status to read before the motion task first runs
+    if (useHandoff)
+    {
+        RobotCommandArgs cmdArgs;
+        _robotController.getCurStatus(cmdArgs);
+        _statusHandoff.put(cmdArgs);
+        publishRobotConfig();
+        publishLedStrip();
+        publishStats();
+        WorkHandoffText<DEBUG_TEXT_LEN> debugText;
+        debugText.set(buildDebugStr());
+        _debugStrHandoff.put(debugText);
+    }
+    _useHandoff = useHandoff;
+}
+
+void WorkManager::getRobotStatus(RobotCommandArgs& cmdArgs)
+{
+    if (_useHandoff)
+        _statusHandoff.get(cmdArgs);
+    else
+        _robotController.getCurStatus(cmdArgs);
+}
+
 bool WorkManager::canBeProcessed(WorkItem& workItem)
 {
     // See if it is a pattern evaluator work item
@@ -334,6 +456,37 @@ void WorkManager::service()
     }
 #endif
 
+    // Apply configuration changed by the networking side
+    WorkItem configItem;
+    while (_robotConfigHandoff.get(configItem))
+        applyRobotConfig(configItem.getCString());
+    while (_ledStripConfigHandoff.get(configItem))
+    {
+        _ledStrip.updateLedFromConfig(configItem.getCString());
+        publishLedStrip();
+    }
+
+    // Work items handed off from the networking side - an item with several commands waits until
+    // there is space for all of them (or the queue is empty)
+    WorkItem handoffItem;
+    while (_immediateHandoff.get(handoffItem))
+    {
+        String retStr;
+        addWorkItem(handoffItem, retStr);
+    }
+    while (_commandHandoff.peek(handoffItem))
+    {
+        const char* pCmdStr = handoffItem.getCString();
+        unsigned int numCmds = 1;
+        for (const char* pCh = pCmdStr; *pCh; pCh++)
+            numCmds += (*pCh == ';') ? 1 : 0;
+        if (!_workItemQueue.hasSpaceFor(numCmds) && !_workItemQueue.isEmpty())
+            break;
+        _commandHandoff.get(handoffItem);
+        String retStr;
+        addWorkItem(handoffItem, retStr);
+    }
+
     // Pump the workflow here
     // Check if the RobotController can accept more
     if (_robotController.canAcceptCommand())
@@ -367,9 +520,37 @@ void WorkManager::service()
 
     // Service evaluators
     evaluatorsService();
+
+    // Dry run
+    dryRunService();
+
+    // LED strip (serviced here as the motion task uses it for sleep and resume)
+    _ledStrip.service();
+
+    // Publish status for the networking side
+    if (_useHandoff && Utils::isTimeout(millis(), _statusPublishLastMs, STATUS_PUBLISH_MS))
+    {
+        _statusPublishLastMs = millis();
+        RobotCommandArgs cmdArgs;
+        _robotController.getCurStatus(cmdArgs);
+        _statusHandoff.put(cmdArgs);
+        publishLedStrip();
+    }
+    if (_useHandoff && Utils::isTimeout(millis(), _statsPublishLastMs, STATS_PUBLISH_MS))
+    {
+        _statsPublishLastMs = millis();
+        publishStats();
+    }
+    if (_useHandoff && Utils::isTimeout(millis(), _debugPublishLastMs, DEBUG_PUBLISH_MS))
+    {
+        _debugPublishLastMs = millis();
+        WorkHandoffText<DEBUG_TEXT_LEN> debugText;
+        debugText.set(buildDebugStr());
+        _debugStrHandoff.put(debugText);
+    }
 }
 
-void WorkManager::reconfigure()
+String WorkManager::getRobotConfigStr()
 {
     // Get the config data
     String configData = _robotConfig.getConfigString();
@@ -390,6 +571,13 @@ void WorkManager::reconfigure()
         // Set the default robot type
         robotConfigStr = RobotConfigurations::getConfig(robotType.c_str());
     }
+    return robotConfigStr;
+}
+
+void WorkManager::reconfigure()
+{
+    // Get the robot config
+    String robotConfigStr = getRobotConfigStr();
 
     // Init robot controller and workflow manager
     _robotController.init(robotConfigStr.c_str());
@@ -491,7 +679,7 @@ bool WorkManager::checkStatusChanged()
 
     // Check for robot status changes
     RobotCommandArgs cmdArgs;
-    _robotController.getCurStatus(cmdArgs);
+    getRobotStatus(cmdArgs);
 
     // Check if anything changed
     statusChanged |= (_statusLastHashVal != statusNewHash) | (_statusLastCmdArgs != cmdArgs);
@@ -506,9 +694,108 @@ bool WorkManager::checkStatusChanged()
     return false;
 }
 
+void WorkManager::getMotionStats(String& statsStr)
+{
+    if (!_useHandoff)
+    {
+        _robotController.getMotionStats(statsStr);
+        return;
+    }
+    if (!_motionStatsHandoff.read([&statsStr](const WorkHandoffText<MOTION_STATS_TEXT_LEN>& text) { statsStr = text.c_str(); }))
+        statsStr = "{\"rslt\":\"busy\"}";
+}
+
+void WorkManager::publishStats()
+{
+    WorkHandoffText<PIPE_STATS_TEXT_LEN> pipeStatsText;
+    pipeStatsText.set(_robotController.getPipelineStatsJSON());
+    _pipeStatsHandoff.put(pipeStatsText);
+    String motionStatsStr;
+    _robotController.getMotionStats(motionStatsStr);
+    WorkHandoffText<MOTION_STATS_TEXT_LEN> motionStatsText;
+    if (!motionStatsText.set(motionStatsStr))
+        Log.warning("%smotion stats too long to publish\n", MODULE_PREFIX);
+    _motionStatsHandoff.put(motionStatsText);
+}
+
+void WorkManager::resetMotionStats()
+{
+    _robotController.resetMotionStats();
+}
+
+void WorkManager::dryRunStart(const char* fileName, String& retStr)
+{
+    // Replaces any dry run in progress
+    delete _pRobotDryRun;
+    _pRobotDryRun = new RobotDryRun(_fileManager);
+    _dryRunStatus.clear();
+    _dryRunStatus.setFileName(fileName);
+    if (!_pRobotDryRun || !_pRobotDryRun->start(getRobotConfigStr().c_str(), fileName))
+    {
+        Log.notice("%sdryRun failed to start %s\n", MODULE_PREFIX, fileName);
+        delete _pRobotDryRun;
+        _pRobotDryRun = NULL;
+        _dryRunStatusHandoff.put(_dryRunStatus);
+        retStr = "{\"rslt\":\"fail\"}";
+        return;
+    }
+    _dryRunStatus._isBusy = true;
+    _dryRunStatus._isValid = true;
+    _dryRunStatusHandoff.put(_dryRunStatus);
+    retStr = "{\"rslt\":\"ok\"}";
+}
+
+void WorkManager::dryRunService()
+{
+    if (!_pRobotDryRun)
+        return;
+    _pRobotDryRun->service(DRY_RUN_SERVICE_MS);
+
+    // Publish progress
+    _pRobotDryRun->getResult(_dryRunStatus._result);
+    _dryRunStatus._isBusy = _pRobotDryRun->isBusy();
+    _dryRunStatus._wasAbandoned = _pRobotDryRun->wasAbandoned();
+    _dryRunStatusHandoff.put(_dryRunStatus);
+
+    // Done with the dry run
+    if (!_pRobotDryRun->isBusy())
+    {
+        Log.notice("%sdryRun %s %s\n", MODULE_PREFIX, _dryRunStatus._fileName, _dryRunStatus._result.toJSON().c_str());
+        delete _pRobotDryRun;
+        _pRobotDryRun = NULL;
+    }
+}
+
+void WorkManager::getDryRunStatus(String& respStr)
+{
+    RobotDryRunStatus status;
+    if (!_dryRunStatusHandoff.get(status))
+    {
+        respStr = "{\"rslt\":\"busy\"}";
+        return;
+    }
+    respStr = status.toJSON();
+}
+
 String WorkManager::getDebugStr()
+{
+    if (!_useHandoff)
+        return buildDebugStr();
+    String debugStr;
+    if (!_debugStrHandoff.read([&debugStr](const WorkHandoffText<DEBUG_TEXT_LEN>& text) { debugStr = text.c_str(); }))
+        return "";
+    return debugStr;
+}
+
+String WorkManager::buildDebugStr()
 {
     String returnStr = (_workItemQueue.isFull() ? " QFULL:" : " QOK:");
     returnStr += _workItemQueue.size();
+    if (_useHandoff)
+    {
+        returnStr += " HO:";
+        returnStr += _commandHandoff.count() + _immediateHandoff.count();
+    }
+    returnStr += _robotController.getDebugStr();
     return returnStr;
 }
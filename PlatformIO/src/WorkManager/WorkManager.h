@@ -8,6 +8,9 @@
 #include <Arduino.h>
 #include "LedStrip.h"
 #include "WorkItemQueue.h"
+#include "WorkHandoff.h"
+#include "WorkItemSink.h"
+#include "RobotDryRun.h"
 #include "Evaluators/EvaluatorPatterns.h"
 #include "Evaluators/EvaluatorSequences.h"
 #include "Evaluators/EvaluatorFiles.h"
@@ -21,7 +24,7 @@ class FileManager;
 class CommandScheduler;
 
 // Work Manager - handles all workflow for the robot
-class WorkManager
+class WorkManager : public WorkItemSink
 {
 private:
     ConfigBase& _systemConfig;
@@ -39,6 +42,47 @@ private:
     EvaluatorFiles _evaluatorFiles;
     EvaluatorThetaRhoLine _evaluatorThetaRhoLine;
 
+    // Handoff to/from the networking side when the motion task is running - immediate commands (pause,
+    // stop, etc) have their own handoff so they aren't held up behind commands waiting for the queue
+    WorkCommandHandoff _commandHandoff;
+    WorkCommandHandoff _immediateHandoff;
+    WorkStatusHandoff _statusHandoff;
+    std::atomic<bool> _useHandoff;
+    unsigned long _statusPublishLastMs;
+    // Time between robot status updates published by the motion task
+    const unsigned long STATUS_PUBLISH_MS = 20;
+
+    // Robot config - only used by the motion task when it is running - new config from the networking
+    // side is handed to it and the config it is using is published for the networking side to read
+    static constexpr unsigned int ROBOT_CONFIG_TEXT_LEN = 2048;
+    WorkCommandHandoff _robotConfigHandoff;
+    WorkLatestHandoff<WorkHandoffText<ROBOT_CONFIG_TEXT_LEN>> _robotConfigPublished;
+
+    // LED strip - likewise only used by the motion task when it is running
+    static constexpr unsigned int LED_STRIP_TEXT_LEN = 128;
+    WorkCommandHandoff _ledStripConfigHandoff;
+    WorkLatestHandoff<WorkHandoffText<LED_STRIP_TEXT_LEN>> _ledStripPublished;
+
+    // Motion statistics published by the motion task - the pipeline summary is part of the status
+    static constexpr unsigned int PIPE_STATS_TEXT_LEN = 256;
+    static constexpr unsigned int MOTION_STATS_TEXT_LEN = 1536;
+    WorkLatestHandoff<WorkHandoffText<PIPE_STATS_TEXT_LEN>> _pipeStatsHandoff;
+    WorkLatestHandoff<WorkHandoffText<MOTION_STATS_TEXT_LEN>> _motionStatsHandoff;
+    unsigned long _statsPublishLastMs;
+    const unsigned long STATS_PUBLISH_MS = 500;
+
+    // Debug info published by the motion task
+    static constexpr unsigned int DEBUG_TEXT_LEN = 256;
+    WorkLatestHandoff<WorkHandoffText<DEBUG_TEXT_LEN>> _debugStrHandoff;
+    unsigned long _debugPublishLastMs;
+    const unsigned long DEBUG_PUBLISH_MS = 1000;
+
+    // Dry run of a file (no motion) - stepped a few ms at a time when the work manager is serviced
+    RobotDryRun* _pRobotDryRun;
+    RobotDryRunStatus _dryRunStatus;
+    WorkLatestHandoff<RobotDryRunStatus> _dryRunStatusHandoff;
+    static const uint32_t DRY_RUN_SERVICE_MS = 2;
+
     // Status updates
     RobotCommandArgs _statusLastCmdArgs;
     unsigned long _statusLastHashVal;
@@ -90,10 +134,25 @@ public:
     // Add a work item to the queue
     void addWorkItem(WorkItem& workItem, String &retStr, int cmdIdx = -1);
 
+    // Add a work item from the networking side - when the motion task is running the item is
+    // handed off to it rather than being processed immediately
+    void postWorkItem(WorkItem& workItem, String &retStr);
+
+    // Set when the motion task takes over servicing
+    void setUseHandoff(bool useHandoff);
+
     // Check status changed
     bool checkStatusChanged();
 
-    // Get debug string
+    // Motion timing statistics (safe to call from the networking side) - the stats are those last
+    // published by the motion task and the reset is done when it is next serviced
+    void getMotionStats(String& statsStr);
+    void resetMotionStats();
+
+    // Status of the latest dry run as JSON (safe to call from the networking side)
+    void getDryRunStatus(String& respStr);
+
+    // Debug info on the work manager and robot (safe to call from the networking side)
     String getDebugStr();
 
 private:
@@ -103,6 +162,9 @@ private:
     // Process a single 
     void processSingle(const char *pCmdStr, String &retStr);
 
+    // Check if a command is handled immediately (rather than being queued)
+    static bool isImmediateCommand(const char* pCmdStr);
+
     // Stop Evaluators
     void evaluatorsStop();
 
@@ -117,4 +179,27 @@ private:
 
     // Can be processed
     bool canBeProcessed(WorkItem& workItem);
+
+    // Robot status (from the motion task when it is running)
+    void getRobotStatus(RobotCommandArgs& cmdArgs);
+
+    // Robot config JSON (from the stored config or the default for the robot type)
+    String getRobotConfigStr();
+
+    // Apply and store robot config (in the motion task when it is running)
+    void applyRobotConfig(const char* pConfigStr);
+    void publishRobotConfig();
+
+    // LED strip settings for the networking side
+    void publishLedStrip();
+
+    // Debug info on the work manager and robot
+    String buildDebugStr();
+
+    // Publish statistics for the networking side
+    void publishStats();
+
+    // Dry run
+    void dryRunStart(const char* fileName, String& retStr);
+    void dryRunService();
 };
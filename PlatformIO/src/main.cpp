@@ -171,6 +171,10 @@ WorkManager _workManager(hwConfig,
                 fileManager,
                 commandScheduler);
 
+// Motion task - services the robot controller and work manager
+#include "WorkManager/MotionTask.h"
+MotionTask motionTask(_workManager, _robotController);
+
 // REST API Robot
 #include "RestAPIRobot.h"
 RestAPIRobot restAPIRobot(_workManager, fileManager);
@@ -186,7 +190,6 @@ void debugLoopInfoCallback(String &infoStr)
     else
         infoStr = "WiFi Disabled, Heap " + String(ESP.getFreeHeap());
     infoStr += _workManager.getDebugStr();
-    infoStr += _robotController.getDebugStr();
 }
 DebugLoopTimer debugLoopTimer(10000, debugLoopInfoCallback);
 
@@ -266,14 +269,12 @@ void setup()
     debugLoopTimer.blockAdd(1, "WiFi");
     debugLoopTimer.blockAdd(2, "Web");
     debugLoopTimer.blockAdd(3, "WifiLed");
-    debugLoopTimer.blockAdd(4, "LedStrip");
     debugLoopTimer.blockAdd(5, "SysAPI");
     debugLoopTimer.blockAdd(6, "Console");
     debugLoopTimer.blockAdd(7, "MQTT");
     debugLoopTimer.blockAdd(8, "OTA");
     debugLoopTimer.blockAdd(9, "NetLog");
-    debugLoopTimer.blockAdd(10, "Robot");
-    debugLoopTimer.blockAdd(11, "CMD");
+    debugLoopTimer.blockAdd(10, "Motion");
     debugLoopTimer.blockAdd(12, "Status");
     debugLoopTimer.blockAdd(13, "Sched");
     debugLoopTimer.blockAdd(14, "NTP");
@@ -283,6 +284,9 @@ void setup()
 
     // Handle statup commands
     _workManager.handleStartupCommands();
+
+    // Hand the robot controller and work manager over to the motion task
+    motionTask.start();
 }
 
 // Loop
@@ -313,11 +317,6 @@ void loop()
     wifiStatusLed.service();
     debugLoopTimer.blockEnd(3);
 
-    // Service the LED Strip
-    debugLoopTimer.blockStart(4);
-    ledStrip.service();
-    debugLoopTimer.blockEnd(4);
-
     // Service the system API (restart)
     debugLoopTimer.blockStart(5);
     restAPISystem.service();
@@ -343,16 +342,11 @@ void loop()
     netLog.service(serialConsole.getXonXoff());
     debugLoopTimer.blockStart(9);
 
-    // Service the robot controller
+    // Service the robot controller and command interface (unless the motion task is doing this)
     debugLoopTimer.blockStart(10);
-    _robotController.service();
+    motionTask.service();
     debugLoopTimer.blockEnd(10);
 
-    // Service the command interface (which pumps the workflow queue)
-    debugLoopTimer.blockStart(11);
-    _workManager.service();
-    debugLoopTimer.blockEnd(11);
-
     // Check for changes to status
     debugLoopTimer.blockStart(12);
     if (_workManager.checkStatusChanged())
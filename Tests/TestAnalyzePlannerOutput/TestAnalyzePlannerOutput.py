@@ -26,8 +26,12 @@ for testFile in testFiles:
 
     lines = lines[lineIdx+1:]
 
-    stepDists = [configJson["axis0"]['unitsPerRotation']/configJson["axis0"]['stepsPerRotation'],
-                 configJson["axis1"]['unitsPerRotation']/configJson["axis1"]['stepsPerRotation']]
+    # Axes are in robotGeom in traces from Linux/RBotMotionSim (and at the top level in older traces)
+    axesJson = configJson.get("robotGeom", configJson)
+    def axisStepDist(axisJson):
+        return axisJson.get('unitsPerRot', axisJson.get('unitsPerRotation')) / \
+               axisJson.get('stepsPerRot', axisJson.get('stepsPerRotation'))
+    stepDists = [axisStepDist(axesJson["axis0"]), axisStepDist(axesJson["axis1"])]
 
     fieldCmd = 0
     fieldUs = 1
@@ -1,6 +1,6 @@
 
 
-with open("../TestPipelinePlannerCLRCPP/TestPipelinePlannerCLRCPP/testOut/testOut__00001.txt", "w+") as f:
+with open("testOut__00001.txt", "w+") as f:
 
     b = 0
 
@@ -0,0 +1,115 @@
+// RBotFirmware
+// Rob Dobson 2016-2018
+
+// Host stress test of the handoff between the main loop (producer) and the motion ISR (consumer)
+// The consumer runs as a separate thread so both sides really do run concurrently
+
+#include <stdio.h>
+#include <stdint.h>
+#include <thread>
+#include <atomic>
+#include <chrono>
+
+#define IRAM_ATTR
+#include "MotionRingBuffer.h"
+
+static constexpr int BUF_LEN = 8;
+static constexpr uint32_t ITEMS_TO_PASS = 200000;
+static constexpr int PAYLOAD_LEN = 6;
+
+// Item with a payload which is only consistent if it was completely written before being got
+struct TestItem
+{
+    uint32_t _seq;
+    uint32_t _payload[PAYLOAD_LEN];
+};
+
+static TestItem _items[BUF_LEN];
+static MotionRingBufferPosn _posn(BUF_LEN);
+static std::atomic<bool> _consumerDone(false);
+static uint32_t _consumerErrors = 0;
+static uint32_t _producerErrors = 0;
+
+// Let the other thread run (the test may be run on a single core)
+static void waitForOtherSide()
+{
+    std::this_thread::sleep_for(std::chrono::microseconds(10));
+}
+
+static uint32_t payloadVal(uint32_t seq, int idx)
+{
+    return seq * 2654435761u + idx;
+}
+
+// Consumer - as the ISR does it peeks the item, uses it and then removes it
+static void consumer()
+{
+    uint32_t expectedSeq = 0;
+    while (expectedSeq < ITEMS_TO_PASS)
+    {
+        if (!_posn.canGet())
+        {
+            waitForOtherSide();
+            continue;
+        }
+        TestItem &item = _items[_posn._getPos];
+        if (item._seq != expectedSeq)
+            _consumerErrors++;
+        for (int i = 0; i < PAYLOAD_LEN; i++)
+            if (item._payload[i] != payloadVal(item._seq, i))
+                _consumerErrors++;
+        _posn.hasGot();
+        expectedSeq++;
+    }
+    _consumerDone = true;
+}
+
+// Producer - as the planner does it also looks back through the items while the consumer runs
+static void producer()
+{
+    uint32_t seq = 0;
+    while (seq < ITEMS_TO_PASS)
+    {
+        // Items found from either end must be ones that have been put and not yet got
+        unsigned int count = _posn.count();
+        if (count >= BUF_LEN)
+            _producerErrors++;
+        // Only the consumer moves so once an item isn't found none further back can be
+        bool pastOldest = false;
+        for (unsigned int n = 0; n < BUF_LEN + 2; n++)
+        {
+            int nthPos = _posn.getNthFromPut(n);
+            if (nthPos < 0)
+                pastOldest = true;
+            else if (pastOldest || (_items[nthPos]._seq != seq - 1 - n))
+                _producerErrors++;
+        }
+        int nthPos = _posn.getNthFromGet(BUF_LEN);
+        if (nthPos >= 0)
+            _producerErrors++;
+
+        if (!_posn.canPut())
+        {
+            waitForOtherSide();
+            continue;
+        }
+        TestItem &item = _items[_posn._putPos];
+        item._seq = seq;
+        for (int i = 0; i < PAYLOAD_LEN; i++)
+            item._payload[i] = payloadVal(seq, i);
+        _posn.hasPut();
+        seq++;
+    }
+}
+
+int main()
+{
+    std::thread consumerThread(consumer);
+    producer();
+    consumerThread.join();
+
+    bool passed = _consumerDone && (_consumerErrors == 0) && (_producerErrors == 0) && (_posn.count() == 0);
+    printf("TestMotionHandoff items %u consumerErrors %u producerErrors %u %s\n",
+           ITEMS_TO_PASS, _consumerErrors, _producerErrors, passed ? "PASSED" : "FAILED");
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,209 @@
+// RBotFirmware
+// Rob Dobson 2016-2018
+
+// Host test of the motion task (MotionTask) and the handoff between it and the networking side of
+// the work manager - the motion task is a std::thread servicing a dry run robot and the work manager
+// while the test posts commands, robot config and LED strip settings as the web server does and a
+// second thread polls status, config, stats and debug info as the status reporting does
+// Usage: TestMotionTask
+
+#include <stdio.h>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <ArduinoLog.h>
+#include "RdJson.h"
+#include "HostSim.h"
+#include "ConfigNVS.h"
+#include "LedStrip.h"
+#include "RestAPISystem.h"
+#include "CommandScheduler.h"
+#include "FileManager.h"
+#include "RobotMotion/RobotController.h"
+#include "WorkManager/WorkManager.h"
+#include "WorkManager/MotionTask.h"
+
+// Moves posted (short steps along a line to the last point) and the time allowed for each step of the test
+static constexpr int NUM_MOVES = 500;
+static constexpr float LAST_MOVE_X = 40;
+static constexpr float LAST_MOVE_Y = 49.9f;
+static constexpr int WAIT_TIMEOUT_MS = 20000;
+static constexpr int POLL_MS = 1;
+static constexpr int LED_PIN = 16;
+
+// Robot configs - the config posted differs in maxSpeed
+static const char* ROBOT_CONFIG_FMT = "{\"robotConfig\":{\"robotType\":\"XYBot\",\"robotGeom\":{\"model\":\"Cartesian\","
+            "\"allowOutOfBounds\":1,\"axis0\":{\"maxSpeed\":%d,\"maxAcc\":100,\"stepsPerRot\":3200,\"unitsPerRot\":32},"
+            "\"axis1\":{\"maxSpeed\":%d,\"maxAcc\":100,\"stepsPerRot\":3200,\"unitsPerRot\":32}},"
+            "\"ledStrip\":{\"ledPin\":\"%d\"}}}";
+static const char* LED_STRIP_CONFIG = "{\"ledOn\":1,\"ledValue\":200,\"autoDim\":0}";
+
+static String robotConfigStr(int maxSpeed)
+{
+    char configBuf[600];
+    snprintf(configBuf, sizeof(configBuf), ROBOT_CONFIG_FMT, maxSpeed, maxSpeed, LED_PIN);
+    return configBuf;
+}
+
+static void sleepMs(int ms)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+// Wait for a condition checked from the networking side
+static bool waitFor(const char* what, std::function<bool()> isDone)
+{
+    for (int waitMs = 0; waitMs < WAIT_TIMEOUT_MS; waitMs += POLL_MS)
+    {
+        if (isDone())
+            return true;
+        sleepMs(POLL_MS);
+    }
+    printf("timeout waiting for %s\n", what);
+    return false;
+}
+
+// Post a command as the REST API does - retried while the handoff is full
+static bool postCommand(WorkManager& workManager, const String& cmdStr)
+{
+    for (int waitMs = 0; waitMs < WAIT_TIMEOUT_MS; waitMs += POLL_MS)
+    {
+        WorkItem workItem(cmdStr.c_str());
+        String retStr;
+        workManager.postWorkItem(workItem, retStr);
+        if (retStr.indexOf("\"ok\"") >= 0)
+            return true;
+        sleepMs(POLL_MS);
+    }
+    printf("timeout posting %s\n", cmdStr.c_str());
+    return false;
+}
+
+// Status read from the networking side
+static String queryStatus(WorkManager& workManager)
+{
+    String statusStr;
+    workManager.queryStatus(statusStr);
+    return statusStr;
+}
+
+// Networking side reads (as the status reporting and REST API do) - every read must be one of the
+// values the motion task published
+static std::atomic<bool> _pollStop(false);
+static std::atomic<uint32_t> _pollCount(0);
+static std::atomic<uint32_t> _pollErrors(0);
+static void pollWorkManager(WorkManager* pWorkManager, String configA, String configB)
+{
+    while (!_pollStop)
+    {
+        String statusStr = queryStatus(*pWorkManager);
+        bool statusOk = RdJson::getString("XYZ", "", statusStr.c_str()).startsWith("[") &&
+                    (RdJson::getLong("ledValue", -1, statusStr.c_str()) >= 0);
+        String configStr;
+        pWorkManager->getRobotConfig(configStr);
+        bool configOk = configStr.equals(configA) || configStr.equals(configB);
+        String statsStr;
+        pWorkManager->getMotionStats(statsStr);
+        bool statsOk = RdJson::getString("plan", "", statsStr.c_str()).length() > 0;
+        bool debugOk = pWorkManager->getDebugStr().startsWith(" Q");
+        pWorkManager->checkStatusChanged();
+        if (!(statusOk && configOk && statsOk && debugOk))
+        {
+            if (_pollErrors == 0)
+                printf("bad read status %d config %d stats %d debug %d\n", statusOk, configOk, statsOk, debugOk);
+            _pollErrors++;
+        }
+        _pollCount++;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Log.begin(LOG_LEVEL_WARNING);
+
+    // The motion task sleeps between services so time follows the wall clock
+    HostSim::reset();
+    HostSim::setFollowWallClock(true);
+    String configA = robotConfigStr(100);
+    String configB = robotConfigStr(50);
+    ConfigNVS systemConfig("system", 1000);
+    ConfigNVS robotConfig("robot", 2000);
+    ConfigNVS ledStripConfig("ledStrip", 100);
+    systemConfig.setup();
+    robotConfig.setup();
+    ledStripConfig.setup();
+    robotConfig.setConfigData(configA.c_str());
+    LedStrip ledStrip(ledStripConfig);
+    ledStrip.setup(&robotConfig, "robotConfig/ledStrip");
+    RestAPISystem restAPISystem;
+    FileManager fileManager;
+    CommandScheduler commandScheduler;
+    RobotController robotController(true);
+    WorkManager workManager(systemConfig, robotConfig, robotController, ledStrip, restAPISystem, fileManager,
+                commandScheduler);
+    workManager.reconfigure();
+
+    // Hand over to the motion task
+    MotionTask motionTask(workManager, robotController);
+    motionTask.start();
+    bool testOk = motionTask.isRunning();
+    std::thread pollThread(pollWorkManager, &workManager, configA, configB);
+
+    // Robot config is applied by the motion task and the applied config published
+    testOk &= workManager.setRobotConfig((const uint8_t*)configB.c_str(), configB.length());
+    testOk &= waitFor("robot config", [&]() {
+        String configStr;
+        workManager.getRobotConfig(configStr);
+        return configStr.equals(configB);
+    });
+
+    // LED strip settings likewise
+    testOk &= workManager.setLedStripConfig((const uint8_t*)LED_STRIP_CONFIG, strlen(LED_STRIP_CONFIG));
+    testOk &= waitFor("LED strip config", [&]() {
+        return RdJson::getLong("ledValue", 0, queryStatus(workManager).c_str()) == 200;
+    });
+
+    // Immediate commands handled by the motion task
+    testOk &= postCommand(workManager, "sleep");
+    testOk &= waitFor("sleep", [&]() {
+        return RdJson::getLong("pause", 0, queryStatus(workManager).c_str()) == 1;
+    });
+    testOk &= postCommand(workManager, "resume");
+    testOk &= waitFor("resume", [&]() {
+        return RdJson::getLong("pause", 1, queryStatus(workManager).c_str()) == 0;
+    });
+
+    // Moves - the handoff fills and the posts are retried
+    for (int moveIdx = 1; (moveIdx <= NUM_MOVES) && testOk; moveIdx++)
+    {
+        float x = LAST_MOVE_X * moveIdx / NUM_MOVES;
+        float y = LAST_MOVE_Y * moveIdx / NUM_MOVES;
+        testOk &= postCommand(workManager, "G0 X" + String(x, 3) + " Y" + String(y, 3));
+    }
+    testOk &= waitFor("moves", [&]() {
+        String statusStr = queryStatus(workManager);
+        return (fabs(RdJson::getDouble("XYZ[0]", 0, statusStr.c_str()) - LAST_MOVE_X) < 0.01) &&
+               (fabs(RdJson::getDouble("XYZ[1]", 0, statusStr.c_str()) - LAST_MOVE_Y) < 0.01) &&
+               (RdJson::getLong("Qd", 1, statusStr.c_str()) == 0);
+    });
+
+    // Stop the task - the robot is then serviced from the calling thread again
+    _pollStop = true;
+    pollThread.join();
+    motionTask.stop();
+    testOk &= !motionTask.isRunning();
+    AxisPosition endPos;
+    robotController.getPlannedPosition(endPos);
+    bool endPosOk = (fabsf(endPos._axisPositionMM.getVal(0) - LAST_MOVE_X) < 0.01f) &&
+                (fabsf(endPos._axisPositionMM.getVal(1) - LAST_MOVE_Y) < 0.01f);
+    testOk &= endPosOk && (_pollErrors == 0) && (_pollCount > 0);
+    String configStr;
+    workManager.getRobotConfig(configStr);
+    testOk &= configStr.equals(configB);
+
+    printf("%d moves endPos X%.3f Y%.3f%s polls %u bad %u\n", NUM_MOVES, endPos._axisPositionMM.getVal(0),
+                endPos._axisPositionMM.getVal(1), endPosOk ? "" : " UNEXPECTED", _pollCount.load(), _pollErrors.load());
+    printf("%s\n", testOk ? "PASSED" : "FAILED");
+    return testOk ? 0 : 1;
+}
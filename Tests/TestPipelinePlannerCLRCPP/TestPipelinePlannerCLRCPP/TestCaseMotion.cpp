@@ -1,7 +0,0 @@
-#include "TestCaseMotion.h"
-
-
-
-TestCaseHandler::TestCaseHandler()
-{
-}
@@ -1,7 +0,0 @@
-// RBotFirmware
-// Rob Dobson 2016-2018
-
-#include "application.h"
-#include "TestMotionActuator.h"
-
-uint32_t TestMotionActuator::_testCount = 0;
@@ -1,219 +0,0 @@
-/**
-******************************************************************************
-* @file    spark_wiring_string.h
-* @author  Mohit Bhoite
-* @version V1.0.0
-* @date    13-March-2013
-* @brief   Header for spark_wiring_string.c module
-******************************************************************************
-Copyright (c) 2013-2015 Particle Industries, Inc.  All rights reserved.
-...mostly rewritten by Paul Stoffregen...
-Copyright (c) 2009-10 Hernando Barragan.  All rights reserved.
-Copyright 2011, Paul Stoffregen, paul@pjrc.com
-This library is free software; you can redistribute it and/or
-modify it under the terms of the GNU Lesser General Public
-License as published by the Free Software Foundation, either
-version 3 of the License, or (at your option) any later version.
-This library is distributed in the hope that it will be useful,
-but WITHOUT ANY WARRANTY; without even the implied warranty of
-MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
-Lesser General Public License for more details.
-You should have received a copy of the GNU Lesser General Public
-License along with this library; if not, see <http://www.gnu.org/licenses/>.
-******************************************************************************
-*/
-
-#ifndef String_class_h
-#define String_class_h
-#ifdef __cplusplus
-
-#include <stdarg.h>
-
-// An inherited class for holding the result of a concatenation.  These
-// result objects are assumed to be writable by subsequent concatenations.
-class StringSumHelper;
-
-// The string class
-class WiringString
-{
-	// use a function pointer to allow for "if (s)" without the
-	// complications of an operator bool(). for more information, see:
-	// http://www.artima.com/cppsource/safebool.html
-	typedef void (WiringString::*StringIfHelperType)() const;
-	void StringIfHelper() const {}
-
-public:
-	// constructors
-	// creates a copy of the initial value.
-	// if the initial value is null or invalid, or if memory allocation
-	// fails, the string will be marked as invalid (i.e. "if (s)" will
-	// be false).
-	WiringString(const char *cstr = "");
-	WiringString(const char *cstr, unsigned int length);
-	WiringString(const WiringString &str);
-#ifdef __GXX_EXPERIMENTAL_CXX0X__
-	String(String &&rval);
-	String(StringSumHelper &&rval);
-#endif
-	explicit WiringString(char c);
-	explicit WiringString(unsigned char, unsigned char base = 10);
-	explicit WiringString(int, unsigned char base = 10);
-	explicit WiringString(unsigned int, unsigned char base = 10);
-	explicit WiringString(long, unsigned char base = 10);
-	explicit WiringString(unsigned long, unsigned char base = 10);
-	explicit WiringString(float, int decimalPlaces = 6);
-	explicit WiringString(double, int decimalPlaces = 6);
-	~WiringString(void);
-
-	// memory management
-	// return true on success, false on failure (in which case, the string
-	// is left unchanged).  reserve(0), if successful, will validate an
-	// invalid string (i.e., "if (s)" will be true afterwards)
-	unsigned char reserve(unsigned int size);
-	inline unsigned int length(void) const { return len; }
-
-	// creates a copy of the assigned value.  if the value is null or
-	// invalid, or if the memory allocation fails, the string will be
-	// marked as invalid ("if (s)" will be false).
-	WiringString & operator = (const WiringString &rhs);
-	WiringString & operator = (const char *cstr);
-#ifdef __GXX_EXPERIMENTAL_CXX0X__
-	String & operator = (String &&rval);
-	String & operator = (StringSumHelper &&rval);
-#endif
-
-	operator const char*() const { return c_str(); }
-
-	// concatenate (works w/ built-in types)
-
-	// returns true on success, false on failure (in which case, the string
-	// is left unchanged).  if the argument is null or invalid, the
-	// concatenation is considered unsucessful.
-	unsigned char concat(const WiringString &str);
-	unsigned char concat(const char *cstr);
-	unsigned char concat(char c);
-	unsigned char concat(unsigned char c);
-	unsigned char concat(int num);
-	unsigned char concat(unsigned int num);
-	unsigned char concat(long num);
-	unsigned char concat(unsigned long num);
-	unsigned char concat(float num);
-	unsigned char concat(double num);
-
-	// if there's not enough memory for the concatenated value, the string
-	// will be left unchanged (but this isn't signalled in any way)
-	WiringString & operator += (const WiringString &rhs) { concat(rhs); return (*this); }
-	WiringString & operator += (const char *cstr) { concat(cstr); return (*this); }
-	WiringString & operator += (char c) { concat(c); return (*this); }
-	WiringString & operator += (unsigned char num) { concat(num); return (*this); }
-	WiringString & operator += (int num) { concat(num); return (*this); }
-	WiringString & operator += (unsigned int num) { concat(num); return (*this); }
-	WiringString & operator += (long num) { concat(num); return (*this); }
-	WiringString & operator += (unsigned long num) { concat(num); return (*this); }
-
-	friend StringSumHelper & operator + (const StringSumHelper &lhs, const WiringString &rhs);
-	friend StringSumHelper & operator + (const StringSumHelper &lhs, const char *cstr);
-	friend StringSumHelper & operator + (const StringSumHelper &lhs, char c);
-	friend StringSumHelper & operator + (const StringSumHelper &lhs, unsigned char num);
-	friend StringSumHelper & operator + (const StringSumHelper &lhs, int num);
-	friend StringSumHelper & operator + (const StringSumHelper &lhs, unsigned int num);
-	friend StringSumHelper & operator + (const StringSumHelper &lhs, long num);
-	friend StringSumHelper & operator + (const StringSumHelper &lhs, unsigned long num);
-	friend StringSumHelper & operator + (const StringSumHelper &lhs, float num);
-	friend StringSumHelper & operator + (const StringSumHelper &lhs, double num);
-
-	// comparison (only works w/ Strings and "strings")
-	operator StringIfHelperType() const { return buffer ? &WiringString::StringIfHelper : 0; }
-	int compareTo(const WiringString &s) const;
-	unsigned char equals(const WiringString &s) const;
-	unsigned char equals(const char *cstr) const;
-	unsigned char operator == (const WiringString &rhs) const { return equals(rhs); }
-	unsigned char operator == (const char *cstr) const { return equals(cstr); }
-	unsigned char operator != (const WiringString &rhs) const { return !equals(rhs); }
-	unsigned char operator != (const char *cstr) const { return !equals(cstr); }
-	unsigned char operator <  (const WiringString &rhs) const;
-	unsigned char operator >  (const WiringString &rhs) const;
-	unsigned char operator <= (const WiringString &rhs) const;
-	unsigned char operator >= (const WiringString &rhs) const;
-	unsigned char equalsIgnoreCase(const WiringString &s) const;
-	unsigned char startsWith(const WiringString &prefix) const;
-	unsigned char startsWith(const WiringString &prefix, unsigned int offset) const;
-	unsigned char endsWith(const WiringString &suffix) const;
-
-	// character acccess
-	char charAt(unsigned int index) const;
-	void setCharAt(unsigned int index, char c);
-	char operator [] (unsigned int index) const;
-	char& operator [] (unsigned int index);
-	void getBytes(unsigned char *buf, unsigned int bufsize, unsigned int index = 0) const;
-	void toCharArray(char *buf, unsigned int bufsize, unsigned int index = 0) const
-	{
-		getBytes((unsigned char *)buf, bufsize, index);
-	}
-	const char * c_str() const { return buffer; }
-
-	// search
-	int indexOf(char ch) const;
-	int indexOf(char ch, unsigned int fromIndex) const;
-	int indexOf(const WiringString &str) const;
-	int indexOf(const WiringString &str, unsigned int fromIndex) const;
-	int lastIndexOf(char ch) const;
-	int lastIndexOf(char ch, unsigned int fromIndex) const;
-	int lastIndexOf(const WiringString &str) const;
-	int lastIndexOf(const WiringString &str, unsigned int fromIndex) const;
-	WiringString substring(unsigned int beginIndex) const;
-	WiringString substring(unsigned int beginIndex, unsigned int endIndex) const;
-
-	// modification
-	WiringString& replace(char find, char replace);
-	WiringString& replace(const WiringString& find, const WiringString& replace);
-	WiringString& remove(unsigned int index);
-	WiringString& remove(unsigned int index, unsigned int count);
-	WiringString& toLowerCase(void);
-	WiringString& toUpperCase(void);
-	WiringString& trim(void);
-
-	// parsing/conversion
-	long toInt(void) const;
-	float toFloat(void) const;
-
-	static WiringString format(const char* format, ...);
-
-protected:
-	char *buffer;	        // the actual char array
-	unsigned int capacity;  // the array length minus one (for the '\0')
-	unsigned int len;       // the String length (not counting the '\0')
-	unsigned char flags;    // unused, for future features
-protected:
-	void init(void);
-	void invalidate(void);
-	unsigned char changeBuffer(unsigned int maxStrLen);
-	unsigned char concat(const char *cstr, unsigned int length);
-
-	// copy and move
-	WiringString & copy(const char *cstr, unsigned int length);
-
-#ifdef __GXX_EXPERIMENTAL_CXX0X__
-	void move(String &rhs);
-#endif
-
-	friend class StringPrintableHelper;
-
-};
-
-
-class StringSumHelper : public WiringString
-{
-public:
-	StringSumHelper(const WiringString &s) : WiringString(s) {}
-	StringSumHelper(const char *p) : WiringString(p) {}
-	StringSumHelper(char c) : WiringString(c) {}
-	StringSumHelper(unsigned char num) : WiringString(num) {}
-	StringSumHelper(int num) : WiringString(num) {}
-	StringSumHelper(unsigned int num) : WiringString(num) {}
-	StringSumHelper(long num) : WiringString(num) {}
-	StringSumHelper(unsigned long num) : WiringString(num) {}
-};
-
-#endif  // __cplusplus
-#endif  // String_class_h
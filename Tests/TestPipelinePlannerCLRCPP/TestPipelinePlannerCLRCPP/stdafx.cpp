@@ -1,7 +0,0 @@
-// stdafx.cpp : source file that includes just the standard includes
-// TestPipelinePlannerCLRCPP.pch will be the pre-compiled header
-// stdafx.obj will contain the pre-compiled type information
-
-#include "stdafx.h"
-
-
@@ -0,0 +1,128 @@
+// RBotFirmware
+// Rob Dobson 2016-2018
+
+// Host benchmark of the cost of replanning the motion pipeline (MotionPlanner::recalculatePipeline)
+// as each block is added with the pipeline kept full - at several pipeline lengths for a path of
+// short segments on a cartesian robot. The blocks visited and time per recalc are the planner's own
+// "plan" stats (as in /motionstats) and the planning must be amortised O(1) - the blocks visited
+// mustn't grow with the pipeline length once that is longer than the deceleration ramp
+// Usage: TestPlannerCost
+
+#include <stdio.h>
+#include <math.h>
+#include <ArduinoLog.h>
+#include "RdJson.h"
+#include "HostSim.h"
+#include "RobotCommandArgs.h"
+#include "RobotMotion/RobotController.h"
+
+// Segments fed to the planner (and how many are fed before the stats are reset)
+static constexpr int NUM_SEGMENTS = 20000;
+static constexpr int WARMUP_SEGMENTS = 1000;
+static constexpr float SEGMENT_MM = 0.1f;
+// Pipeline lengths compared
+static constexpr int PIPELINE_LENS[] = { 100, 300, 500 };
+static constexpr int NUM_PIPELINE_LENS = sizeof(PIPELINE_LENS) / sizeof(PIPELINE_LENS[0]);
+// Max growth in blocks visited from the shortest to the longest pipeline for planning to count as O(1)
+static constexpr float MAX_VISIT_GROWTH = 1.25f;
+
+// Path of the test - points SEGMENT_MM apart
+enum PathType { PATH_SPIRAL, PATH_ZIGZAG };
+
+struct CostTestCase
+{
+    const char* _name;
+    PathType _pathType;
+    float _maxAcc;
+    // False where the whole pipeline is one deceleration ramp - every block's speed then rises
+    // with each block added so the cost is O(pipeline length) for any forward/backward planner
+    bool _checkConstant;
+};
+
+static const CostTestCase _testCases[] = {
+    { "spiral", PATH_SPIRAL, 1000, true },
+    { "zigzag", PATH_ZIGZAG, 1000, true },
+    { "spiralSlowAcc", PATH_SPIRAL, 10, false },
+};
+
+// Spiral out from the centre with SEGMENT_MM between points or a zig-zag in X with a sharp corner every 20mm
+static void pathPoint(PathType pathType, int segIdx, float& x, float& y)
+{
+    if (pathType == PATH_SPIRAL)
+    {
+        // r = k * theta with arc length approximately k * theta^2 / 2
+        const float k = 1.0f;
+        float theta = sqrtf(2 * segIdx * SEGMENT_MM / k);
+        x = k * theta * cosf(theta);
+        y = k * theta * sinf(theta);
+        return;
+    }
+    const int segsPerLeg = 200;
+    int leg = segIdx / segsPerLeg;
+    float legPos = (segIdx % segsPerLeg) * SEGMENT_MM;
+    x = (leg % 2) ? 20 - legPos : legPos;
+    y = leg * 2.0f;
+}
+
+// Feed the path to a dry run robot and return the planner stats
+static void runCostTest(const CostTestCase& testCase, int pipelineLen, float& visitAvg, int& visitMax, float& usAvg)
+{
+    String axisStr = "{\"maxSpeed\":100,\"maxAcc\":" + String(testCase._maxAcc, 0) +
+                ",\"stepsPerRot\":3200,\"unitsPerRot\":32}";
+    String robotConfigStr = "{\"robotType\":\"XYBot\",\"robotGeom\":{\"model\":\"Cartesian\",\"allowOutOfBounds\":1,"
+                "\"pipelineLen\":" + String(pipelineLen) + ",\"axis0\":" + axisStr + ",\"axis1\":" + axisStr + "}}";
+
+    // Recalc times are from the wall clock
+    HostSim::reset();
+    HostSim::setFollowWallClock(true);
+    RobotController* pRobotController = new RobotController(true);
+    pRobotController->init(robotConfigStr.c_str());
+    for (int segIdx = 1; segIdx <= NUM_SEGMENTS; segIdx++)
+    {
+        while (!pRobotController->canAcceptCommand())
+            pRobotController->service();
+        if (segIdx == WARMUP_SEGMENTS)
+            pRobotController->resetMotionStats();
+        float x = 0, y = 0;
+        pathPoint(testCase._pathType, segIdx, x, y);
+        RobotCommandArgs args;
+        args.setAxisValMM(0, x, true);
+        args.setAxisValMM(1, y, true);
+        args.setMoreMovesComing(true);
+        pRobotController->moveTo(args);
+    }
+    String statsStr;
+    pRobotController->getMotionStats(statsStr);
+    visitAvg = float(RdJson::getDouble("plan/visitAvg", 0, statsStr.c_str()));
+    visitMax = int(RdJson::getLong("plan/visitMax", 0, statsStr.c_str()));
+    usAvg = float(RdJson::getDouble("plan/usAvg", 0, statsStr.c_str()));
+    delete pRobotController;
+    HostSim::setFollowWallClock(false);
+}
+
+int main(int argc, char** argv)
+{
+    Log.begin(LOG_LEVEL_WARNING);
+    printf("%d segments of %.1fmm, stats from segment %d\n", NUM_SEGMENTS, SEGMENT_MM, WARMUP_SEGMENTS);
+    bool allOk = true;
+    for (const CostTestCase& testCase : _testCases)
+    {
+        float visitAvgs[NUM_PIPELINE_LENS];
+        for (int lenIdx = 0; lenIdx < NUM_PIPELINE_LENS; lenIdx++)
+        {
+            int visitMax = 0;
+            float usAvg = 0;
+            runCostTest(testCase, PIPELINE_LENS[lenIdx], visitAvgs[lenIdx], visitMax, usAvg);
+            printf("%-14s maxAcc %4.0f pipelineLen %d visitAvg %.2f visitMax %d usAvg %.2f\n", testCase._name,
+                        testCase._maxAcc, PIPELINE_LENS[lenIdx], visitAvgs[lenIdx], visitMax, usAvg);
+        }
+        if (!testCase._checkConstant)
+            continue;
+        bool isConstant = visitAvgs[NUM_PIPELINE_LENS - 1] <= visitAvgs[0] * MAX_VISIT_GROWTH;
+        printf("%-14s blocks visited pipelineLen %d vs %d x%.2f %s\n", testCase._name, PIPELINE_LENS[NUM_PIPELINE_LENS - 1],
+                    PIPELINE_LENS[0], visitAvgs[NUM_PIPELINE_LENS - 1] / visitAvgs[0], isConstant ? "ok" : "FAIL");
+        allOk &= isConstant;
+    }
+    printf("%s\n", allOk ? "PASSED" : "FAILED");
+    return allOk ? 0 : 1;
+}
@@ -0,0 +1,473 @@
+// RBotFirmware
+// Rob Dobson 2016-2018
+
+// Host check of the SandTableScara kinematics against a double precision reference over the whole
+// workspace (and of the batch functions against ptToActuator) together with a benchmark of the
+// per-point cost of each
+// Usage: TestScaraKinematics [<robotType>]
+
+#include <stdio.h>
+#include <math.h>
+#include <chrono>
+#include <vector>
+#include <ArduinoLog.h>
+#include "RdJson.h"
+#include "RobotConfigurations.h"
+#include "AxisValues.h"
+#include "FastTrig.h"
+#include "AxisPosition.h"
+#include "AxesParams.h"
+#include "Robots/RobotSandTableScara.h"
+
+// Workspace grid spacing and band near the edge where acos is ill-conditioned
+static constexpr double GRID_MM = 0.25;
+static constexpr double EDGE_BAND_MM = 0.5;
+// Bounds on the error of the solution angles (as a fraction of a microstep)
+static constexpr double MAX_ERR_MICROSTEPS = 0.1;
+static constexpr double MAX_EDGE_ERR_MICROSTEPS = 1.0;
+// Benchmark repeats
+static constexpr int BENCH_REPEATS = 5;
+
+// Double precision reference - the implementation as it was before single precision
+namespace ScaraDouble
+{
+static double wrapRadians(double angle)
+{
+    return angle - 2 * M_PI * floor(angle / (2 * M_PI));
+}
+
+static double wrapDegrees(double angle)
+{
+    return angle - 360.0 * floor(angle / 360.0);
+}
+
+static double cosineRule(double a, double b, double c)
+{
+    double val = (a*a + b*b - c*c) / (2 * a * b);
+    if (val > 1) val = 1;
+    if (val < -1) val = -1;
+    return acos(val);
+}
+
+static bool cartesianToPolar(double x, double y, double l1, double l2, double soln1[2], double soln2[2])
+{
+    double thirdSideL3MM = sqrt(pow(x, 2) + pow(y, 2));
+    bool posValid = thirdSideL3MM <= l1 + l2;
+    double delta1 = atan2(x, y);
+    if (delta1 < 0)
+        delta1 += M_PI * 2;
+    double delta2 = cosineRule(thirdSideL3MM, l1, l2);
+    double innerAngleOppThirdGamma = cosineRule(l1, l2, thirdSideL3MM);
+    double alpha1rads = delta1 - delta2;
+    double beta1rads = alpha1rads - innerAngleOppThirdGamma + M_PI;
+    double alpha2rads = delta1 + delta2;
+    double beta2rads = alpha2rads + innerAngleOppThirdGamma - M_PI;
+    soln1[0] = wrapRadians(alpha1rads + 2 * M_PI) * 180.0 / M_PI;
+    soln1[1] = wrapRadians(beta1rads + 2 * M_PI) * 180.0 / M_PI;
+    soln2[0] = wrapRadians(alpha2rads + 2 * M_PI) * 180.0 / M_PI;
+    soln2[1] = wrapRadians(beta2rads + 2 * M_PI) * 180.0 / M_PI;
+    return posValid;
+}
+
+static double calcRelativePolar(double targetRotation, double curRotation)
+{
+    double diffAngle = targetRotation - curRotation;
+    if (diffAngle <= -180)
+        return 360 + diffAngle;
+    if (diffAngle > 180)
+        return diffAngle - 360;
+    return diffAngle;
+}
+
+static void ptToActuator(double x, double y, const int32_t curSteps[2], double l1, double l2,
+                    const double stepsPerRot[2], int32_t outSteps[2])
+{
+    double curPolar[2] = { wrapDegrees(curSteps[0] * 360 / stepsPerRot[0]),
+                           wrapDegrees(540 - (curSteps[1] * 360 / stepsPerRot[1])) };
+    double rel[2];
+    if ((fabs(x) < 1) && (fabs(y) < 1))
+    {
+        rel[0] = 0;
+        rel[1] = calcRelativePolar(curPolar[0] + 180, curPolar[1]);
+    }
+    else
+    {
+        double soln1[2], soln2[2];
+        cartesianToPolar(x, y, l1, l2, soln1, soln2);
+        double a1Rel = calcRelativePolar(soln1[0], curPolar[0]);
+        double b1Rel = calcRelativePolar(soln1[1], curPolar[1]);
+        double a2Rel = calcRelativePolar(soln2[0], curPolar[0]);
+        double b2Rel = calcRelativePolar(soln2[1], curPolar[1]);
+        bool useFirst = fabs(a1Rel) + fabs(b1Rel) <= fabs(a2Rel) + fabs(b2Rel);
+        rel[0] = useFirst ? a1Rel : a2Rel;
+        rel[1] = useFirst ? b1Rel : b2Rel;
+    }
+    outSteps[0] = curSteps[0] + int32_t(round(rel[0] * stepsPerRot[0] / 360));
+    outSteps[1] = curSteps[1] + int32_t(round(-rel[1] * stepsPerRot[1] / 360));
+}
+
+// Distance of the end effector at a position in steps from a point
+static double distFromPt(const int32_t steps[2], double x, double y, double l1, double l2, const double stepsPerRot[2])
+{
+    double alpha = (steps[0] * 360 / stepsPerRot[0]) * M_PI / 180;
+    double beta = (540 - steps[1] * 360 / stepsPerRot[1]) * M_PI / 180;
+    double endX = l1 * sin(alpha) + l2 * sin(beta);
+    double endY = l1 * cos(alpha) + l2 * cos(beta);
+    return sqrt((endX - x) * (endX - x) + (endY - y) * (endY - y));
+}
+}; // namespace ScaraDouble
+
+// Difference of two angles in degrees wrapped to +/-180
+static double angleDiff(double a, double b)
+{
+    double diff = fmod(a - b, 360.0);
+    if (diff > 180)
+        diff -= 360;
+    if (diff < -180)
+        diff += 360;
+    return fabs(diff);
+}
+
+// Robot and the points in its workspace
+struct ScaraWorkspace
+{
+    AxesParams _axesParams;
+    float _l1, _l2;
+    double _stepsPerRot[2];
+    double _degreesPerMicrostep;
+    std::vector<float> _ptsX, _ptsY;
+    std::vector<float> _ptsAngle, _ptsRadius;
+};
+
+// Check the kinematics against the double reference (with the trig selected in the axes params)
+static bool checkKinematics(ScaraWorkspace& ws)
+{
+    AxesParams& axesParams = ws._axesParams;
+    double radius = ws._l1 + ws._l2;
+
+    // Accuracy of the solution angles
+    double maxErrDegrees = 0, maxEdgeErrDegrees = 0;
+    for (unsigned int i = 0; i < ws._ptsX.size(); i++)
+    {
+        AxisFloats pt(ws._ptsX[i], ws._ptsY[i]);
+        AxisFloats soln1, soln2;
+        RobotSandTableScara::cartesianToPolar(pt, soln1, soln2, axesParams);
+        double refSoln1[2], refSoln2[2];
+        ScaraDouble::cartesianToPolar(ws._ptsX[i], ws._ptsY[i], ws._l1, ws._l2, refSoln1, refSoln2);
+        double err = 0;
+        for (int j = 0; j < 2; j++)
+        {
+            err = fmax(err, angleDiff(soln1.getVal(j), refSoln1[j]));
+            err = fmax(err, angleDiff(soln2.getVal(j), refSoln2[j]));
+        }
+        double r = sqrt(double(ws._ptsX[i]) * ws._ptsX[i] + double(ws._ptsY[i]) * ws._ptsY[i]);
+        if ((r < EDGE_BAND_MM) || (r > radius - EDGE_BAND_MM))
+            maxEdgeErrDegrees = fmax(maxEdgeErrDegrees, err);
+        else
+            maxErrDegrees = fmax(maxErrDegrees, err);
+    }
+
+    // Steps from a set of current positions - compared by where they put the end effector and by the total
+    // rotation as the two solutions can cost the same rotation (the choice between them is then arbitrary)
+    // and steps may differ by one where an angle is on a rounding boundary
+    static const int32_t curPositions[][2] = { {0, 0}, {2400, 7200}, {4800, 1234}, {9599, 4800} };
+    double microstepMM = radius * ws._degreesPerMicrostep * M_PI / 180;
+    uint32_t pointsCompared = 0, pointsDiffering = 0, pointsOtherSolution = 0;
+    double maxPosnErrMM = 0;
+    int32_t maxRotationDiff = 0;
+    for (auto& curPosSteps : curPositions)
+    {
+        AxisPosition curPos;
+        curPos._stepsFromHome.set(curPosSteps[0], curPosSteps[1], 0);
+        for (unsigned int i = 0; i < ws._ptsX.size(); i++)
+        {
+            AxisFloats pt(ws._ptsX[i], ws._ptsY[i]);
+            AxisFloats outActuator;
+            RobotSandTableScara::ptToActuator(pt, outActuator, curPos, axesParams, true);
+            int32_t outSteps[2] = { int32_t(roundf(outActuator.getVal(0))), int32_t(roundf(outActuator.getVal(1))) };
+            int32_t refSteps[2];
+            ScaraDouble::ptToActuator(ws._ptsX[i], ws._ptsY[i], curPosSteps, ws._l1, ws._l2, ws._stepsPerRot, refSteps);
+            pointsCompared++;
+            if ((outSteps[0] == refSteps[0]) && (outSteps[1] == refSteps[1]))
+                continue;
+            pointsDiffering++;
+            double posnErrMM = fabs(ScaraDouble::distFromPt(outSteps, ws._ptsX[i], ws._ptsY[i], ws._l1, ws._l2, ws._stepsPerRot) -
+                                    ScaraDouble::distFromPt(refSteps, ws._ptsX[i], ws._ptsY[i], ws._l1, ws._l2, ws._stepsPerRot));
+            maxPosnErrMM = fmax(maxPosnErrMM, posnErrMM);
+            int32_t rotationDiff = abs((abs(outSteps[0] - curPosSteps[0]) + abs(outSteps[1] - curPosSteps[1])) -
+                                       (abs(refSteps[0] - curPosSteps[0]) + abs(refSteps[1] - curPosSteps[1])));
+            if ((abs(outSteps[0] - refSteps[0]) > 1) || (abs(outSteps[1] - refSteps[1]) > 1))
+                pointsOtherSolution++;
+            if (rotationDiff > maxRotationDiff)
+                maxRotationDiff = rotationDiff;
+        }
+    }
+
+    // Results
+    bool passed = (maxErrDegrees <= MAX_ERR_MICROSTEPS * ws._degreesPerMicrostep) &&
+                  (maxEdgeErrDegrees <= MAX_EDGE_ERR_MICROSTEPS * ws._degreesPerMicrostep) &&
+                  (maxPosnErrMM <= microstepMM) && (maxRotationDiff <= 2);
+    printf("%s trig\n", axesParams.isFastKinematics() ? "Fast" : "Maths library");
+    printf("  angle error max %.6fdeg (%.4f microsteps) within %.1fmm of centre/edge %.6fdeg (%.4f microsteps)\n",
+           maxErrDegrees, maxErrDegrees / ws._degreesPerMicrostep, EDGE_BAND_MM,
+           maxEdgeErrDegrees, maxEdgeErrDegrees / ws._degreesPerMicrostep);
+    printf("  points compared %u differing by a step %u (%.4f%%) other solution of equal rotation %u (%.4f%%)\n",
+           pointsCompared, pointsDiffering - pointsOtherSolution, 100.0 * (pointsDiffering - pointsOtherSolution) / pointsCompared,
+           pointsOtherSolution, 100.0 * pointsOtherSolution / pointsCompared);
+    printf("  max end position diff %.4fmm (microstep %.4fmm) max rotation diff %d steps %s\n",
+           maxPosnErrMM, microstepMM, maxRotationDiff, passed ? "ok" : "FAIL");
+    return passed;
+}
+
+// Check the trig approximations against the maths library (double) over their whole domain
+static bool checkFastTrig()
+{
+    static constexpr int SWEEP_POINTS = 2000000;
+    double maxAtan2Err = 0, maxAcosErr = 0;
+    for (int i = 0; i <= SWEEP_POINTS; i++)
+    {
+        double angle = 2 * M_PI * i / SWEEP_POINTS - M_PI;
+        float y = float(sin(angle) * 100), x = float(cos(angle) * 100);
+        maxAtan2Err = fmax(maxAtan2Err, fabs(FastTrig::atan2(y, x) - atan2(double(y), double(x))));
+        float val = float(2.0 * i / SWEEP_POINTS - 1);
+        maxAcosErr = fmax(maxAcosErr, fabs(FastTrig::acos(val) - acos(double(val))));
+    }
+    bool passed = (maxAtan2Err <= FastTrig::MAX_ERR_RADS) && (maxAcosErr <= FastTrig::MAX_ERR_RADS);
+    printf("FastTrig atan2 max error %.3grad acos max error %.3grad (bound %.3grad) %s\n",
+           maxAtan2Err, maxAcosErr, FastTrig::MAX_ERR_RADS, passed ? "ok" : "FAIL");
+    return passed;
+}
+
+// Check the batch functions give exactly the same steps as ptToActuator
+static bool checkBatch(ScaraWorkspace& ws)
+{
+    AxisPosition curPos;
+    curPos._stepsFromHome.set(4800, 1234, 0);
+    KinematicsBatch batch;
+    uint32_t pointsDiffering = 0;
+    for (unsigned int batchStart = 0; batchStart < ws._ptsX.size(); batchStart += KinematicsBatch::MAX_PTS)
+    {
+        batch.clear();
+        for (unsigned int i = batchStart; (i < ws._ptsX.size()) && batch.addPt(ws._ptsX[i], ws._ptsY[i]); i++)
+            ;
+        RobotSandTableScara::ptsToActuatorBatch(batch, ws._axesParams);
+        for (int ptIdx = 0; ptIdx < batch._numPts; ptIdx++)
+        {
+            AxisFloats pt(batch._ptX[ptIdx], batch._ptY[ptIdx]);
+            AxisFloats outActuator, batchActuator;
+            bool isOk = RobotSandTableScara::ptToActuator(pt, outActuator, curPos, ws._axesParams, false);
+            bool batchOk = RobotSandTableScara::ptToActuatorFromBatch(batch, batch.find(pt), pt, batchActuator,
+                                curPos, ws._axesParams, false);
+            if ((isOk != batchOk) || (isOk && (outActuator != batchActuator)))
+                pointsDiffering++;
+        }
+    }
+    printf("  batch points differing from ptToActuator %u %s\n", pointsDiffering, pointsDiffering == 0 ? "ok" : "FAIL");
+    return pointsDiffering == 0;
+}
+
+// Check the arm angles from polar coords (theta-rho moves) against the double reference
+static bool checkPolar(ScaraWorkspace& ws)
+{
+    double radius = ws._l1 + ws._l2;
+    double maxErrDegrees = 0, maxEdgeErrDegrees = 0;
+    for (unsigned int i = 0; i < ws._ptsX.size(); i++)
+    {
+        double r = sqrt(double(ws._ptsX[i]) * ws._ptsX[i] + double(ws._ptsY[i]) * ws._ptsY[i]);
+        if (r < 1)
+            continue;
+        float soln1[2], soln2[2];
+        RobotSandTableScara::polarToArmAngles(float(atan2(double(ws._ptsX[i]), double(ws._ptsY[i]))), float(r),
+                    ws._l1, ws._l2, ws._axesParams.isFastKinematics(), soln1[0], soln1[1], soln2[0], soln2[1]);
+        double refSoln1[2], refSoln2[2];
+        ScaraDouble::cartesianToPolar(ws._ptsX[i], ws._ptsY[i], ws._l1, ws._l2, refSoln1, refSoln2);
+        double err = 0;
+        for (int j = 0; j < 2; j++)
+        {
+            err = fmax(err, angleDiff(soln1[j], refSoln1[j]));
+            err = fmax(err, angleDiff(soln2[j], refSoln2[j]));
+        }
+        if (r > radius - EDGE_BAND_MM)
+            maxEdgeErrDegrees = fmax(maxEdgeErrDegrees, err);
+        else
+            maxErrDegrees = fmax(maxErrDegrees, err);
+    }
+    bool passed = (maxErrDegrees <= MAX_ERR_MICROSTEPS * ws._degreesPerMicrostep) &&
+                  (maxEdgeErrDegrees <= MAX_EDGE_ERR_MICROSTEPS * ws._degreesPerMicrostep);
+    printf("  polar coords angle error max %.6fdeg (%.4f microsteps) within %.1fmm of edge %.6fdeg (%.4f microsteps) %s\n",
+           maxErrDegrees, maxErrDegrees / ws._degreesPerMicrostep, EDGE_BAND_MM,
+           maxEdgeErrDegrees, maxEdgeErrDegrees / ws._degreesPerMicrostep, passed ? "ok" : "FAIL");
+    return passed;
+}
+
+// Check actuatorToPt (forward kinematics) against the double reference for the steps of each point from
+// ptToActuator - and that correctStepOverflow brings the same steps many rotations away (as the steps
+// executed can be) to the same position
+static bool checkForward(ScaraWorkspace& ws)
+{
+    AxisPosition curPos;
+    curPos._stepsFromHome.set(4800, 1234, 0);
+    double microstepMM = (ws._l1 + ws._l2) * ws._degreesPerMicrostep * M_PI / 180;
+    double maxErrMM = 0, maxPtDistMM = 0;
+    uint32_t rotationsDiffering = 0;
+    for (unsigned int i = 0; i < ws._ptsX.size(); i++)
+    {
+        AxisFloats pt(ws._ptsX[i], ws._ptsY[i]);
+        AxisFloats outActuator;
+        RobotSandTableScara::ptToActuator(pt, outActuator, curPos, ws._axesParams, true);
+        AxisFloats fwdPt;
+        RobotSandTableScara::actuatorToPt(outActuator, fwdPt, curPos, ws._axesParams);
+        int32_t steps[2] = { int32_t(roundf(outActuator.getVal(0))), int32_t(roundf(outActuator.getVal(1))) };
+        maxErrMM = fmax(maxErrMM, ScaraDouble::distFromPt(steps, fwdPt.getVal(0), fwdPt.getVal(1), ws._l1, ws._l2, ws._stepsPerRot));
+        // Points within 1mm of the centre in X and Y are all moved to the centre
+        if ((fabsf(ws._ptsX[i]) > 1) || (fabsf(ws._ptsY[i]) > 1))
+            maxPtDistMM = fmax(maxPtDistMM, ScaraDouble::distFromPt(steps, ws._ptsX[i], ws._ptsY[i], ws._l1, ws._l2, ws._stepsPerRot));
+
+        // Many rotations away in either direction must give the same position within a rotation
+        AxisPosition stepsPos, rotatedPos;
+        int32_t rotations = (i % 2) ? 100001 : -100001;
+        stepsPos._stepsFromHome.set(steps[0], steps[1], 0);
+        rotatedPos._stepsFromHome.set(steps[0] + rotations * int32_t(ws._stepsPerRot[0]),
+                    steps[1] - rotations * int32_t(ws._stepsPerRot[1]), 0);
+        RobotSandTableScara::correctStepOverflow(stepsPos, ws._axesParams);
+        RobotSandTableScara::correctStepOverflow(rotatedPos, ws._axesParams);
+        if (rotatedPos._stepsFromHome != stepsPos._stepsFromHome)
+            rotationsDiffering++;
+    }
+    bool passed = (maxErrMM <= MAX_ERR_MICROSTEPS * microstepMM) && (maxPtDistMM <= microstepMM) && (rotationsDiffering == 0);
+    printf("actuatorToPt error max %.4fmm (%.4f microsteps) furthest from the point converted %.4fmm"
+           " differing after whole rotations %u %s\n",
+           maxErrMM, maxErrMM / microstepMM, maxPtDistMM, rotationsDiffering, passed ? "ok" : "FAIL");
+    return passed;
+}
+
+// Time per point of ptToActuator (best of several runs)
+static double benchKinematics(ScaraWorkspace& ws, bool useReference, int32_t& checksum)
+{
+    AxisPosition benchPos;
+    benchPos._stepsFromHome.set(2400, 7200, 0);
+    double bestNs = 1e9;
+    for (int rep = 0; rep < BENCH_REPEATS; rep++)
+    {
+        auto startTime = std::chrono::steady_clock::now();
+        for (unsigned int i = 0; i < ws._ptsX.size(); i++)
+        {
+            if (useReference)
+            {
+                int32_t refSteps[2];
+                ScaraDouble::ptToActuator(ws._ptsX[i], ws._ptsY[i], benchPos._stepsFromHome.vals,
+                                ws._l1, ws._l2, ws._stepsPerRot, refSteps);
+                checksum += refSteps[0];
+            }
+            else
+            {
+                AxisFloats pt(ws._ptsX[i], ws._ptsY[i]);
+                AxisFloats outActuator;
+                RobotSandTableScara::ptToActuator(pt, outActuator, benchPos, ws._axesParams, true);
+                checksum += int32_t(outActuator.getVal(0));
+            }
+        }
+        auto endTime = std::chrono::steady_clock::now();
+        bestNs = fmin(bestNs, std::chrono::duration<double, std::nano>(endTime - startTime).count() / ws._ptsX.size());
+    }
+    return bestNs;
+}
+
+// Time per point of the batch functions (best of several runs) - with polar coords (as for
+// theta-rho moves) or just X and Y
+static double benchBatch(ScaraWorkspace& ws, bool usePolar, int32_t& checksum)
+{
+    AxisPosition benchPos;
+    benchPos._stepsFromHome.set(2400, 7200, 0);
+    KinematicsBatch batch;
+    unsigned int numPts = ws._ptsX.size() - ws._ptsX.size() % KinematicsBatch::MAX_PTS;
+    double bestNs = 1e9;
+    for (int rep = 0; rep < BENCH_REPEATS; rep++)
+    {
+        auto startTime = std::chrono::steady_clock::now();
+        for (unsigned int batchStart = 0; batchStart < numPts; batchStart += KinematicsBatch::MAX_PTS)
+        {
+            batch.clear();
+            for (int i = 0; i < KinematicsBatch::MAX_PTS; i++)
+            {
+                if (usePolar)
+                    batch.addPt(ws._ptsX[batchStart + i], ws._ptsY[batchStart + i],
+                                ws._ptsAngle[batchStart + i], ws._ptsRadius[batchStart + i]);
+                else
+                    batch.addPt(ws._ptsX[batchStart + i], ws._ptsY[batchStart + i]);
+            }
+            RobotSandTableScara::ptsToActuatorBatch(batch, ws._axesParams);
+            for (int ptIdx = 0; ptIdx < KinematicsBatch::MAX_PTS; ptIdx++)
+            {
+                AxisFloats pt(batch._ptX[ptIdx], batch._ptY[ptIdx]);
+                AxisFloats outActuator;
+                RobotSandTableScara::ptToActuatorFromBatch(batch, batch.find(pt), pt, outActuator, benchPos, ws._axesParams, true);
+                checksum += int32_t(outActuator.getVal(0));
+            }
+        }
+        auto endTime = std::chrono::steady_clock::now();
+        bestNs = fmin(bestNs, std::chrono::duration<double, std::nano>(endTime - startTime).count() / numPts);
+    }
+    return bestNs;
+}
+
+int main(int argc, char** argv)
+{
+    Log.begin(LOG_LEVEL_WARNING);
+    String robotType = argc > 1 ? argv[1] : "SandTableScaraPiHat2";
+    String robotConfigStr = RobotConfigurations::getConfig(robotType.c_str());
+    String robotGeom = RdJson::getString("robotGeom", "{}", robotConfigStr.c_str());
+    static ScaraWorkspace ws;
+    String axisJSON;
+    for (int axisIdx = 0; axisIdx < RobotSandTableScara::NUM_ROBOT_AXES; axisIdx++)
+        ws._axesParams.configureAxis(robotGeom.c_str(), axisIdx, axisJSON);
+    if (!ws._axesParams.getMaxVal(0, ws._l1) || !ws._axesParams.getMaxVal(1, ws._l2))
+    {
+        fprintf(stderr, "Robot type %s has no arm lengths (axis maxVal)\n", robotType.c_str());
+        return 2;
+    }
+    ws._stepsPerRot[0] = ws._axesParams.getStepsPerRot(0);
+    ws._stepsPerRot[1] = ws._axesParams.getStepsPerRot(1);
+    ws._degreesPerMicrostep = 360.0 / fmax(ws._stepsPerRot[0], ws._stepsPerRot[1]);
+
+    // Workspace points
+    double radius = ws._l1 + ws._l2;
+    for (double y = -radius; y <= radius; y += GRID_MM)
+        for (double x = -radius; x <= radius; x += GRID_MM)
+            if (sqrt(x*x + y*y) <= radius)
+            {
+                ws._ptsX.push_back(x);
+                ws._ptsY.push_back(y);
+                ws._ptsAngle.push_back(atan2(x, y));
+                ws._ptsRadius.push_back(sqrt(x*x + y*y));
+            }
+    printf("TestScaraKinematics %s arms %.1fmm %.1fmm points %u microstep %.4fdeg\n",
+           robotType.c_str(), ws._l1, ws._l2, (unsigned)ws._ptsX.size(), ws._degreesPerMicrostep);
+
+    // Accuracy with each kind of trig
+    bool passed = checkFastTrig();
+    ws._axesParams.setFastKinematics(false);
+    passed &= checkKinematics(ws);
+    passed &= checkBatch(ws);
+    passed &= checkPolar(ws);
+    ws._axesParams.setFastKinematics(true);
+    passed &= checkKinematics(ws);
+    passed &= checkBatch(ws);
+    passed &= checkPolar(ws);
+    passed &= checkForward(ws);
+
+    // Cost
+    int32_t checksum = 0;
+    double doubleNs = benchKinematics(ws, true, checksum);
+    ws._axesParams.setFastKinematics(false);
+    double floatNs = benchKinematics(ws, false, checksum);
+    ws._axesParams.setFastKinematics(true);
+    double fastNs = benchKinematics(ws, false, checksum);
+    double fastBatchNs = benchBatch(ws, false, checksum);
+    double fastPolarNs = benchBatch(ws, true, checksum);
+    printf("ptToActuator per point double %.1fns float %.1fns float with fast trig %.1fns batched %.1fns"
+           " batched from polar coords %.1fns (checksum %d)\n",
+           doubleNs, floatNs, fastNs, fastBatchNs, fastPolarNs, checksum);
+    printf("%s\n", passed ? "PASSED" : "FAILED");
+    return passed ? 0 : 1;
+}